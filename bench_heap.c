@@ -0,0 +1,334 @@
+// For clock_gettime().
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+
+#include <heap.h>
+#include <radix_heap.h>
+
+/**
+ * @brief Benchmark of the indexed 4-ary heap (heap) against the radix
+ * heap (radix_heap) as the priority queue of Dijkstra's algorithm.
+ *
+ * The graph is read from a map file in the is_connected format. The
+ * maps have no distances, so every edge gets a weight between 1 and
+ * MAX_WEIGHT derived from its labels. Without a map file a random graph
+ * is generated instead. Both heaps run shortest path searches from the
+ * same sources and the distances are checked to be equal.
+ *
+ * Usage: ./bench_heap [map file]
+ */
+
+#define MAXNODENAME 40
+#define BUFSIZE 400
+#define MAX_WEIGHT 100
+#define SOURCES 20
+
+#define RANDOM_NODES 200000
+#define RANDOM_EDGES 1000000
+
+#define UNREACHED UINT32_MAX
+
+// Graph in compressed sparse row form: the edges from node i are
+// first[i] ... first[i+1]-1.
+typedef struct csr_graph {
+    int nodes;
+    int *first;
+    int *target;
+    uint32_t *weight;
+} csr_graph;
+
+typedef struct edge {
+    int src;
+    int dest;
+    uint32_t weight;
+} edge;
+
+void error(const char *FAIL, const char *GOT)
+{
+    fprintf(stderr, "%s\n", FAIL);
+    fprintf(stderr, "%s\n", GOT);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * seconds_now() - Returns a monotonic time stamp in seconds.
+ */
+double seconds_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * label_weight() - Returns a weight between 1 and MAX_WEIGHT for an edge, using a FNV-1a hash
+ * of its labels.
+ */
+uint32_t label_weight(const char *src, const char *dest)
+{
+    uint32_t h = 2166136261u;
+    for (const char *s = src; *s; s++)
+        h = (h ^ (unsigned char)*s) * 16777619u;
+    h = (h ^ ' ') * 16777619u;
+    for (const char *s = dest; *s; s++)
+        h = (h ^ (unsigned char)*s) * 16777619u;
+    return 1 + h % MAX_WEIGHT;
+}
+
+/**
+ * csr_build() - Builds a CSR graph from a list of edges.
+ */
+csr_graph csr_build(int nodes, const edge *edges, int n_edges)
+{
+    csr_graph g;
+    g.nodes = nodes;
+    g.first = calloc(nodes + 1, sizeof(int));
+    g.target = malloc((n_edges > 0 ? n_edges : 1) * sizeof(int));
+    g.weight = malloc((n_edges > 0 ? n_edges : 1) * sizeof(uint32_t));
+
+    // Count the edges from every node, then place them.
+    for (int e = 0; e < n_edges; e++)
+        g.first[edges[e].src + 1]++;
+    for (int i = 0; i < nodes; i++)
+        g.first[i + 1] += g.first[i];
+
+    int *next = malloc((nodes > 0 ? nodes : 1) * sizeof(int));
+    memcpy(next, g.first, nodes * sizeof(int));
+    for (int e = 0; e < n_edges; e++)
+    {
+        int k = next[edges[e].src]++;
+        g.target[k] = edges[e].dest;
+        g.weight[k] = edges[e].weight;
+    }
+    free(next);
+
+    return g;
+}
+
+void csr_kill(csr_graph *g)
+{
+    free(g->first);
+    free(g->target);
+    free(g->weight);
+}
+
+int compare_labels(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/**
+ * read_map() - Reads a map file into a CSR graph. Labels are numbered in sorted order.
+ */
+csr_graph read_map(const char *path)
+{
+    FILE *in = fopen(path, "r");
+    if (in == NULL)
+    {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+
+    char line[BUFSIZE];
+    char src[MAXNODENAME + 1];
+    char dest[MAXNODENAME + 1];
+    int n_edges = 0;
+    int capacity = 1024;
+    char **labels = malloc(2 * capacity * sizeof(char *));
+    bool have_count = false;
+
+    while (fgets(line, BUFSIZE, in) != NULL)
+    {
+        // Skip blank lines, comments and the edge count.
+        char *p = line;
+        while (isspace((unsigned char)*p))
+            p++;
+        if (*p == '\0' || *p == '#')
+            continue;
+        if (!have_count)
+        {
+            have_count = true;
+            continue;
+        }
+        if (sscanf(p, "%40s %40s", src, dest) != 2)
+            continue;
+
+        if (n_edges == capacity)
+        {
+            capacity *= 2;
+            labels = realloc(labels, 2 * capacity * sizeof(char *));
+        }
+        labels[2 * n_edges] = strcpy(malloc(strlen(src) + 1), src);
+        labels[2 * n_edges + 1] = strcpy(malloc(strlen(dest) + 1), dest);
+        n_edges++;
+    }
+    fclose(in);
+
+    // Number the distinct labels in sorted order.
+    char **sorted = malloc((2 * n_edges + 1) * sizeof(char *));
+    memcpy(sorted, labels, 2 * n_edges * sizeof(char *));
+    qsort(sorted, 2 * n_edges, sizeof(char *), compare_labels);
+    int nodes = 0;
+    for (int i = 0; i < 2 * n_edges; i++)
+        if (nodes == 0 || strcmp(sorted[nodes - 1], sorted[i]) != 0)
+            sorted[nodes++] = sorted[i];
+
+    edge *edges = malloc((n_edges > 0 ? n_edges : 1) * sizeof(edge));
+    for (int e = 0; e < n_edges; e++)
+    {
+        char **s = bsearch(&labels[2 * e], sorted, nodes, sizeof(char *), compare_labels);
+        char **d = bsearch(&labels[2 * e + 1], sorted, nodes, sizeof(char *), compare_labels);
+        edges[e].src = s - sorted;
+        edges[e].dest = d - sorted;
+        edges[e].weight = label_weight(labels[2 * e], labels[2 * e + 1]);
+    }
+
+    csr_graph g = csr_build(nodes, edges, n_edges);
+
+    for (int i = 0; i < 2 * n_edges; i++)
+        free(labels[i]);
+    free(labels);
+    free(sorted);
+    free(edges);
+
+    return g;
+}
+
+/**
+ * random_graph() - Generates a random graph with fixed seed.
+ */
+csr_graph random_graph(int nodes, int n_edges)
+{
+    edge *edges = malloc(n_edges * sizeof(edge));
+    uint64_t state = 88172645463325252ull;
+
+    for (int e = 0; e < n_edges; e++)
+    {
+        // xorshift64 random numbers.
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        edges[e].src = state % nodes;
+        edges[e].dest = (state >> 24) % nodes;
+        edges[e].weight = 1 + (state >> 48) % MAX_WEIGHT;
+    }
+
+    csr_graph g = csr_build(nodes, edges, n_edges);
+    free(edges);
+    return g;
+}
+
+/**
+ * dijkstra_heap() - Shortest distances from src using the indexed heap with decrease-key.
+ */
+void dijkstra_heap(const csr_graph *g, heap *h, int src, uint32_t *dist)
+{
+    for (int i = 0; i < g->nodes; i++)
+        dist[i] = UNREACHED;
+
+    dist[src] = 0;
+    heap_insert(h, src, 0);
+    while (!heap_is_empty(h))
+    {
+        int u = heap_remove_front(h);
+        for (int k = g->first[u]; k < g->first[u + 1]; k++)
+        {
+            int v = g->target[k];
+            uint32_t d = dist[u] + g->weight[k];
+            if (d < dist[v])
+            {
+                dist[v] = d;
+                heap_insert_or_decrease(h, v, d);
+            }
+        }
+    }
+}
+
+/**
+ * dijkstra_radix_heap() - Shortest distances from src using the radix heap. Nodes are inserted
+ * again instead of decreased, stale copies are skipped.
+ */
+void dijkstra_radix_heap(const csr_graph *g, radix_heap *h, int src, uint32_t *dist)
+{
+    for (int i = 0; i < g->nodes; i++)
+        dist[i] = UNREACHED;
+
+    radix_heap_clear(h);
+    dist[src] = 0;
+    radix_heap_insert(h, src, 0);
+    while (!radix_heap_is_empty(h))
+    {
+        uint32_t du;
+        int u = radix_heap_remove_front(h, &du);
+        if (du != dist[u])
+            continue;
+        for (int k = g->first[u]; k < g->first[u + 1]; k++)
+        {
+            int v = g->target[k];
+            uint32_t d = du + g->weight[k];
+            if (d < dist[v])
+            {
+                dist[v] = d;
+                radix_heap_insert(h, v, d);
+            }
+        }
+    }
+}
+
+int main(int argc, char const *argv[])
+{
+    csr_graph g;
+    if (argc > 1)
+        g = read_map(argv[1]);
+    else
+        g = random_graph(RANDOM_NODES, RANDOM_EDGES);
+
+    printf("%d nodes, %d edges\n", g.nodes, g.first[g.nodes]);
+    if (g.nodes == 0)
+    {
+        csr_kill(&g);
+        return 0;
+    }
+
+    uint32_t *dist1 = malloc(g.nodes * sizeof(uint32_t));
+    uint32_t *dist2 = malloc(g.nodes * sizeof(uint32_t));
+    heap *h = heap_empty(g.nodes - 1);
+    radix_heap *rh = radix_heap_empty();
+    double heap_time = 0;
+    double radix_time = 0;
+
+    for (int s = 0; s < SOURCES; s++)
+    {
+        int src = (int)((int64_t)s * g.nodes / SOURCES);
+
+        double start = seconds_now();
+        dijkstra_heap(&g, h, src, dist1);
+        heap_time += seconds_now() - start;
+
+        start = seconds_now();
+        dijkstra_radix_heap(&g, rh, src, dist2);
+        radix_time += seconds_now() - start;
+
+        if (memcmp(dist1, dist2, g.nodes * sizeof(uint32_t)) != 0)
+            error("FAIL: The heaps gave different distances",
+                  "Expected: Equal shortest distances");
+    }
+
+    printf("%d searches\n", SOURCES);
+    printf("heap        %10.3f ms/search\n", 1000 * heap_time / SOURCES);
+    printf("radix_heap  %10.3f ms/search\n", 1000 * radix_time / SOURCES);
+
+    heap_kill(h);
+    radix_heap_kill(rh);
+    free(dist1);
+    free(dist2);
+    csr_kill(&g);
+    return 0;
+}
@@ -24,10 +24,10 @@ def update_hand_in_date(file_path):
 
 
 def compile_file(file_name):
-    compile_command = f"gcc -std=c99 -Wall -Werror -g -I lib -o {file_name}test test_imp.c {file_name}.c lib/dlist.c"
+    compile_command = f"gcc -std=c99 -Wall -Werror -g -I lib -o {file_name}test test_imp.c {file_name}.c lib/dlist.c lib/pool.c lib/allocator.c lib/table.c lib/intern.c lib/graphexport.c"
 
     if file_name == "graph":
-        compile_command += " lib/array_1d.c lib/array_2d.c"
+        compile_command += " lib/array_1d.c lib/array_2d.c lib/bitset.c"
     elif file_name == "graph2":
          compile_command += ""
 
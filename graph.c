@@ -3,8 +3,13 @@
 #include <string.h>
 
 #include <graph.h>
+#include <graphexport.h>
 #include <array_1d.h>
 #include <array_2d.h>
+#include <array_typed.h>
+#include <intern.h>
+#include <pool.h>
+#include <bitset.h>
 
 /**
  * Implemetation of graph that uses a Adjacency matrix.
@@ -15,24 +20,99 @@
  * 
  * Version:
  *   2024-03-14: v1.0. First hand in
+ *   2026-10-18: v1.1. The index map grows as nodes are inserted.
+ *   2026-10-18: v1.2. The adjacency matrix is sparse and grows with the graph.
+ *   2026-10-18: v1.3. Small graphs use a bit matrix, edges are no longer malloc'd.
+ *   2026-10-18: v1.4. Labels are looked up in a hash table.
+ *   2026-10-18: v1.5. The seen status is kept in a bitset indexed by node.
+ *   2026-10-18: v1.6. Nodes, labels and the sparse matrix may come from an allocator.
+ *   2026-10-18: v1.7. Labels are interned, nodes are compared by id and come from a pool.
+ *   2026-10-18: v1.8. Graphs can be created with the exact number of nodes and edges.
+ *   2026-10-18: v1.9. Edges can be deleted.
+ *   2026-10-18: v1.10. Nodes can be walked by index and graph_print is implemented.
+ *   2026-10-18: v1.11. The bit matrix and the seen bits also come from the allocator.
 */
 
 // ====================== PUBLIC DATA TYPES ==========================
 
 typedef struct node {
-	char *src;
-	bool seen;
+	int id;		// Id of the label, also the index of the node in the matrix and the index map.
 } node;
 
+// Graphs with at most this many nodes use a bit matrix (at most 2 MB), larger graphs a sparse
+// matrix.
+#define BIT_MATRIX_MAX_NODES 4096
+
 typedef struct graph {
+	// The adjacency matrix. Exactly one of bits and matrix is used, the other is NULL.
+	array_2d_bit *bits;
 	array_2d *matrix;
 	array_1d *index_map;
+	intern *labels;	// The labels of the nodes, the id of a label is the id of its node.
+	pool *nodes;	// The node structs.
+	bitset *seen;	// The seen status of every node, by id.
 	int nodes_added;
 	int max_nodes;
+	const allocator *alloc;	// Allocator for the graph and everything in it.
 } graph;
 
 // =================== INTERNAL FUNCTIONS ======================
 
+// Value stored for every edge in a sparse matrix. The matrix has no free function, so all edges
+// share this value instead of each having an allocated int.
+static int edge_marker = 1;
+
+/**
+ * next_edge() - Gets the next neighbor index of a node in the adjacency matrix.
+ * @g: Graph to inspect.
+ * @i: Index of the node.
+ * @j: Index to search after, or -1 to search from the start.
+ *
+ * Returns: The smallest index larger than j with an edge from node i, or g->max_nodes if
+ * there is none.
+*/
+static int next_edge(const graph *g, int i, int j)
+{
+	if (g->bits != NULL)
+		return array_2d_bit_next_in_row(g->bits, i, j);
+
+	return array_2d_next_in_row(g->matrix, i, j);
+}
+
+/**
+ * resize_matrix() - Resizes the adjacency matrix to hold a number of nodes.
+ * @g: Graph to manipulate.
+ * @max_nodes: The number of nodes the matrix should hold.
+ *
+ * Switches from the bit matrix to a sparse matrix if max_nodes gets too large for a bit
+ * matrix.
+ *
+ * Returns: Nothing.
+*/
+static void resize_matrix(graph *g, int max_nodes)
+{
+	if (g->bits != NULL && max_nodes > BIT_MATRIX_MAX_NODES)
+	{
+		// Move the edges over to a sparse matrix.
+		g->matrix = array_2d_create_sparse_alloc(0, max_nodes - 1, 0, max_nodes - 1, NULL,
+							 g->alloc);
+		for (int i = 0; i < g->max_nodes; i++)
+			for (int j = next_edge(g, i, -1); j < g->max_nodes; j = next_edge(g, i, j))
+				array_2d_set_value(g->matrix, &edge_marker, i, j);
+
+		array_2d_bit_kill(g->bits);
+		g->bits = NULL;
+	}
+	else if (g->bits != NULL)
+		array_2d_bit_resize(g->bits, max_nodes - 1, max_nodes - 1);
+	else
+		array_2d_resize(g->matrix, max_nodes - 1, max_nodes - 1);
+
+	// The seen bits grow with the matrix.
+	bitset_resize(g->seen, max_nodes);
+	g->max_nodes = max_nodes;
+}
+
 /**
  * node_index() - gets the index of the node in the matrix and list.
  * @g: Pointer to Graph where we search for the node.
@@ -42,57 +122,36 @@ typedef struct graph {
 */
 int node_index(const graph *g, const char *s)
 {
-	// Iterates through the index map
-	for (int i = 0; i < g->nodes_added; i++)
-	{
-		// Checks if the nodes label and the searched for label is the same.
-		if (strcmp(((node*)array_1d_inspect_value(g->index_map, i))->src, s) == 0)
-		{
-			return i;
-		}
-	}
-
-	// Label is not in graph.
-	return -1;
+	// The id of the label is the index of the node.
+	return intern_lookup(g->labels, s);
 }
 
 /**
- * new_node() - Creates a new node with label.
- * @s: Label to give to node.
+ * has_node() - Checks if a node belongs to the graph.
+ * @g: Graph to inspect.
+ * @n: Node to look for.
  * 
- * Returns: Pointer to node.
+ * Returns: true if the node is in the graph, otherwise false.
 */
-node *new_node(const char *s)
+static bool has_node(const graph *g, const node *n)
 {
-	// Allocates space for node.
-	node *new_node = malloc(sizeof(node));
-
-	// Allocates space for and copies the label for the node.
-	char *src_lbl = malloc(strlen(s) + 1);
-	strcpy(src_lbl, s);
-
-	// Assigns the label, index of the node and start seen value.
-	new_node->src = src_lbl;
-	new_node->seen = false;
-
-	return new_node;
+	return n->id < g->nodes_added && array_1d_inspect_value(g->index_map, n->id) == n;
 }
 
 /**
- * free_node() - Handels the freeing of the nodes
- * @in: Pointer to a node.
+ * new_node() - Creates a new node.
+ * @id: Id of the label of the node.
+ * @nodes: Pool to take the node from.
  * 
- * Returns: Nothing.
+ * Returns: Pointer to node.
 */
-void free_node(void *in)
+node *new_node(int id, pool *nodes)
 {
-	node *n = in;
+	// The label is kept in the interner of the graph, the node only needs its id.
+	node *new_node = pool_alloc(nodes);
+	new_node->id = id;
 
-	if (n != NULL && n->src != NULL)
-	{
-		free(n->src);
-		free(n);
-	}
+	return new_node;
 }
 
 // =================== NODE COMPARISON FUNCTION ======================
@@ -107,39 +166,86 @@ void free_node(void *in)
  */
 bool nodes_are_equal(const node *n1,const node *n2)
 {
-	// Compares the node labels, same label -> same node.
-	if (strcmp(n1->src, n2->src) == 0)
-	{
-		return true;
-	}
-
-	return false;
+	// The labels are interned, same id -> same label -> same node.
+	return n1->id == n2->id;
 }
 
 // =================== GRAPH STRUCTURE ======================
 
 /**
  * graph_empty() - Create an empty graph.
- * @max_nodes: The maximum number of nodes the graph can hold.
+ * @max_nodes: The expected number of nodes. The graph grows if more are inserted.
  *
  * Returns: A pointer to the new graph.
  */
 graph *graph_empty(int max_nodes)
+{
+	return graph_empty_alloc(max_nodes, NULL);
+}
+
+/**
+ * graph_empty_alloc() - Create an empty graph that uses an allocator.
+ * @max_nodes: The expected number of nodes. The graph grows if more are inserted.
+ * @a: Allocator for the graph, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new graph.
+ */
+graph *graph_empty_alloc(int max_nodes, const allocator *a)
 {
 	// Allocates memory for graph.
-	graph *new_graph = malloc(sizeof(graph));
+	graph *new_graph = allocator_alloc(a, sizeof(graph));
+	new_graph->alloc = a;
 
 	// Assigns start values.
 	new_graph->nodes_added = 0;
 	new_graph->max_nodes = max_nodes;
 
 	// Creates the adjacency matrix (array_2d) and the "translation" map (array_1d).
-	new_graph->index_map = array_1d_create(0, max_nodes - 1, *free_node);
-	new_graph->matrix = array_2d_create(0, max_nodes - 1, 0, max_nodes - 1, free);
+	// The map starts out empty and grows as nodes are pushed, max_nodes is only a size hint for it.
+	// The nodes are released with their pool, so the map frees nothing.
+	new_graph->index_map = array_1d_create_alloc(0, -1, NULL, a);
+	array_1d_reserve(new_graph->index_map, max_nodes);
+	// All labels are stored in one block of the interner.
+	new_graph->labels = intern_empty(a);
+	new_graph->nodes = pool_create_alloc(sizeof(node), false, a);
+	// One seen bit per node, so resetting the seen status clears a few words per 256 nodes.
+	new_graph->seen = bitset_empty_alloc(max_nodes, a);
+	// Small graphs get a bit matrix, larger ones a sparse matrix so that it only uses memory for
+	// the edges. The matrix grows if more than max_nodes nodes are inserted.
+	new_graph->bits = NULL;
+	new_graph->matrix = NULL;
+	if (max_nodes <= BIT_MATRIX_MAX_NODES)
+		new_graph->bits = array_2d_bit_create_alloc(0, max_nodes - 1, 0, max_nodes - 1, a);
+	else
+		new_graph->matrix = array_2d_create_sparse_alloc(0, max_nodes - 1, 0, max_nodes - 1,
+								 NULL, a);
 
 	return new_graph;
 }
 
+/**
+ * graph_empty_sized() - Create an empty graph for a known number of nodes and edges.
+ * @n_nodes: The number of nodes that will be inserted.
+ * @out_degree: Array of n_nodes edge counts, out_degree[i] edges will be inserted
+ *              from the i:th node inserted, or NULL if not known.
+ * @a: Allocator for the graph, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new graph.
+ */
+graph *graph_empty_sized(int n_nodes, const int *out_degree, const allocator *a)
+{
+	// The matrix, the index map and the seen bits get exactly one row or slot per node.
+	graph *g = graph_empty_alloc(n_nodes, a);
+	intern_reserve(g->labels, n_nodes);
+
+	// Every row of a sparse matrix is allocated once with room for all edges of its node.
+	if (g->matrix != NULL && out_degree != NULL)
+		for (int i = 0; i < n_nodes; i++)
+			array_2d_reserve_row(g->matrix, i, out_degree[i]);
+
+	return g;
+}
+
 /**
  * graph_is_empty() - Check if a graph is empty, i.e. has no nodes.
  * @g: Graph to check.
@@ -167,26 +273,42 @@ bool graph_is_empty(const graph *g)
  */
 graph *graph_insert_node(graph *g, const char *s)
 {
-	// The node is already in the graph. This since we can not have two nodes with the same label.
-	if (node_index(g, s) != -1)
-		return g;
+	graph_find_or_insert_node(g, s, strlen(s));
+
+	// Returns the modified graph.
+	return g;
+}
+
+/**
+ * graph_find_or_insert_node() - Finds a node by a label that need not be NUL-terminated, and
+ * inserts it if it is not in the graph.
+ * @g: Graph to manipulate.
+ * @s: Characters of the node name.
+ * @len: Number of characters in the node name.
+ *
+ * Returns: A pointer to the node with the name.
+ */
+node *graph_find_or_insert_node(graph *g, const char *s, size_t len)
+{
+	// The node is already in the graph if its label has an older id. This since we can not
+	// have two nodes with the same label.
+	int id = intern_insert_n(g->labels, s, len);
+	if (id < g->nodes_added)
+		return array_1d_inspect_value(g->index_map, id);
 
-	// More nodes than said while constructing.
+	// More nodes than said while constructing, double the size of the matrix.
 	if (g->nodes_added >= g->max_nodes)
-	{
-		fprintf(stderr, "More nodes then stated!\n");
-		graph_kill(g);
-		exit(EXIT_FAILURE);
-	}
+		resize_matrix(g, g->max_nodes < 1 ? 1 : 2 * g->max_nodes);
 
 	// Adds the node to the graph
-	array_1d_set_value(g->index_map, new_node(s), g->nodes_added);
+	node *n = new_node(id, g->nodes);
+	array_1d_push(g->index_map, n);
 
 	// Increase the amount of nodes in the graph.
 	g->nodes_added += 1;
 
-	// Returns the modified graph.
-	return g;
+	// Returns the new node.
+	return n;
 }
 
 /**
@@ -219,7 +341,7 @@ node *graph_find_node(const graph *g, const char *s)
 bool graph_node_is_seen(const graph *g, const node *n)
 {
 	// Returns the seen status for the node.
-	return n->seen;
+	return bitset_test(g->seen, n->id);
 }
 
 /**
@@ -233,7 +355,10 @@ bool graph_node_is_seen(const graph *g, const node *n)
 graph *graph_node_set_seen(graph *g, node *n, bool seen)
 {
 	// Sets the seen status for the node to seen.
-	n->seen = seen;
+	if (seen)
+		bitset_set(g->seen, n->id);
+	else
+		bitset_clear(g->seen, n->id);
 
 	// Returns the graph.
 	return g;
@@ -247,17 +372,9 @@ graph *graph_node_set_seen(graph *g, node *n, bool seen)
  */
 graph *graph_reset_seen(graph *g)
 {
-	// Graph is empty, we do not need to do anything.
-	if (graph_is_empty(g))
-		return g;
+	// Clears the seen status for all nodes at once.
+	bitset_clear_all(g->seen);
 
-	// Iterates through the loop and resets the seen status for all nodes.
-	for (int i = 0; i < g->nodes_added; i++)
-	{
-		node *node = array_1d_inspect_value(g->index_map, i);
-		node->seen = false;
-	}
-	
 	// Returns the graph.
 	return g;
 }
@@ -274,20 +391,45 @@ graph *graph_reset_seen(graph *g)
  */
 graph *graph_insert_edge(graph *g, node *n1, node *n2)
 {
-	// Get index of nodes, -1 if they are not in this graph.
-	int index_of_node1 = node_index(g, n1->src);
-	int index_of_node2 = node_index(g, n2->src);
-
 	// Checks if the nodes are in the graph or not. If not it exits early.
-	if (index_of_node1 == -1 || index_of_node2 == -1)
+	if (!has_node(g, n1) || !has_node(g, n2))
 		return NULL;
-	
-	// Allocates space for the integer representing an edge.
-	int *value = malloc(sizeof(int));
-	*value = 1;
+
+	// The id of a node is its index.
+	int index_of_node1 = n1->id;
+	int index_of_node2 = n2->id;
 
 	// Sets the edge in the adjacency matrix.
-	array_2d_set_value(g->matrix, value, index_of_node1, index_of_node2);
+	if (g->bits != NULL)
+		array_2d_bit_set(g->bits, true, index_of_node1, index_of_node2);
+	else
+		array_2d_set_value(g->matrix, &edge_marker, index_of_node1, index_of_node2);
+
+	// returns the modified graph.
+	return g;
+}
+
+/**
+ * graph_delete_edge() - Remove an edge from the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * NOTE: Undefined unless both nodes are in the graph. Does nothing if the edge is not.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_delete_edge(graph *g, node *n1, node *n2)
+{
+	// Checks if the nodes are in the graph or not. If not it exits early.
+	if (!has_node(g, n1) || !has_node(g, n2))
+		return NULL;
+
+	// Clears the edge in the adjacency matrix. In a sparse matrix only the row of n1 is touched.
+	if (g->bits != NULL)
+		array_2d_bit_set(g->bits, false, n1->id, n2->id);
+	else
+		array_2d_set_value(g->matrix, NULL, n1->id, n2->id);
 
 	// returns the modified graph.
 	return g;
@@ -308,26 +450,93 @@ dlist *graph_neighbours(const graph *g,const node *n)
 	dlist *neighbors = dlist_empty(NULL);
 
 	// Get index of node
-	int index_of_node = node_index(g, n->src);
+	int index_of_node = n->id;
 
-	// Iterates through the adjacency matrix checking for neighbors.
-	for (int i = 0; i < g->nodes_added; i++)
-	{
-		// If no value has been set there is no connection.
-		if (array_2d_has_value(g->matrix, index_of_node, i))
-		{
-			int *value = array_2d_inspect_value(g->matrix, index_of_node, i);
-
-			// Add neighbor to the list if it marked as neighbor in the adjacency matrix.
-			if (*value == 1)
-				dlist_insert(neighbors, array_1d_inspect_value(g->index_map, i), dlist_first(neighbors));
-		}
-	}
+	// Iterates through the edges in the row of the node and adds every neighbor to the list.
+	// Positions without an edge are skipped.
+	for (int i = next_edge(g, index_of_node, -1); i < g->max_nodes; i = next_edge(g, index_of_node, i))
+		dlist_insert(neighbors, array_1d_inspect_value(g->index_map, i), dlist_first(neighbors));
 
 	// Returns the list of neighbors.
 	return neighbors;
 }
 
+/**
+ * graph_node_count() - Return the number of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of nodes.
+ */
+int graph_node_count(const graph *g)
+{
+	return g->nodes_added;
+}
+
+/**
+ * graph_node_at() - Return a node by its index.
+ * @g: Graph to inspect.
+ * @i: Index of the node, 0 for the first node inserted and
+ *     graph_node_count()-1 for the last one.
+ *
+ * Returns: A pointer to the node.
+ */
+node *graph_node_at(const graph *g, int i)
+{
+	// The index of a node is its id.
+	return array_1d_inspect_value(g->index_map, i);
+}
+
+/**
+ * graph_node_index() - Return the index of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ *
+ * Returns: The index of the node, see graph_node_at().
+ */
+int graph_node_index(const graph *g, const node *n)
+{
+	return n->id;
+}
+
+/**
+ * graph_node_label() - Return the label of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ * @len: Set to the length of the label, or NULL.
+ *
+ * The labels are stored together and may move when the storage grows,
+ * so the pointer is valid only until the next node is inserted into the
+ * graph, like a string from intern_string(). Copy the label to keep it
+ * longer.
+ *
+ * Returns: The NUL-terminated label.
+ */
+const char *graph_node_label(const graph *g, const node *n, size_t *len)
+{
+	// The label is interned under the id of the node.
+	if (len != NULL)
+		*len = intern_length(g->labels, n->id);
+
+	return intern_string(g->labels, n->id);
+}
+
+/**
+ * graph_for_each_neighbour() - Call a function for every neighbour of a node.
+ * @g: Graph to inspect.
+ * @n: Node to get neighbours for.
+ * @func: Function to call with every neighbour.
+ * @arg: Argument passed on to func.
+ *
+ * Returns: Nothing.
+ */
+void graph_for_each_neighbour(const graph *g, const node *n, graph_neighbour_callback *func,
+			      void *arg)
+{
+	// Walks the row of the node in the adjacency matrix.
+	for (int i = next_edge(g, n->id, -1); i < g->max_nodes; i = next_edge(g, n->id, i))
+		func(array_1d_inspect_value(g->index_map, i), arg);
+}
+
 /**
  * graph_kill() - Destroy a given graph.
  * @g: Graph to destroy.
@@ -339,9 +548,31 @@ dlist *graph_neighbours(const graph *g,const node *n)
 void graph_kill(graph *g)
 {
 	// Kills the adjacency matrix
-	array_2d_kill(g->matrix);
-	// Kills the index map and frees the resources used by the nodes.
+	if (g->bits != NULL)
+		array_2d_bit_kill(g->bits);
+	else
+		array_2d_kill(g->matrix);
+	intern_kill(g->labels);
+	bitset_kill(g->seen);
+	// Kills the index map and releases all nodes at once.
 	array_1d_kill(g->index_map);
+	pool_kill(g->nodes);
 	// Frees the remaining resources used by the graph.
-	free(g);
-}
\ No newline at end of file
+	allocator_free(g->alloc, g);
+}
+
+/**
+ * graph_print() - Iterate over the graph elements and print their values.
+ * @g: Graph to inspect.
+ *
+ * Prints the graph to stdout in the format of a map file.
+ *
+ * Returns: Nothing.
+ */
+void graph_print(const graph *g)
+{
+	// Anything printf:ed before must come first.
+	fflush(stdout);
+	graph_export(g, GRAPH_EXPORT_MAP, 0, graph_node_count(g), stdout);
+	fflush(stdout);
+}
@@ -1,9 +1,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 
 #include <graph.h>
+#include <graphexport.h>
 #include <dlist.h>
+#include <table.h>
+#include <intern.h>
+#include <container_typed.h>
 
 /**
  * Implemetation of graph that uses a dynamic datatype.
@@ -14,103 +19,99 @@
  * 
  * Version:
  *   2024-03-14: v1.0. First hand in
+ *   2026-10-18: v1.1. Neighbor lists allocate their cells from a shared pool.
+ *   2026-10-18: v1.2. Node and neighbor lists are unrolled.
+ *   2026-10-18: v1.3. Labels are looked up in a hash table, duplicate edges are ignored.
+ *   2026-10-18: v1.4. Nodes and lists may come from an allocator.
+ *   2026-10-18: v1.5. Labels are interned, nodes are compared by id and come from a pool.
+ *   2026-10-18: v1.6. Graphs can be created with the exact number of nodes and edges.
+ *   2026-10-18: v1.7. Edges can be deleted, the graph grows past max_nodes.
+ *   2026-10-18: v1.8. Nodes can be walked by index and graph_print is implemented.
+ *   2026-10-18: v1.9. The edge table and the node vector also come from the allocator.
 */
 
 // ====================== PUBLIC DATA TYPES ==========================
 
 typedef struct node {
-	char *src;
 	dlist *dest;
 	bool seen;
+	int id;		// Id of the label, also the number of nodes inserted before this one.
 } node;
 
+// Vector of node pointers, indexed by id.
+VEC_TYPED(vec_nodeptr, node *)
+
 typedef struct graph {
 	dlist *nodes;
+	vec_nodeptr *by_id;	// The nodes by id.
+	pool *node_pool;	// The node structs.
+	pool *cells;	// Shared pool for the chunks of all neighbor lists.
+	intern *labels;	// The labels of the nodes, the id of a label is the id of its node.
+	table *edges;	// Holds every edge, keyed by edge_key().
 	int nodes_added;
 	int max_nodes;
+	const allocator *alloc;	// Allocator for the graph, its nodes and lists.
 } graph;
 
 // =================== INTERNAL FUNCTIONS ======================
 
 /**
- * label_com_func() - Compares two labels.
- * @label1: A label (string).
- * @label2: A label (string).
+ * edge_key() - Gets the key of an edge in the edge table.
+ * @n1: Source node of the edge.
+ * @n2: Destination node of the edge.
  * 
- * Returns: 0 if equal, undefined (<0 or >0) if not equal.
+ * Returns: The ids of both nodes packed into one integer key.
 */
-int label_comp_func(const char *label1, const char *label2)
+void *edge_key(const node *n1, const node *n2)
 {
-	return strcmp(label1, label2);
-}
-
-/**
- * get_node_pos() - Gets the position of a node in the list
- * @nodes: Pointer to dlist.
- * @s: A label (string).
- * 
- * Returns: A dlist position if the node with the specified label is in the list, otherwise NULL.
-*/
-dlist_pos get_node_pos(dlist *nodes, const char *s)
-{
-	dlist_pos pos = dlist_first(nodes);
-
-	// Iterates through the list untill pos is the end position.
-	while (!dlist_is_end(nodes, pos))
-	{
-		node *node_at_pos = dlist_inspect(nodes, pos);
-
-		// Compares the labels, if the same we return the position.
-		if (label_comp_func(s, node_at_pos->src) == 0)
-			return pos;
-		
-		// Takes the next position in the list.
-		pos = dlist_next(nodes, pos);
-	}
-	
-	// Node is not in list.
-	return NULL;
+	return TABLE_INT_KEY(((int64_t)n1->id << 32) | (uint32_t)n2->id);
 }
 
 /**
  * new_node() - Creates a new node.
- * @s: A label (string) for the new node.
+ * @id: The id of the label of the node.
+ * @nodes: The pool to take the node from.
+ * @cells: The pool the neighbor list takes its chunks from.
+ * @a: Allocator to take the neighbor list from.
  * 
  * Returns: A pointer to the node.
 */
-node *new_node(const char *s)
+node *new_node(int id, pool *nodes, pool *cells, const allocator *a)
 {
-	// Allocates memory for the node.
-	node *new_node = malloc(sizeof(node));
+	// The label is kept in the interner of the graph, the node only needs its id.
+	node *new_node = pool_alloc(nodes);
 
-	// Assigns memory and copies the label for the node.
-	char *src_lbl = malloc(strlen(s) + 1);
-	strcpy(src_lbl, s);
-
-	// Assigns the label, creates a neighbor list and a start seen value.
-	new_node->src = src_lbl;
-	new_node->dest = dlist_empty(NULL);
+	// Creates a neighbor list and a start seen value.
+	new_node->dest = dlist_empty_unrolled_alloc(NULL, cells, a);
 	new_node->seen = false;
+	new_node->id = id;
 
 	return new_node;
 }
 
 /**
  * free_node() - Frees the resources used by a node
- * @in: A pointer to a node.
+ * @n: A pointer to a node.
  * 
+ * The node itself is released with the node pool.
+ *
  * Returns: Nothing.
 */
-void free_node(void *in)
+void free_node(node *n)
 {
-	node *n = in;
+	dlist_kill(n->dest);
+}
 
-	if (n != NULL && n->src != NULL)
-	{
-		free(n->src);
-		dlist_kill(n->dest);
-		free(n);
-	}
+/**
+ * has_node() - Checks if a node belongs to the graph.
+ * @g: Graph to inspect.
+ * @n: Node to look for.
+ * 
+ * Returns: true if the node is in the graph, otherwise false.
+*/
+static bool has_node(const graph *g, const node *n)
+{
+	return n->id < vec_nodeptr_size(g->by_id) && vec_nodeptr_get(g->by_id, n->id) == n;
 }
 
 /**
@@ -148,37 +149,82 @@ dlist *cpy_list(dlist *in_list)
  */
 bool nodes_are_equal(const node *n1,const node *n2)
 {
-	// Compares the node labels, same label -> same node.
-	if (strcmp(n1->src, n2->src) == 0)
-	{
-		return true;
-	}
-
-	return false;
+	// The labels are interned, same id -> same label -> same node.
+	return n1->id == n2->id;
 }
 
 // =================== GRAPH STRUCTURE ======================
 
 /**
  * graph_empty() - Create an empty graph.
- * @max_nodes: The maximum number of nodes the graph can hold.
+ * @max_nodes: The expected number of nodes. The graph grows if more are inserted.
  *
  * Returns: A pointer to the new graph.
  */
 graph *graph_empty(int max_nodes)
+{
+	return graph_empty_alloc(max_nodes, NULL);
+}
+
+/**
+ * graph_empty_alloc() - Create an empty graph that uses an allocator.
+ * @max_nodes: The expected number of nodes. The graph grows if more are inserted.
+ * @a: Allocator for the graph, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new graph.
+ */
+graph *graph_empty_alloc(int max_nodes, const allocator *a)
 {
 	// Allocates space for the graph.
-	graph *new_graph = malloc(sizeof(graph));
+	graph *new_graph = allocator_alloc(a, sizeof(graph));
+	new_graph->alloc = a;
 
-	// Saves the max amount of nodes and set nodes_added to 0.
+	// Saves the expected amount of nodes and set nodes_added to 0.
 	new_graph->max_nodes = max_nodes;
 	new_graph->nodes_added = 0;
 	
-	new_graph->nodes = dlist_empty(*free_node);
+	// The lists are unrolled so walking them reads several nodes per cache line.
+	// All neighbor lists share one pool, so the edges are not allocated one by one.
+	// The nodes are freed by graph_kill, since they come from a pool of the graph.
+	new_graph->cells = dlist_chunk_pool_create_alloc(a);
+	new_graph->nodes = dlist_empty_unrolled_alloc(NULL, NULL, a);
+	new_graph->node_pool = pool_create_alloc(sizeof(node), false, a);
+	new_graph->by_id = vec_nodeptr_empty_alloc(a);
+
+	// All labels are stored in one block of the interner.
+	new_graph->labels = intern_empty(a);
+	new_graph->edges = table_empty_alloc(table_hash_int, table_compare_int, NULL, NULL, a);
 
 	return new_graph;
 }
 
+/**
+ * graph_empty_sized() - Create an empty graph for a known number of nodes and edges.
+ * @n_nodes: The number of nodes that will be inserted.
+ * @out_degree: Array of n_nodes edge counts, out_degree[i] edges will be inserted
+ *              from the i:th node inserted, or NULL if not known.
+ * @a: Allocator for the graph, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new graph.
+ */
+graph *graph_empty_sized(int n_nodes, const int *out_degree, const allocator *a)
+{
+	graph *g = graph_empty_alloc(n_nodes, a);
+	vec_nodeptr_reserve(g->by_id, n_nodes);
+	intern_reserve(g->labels, n_nodes);
+
+	// The edge table is sized once for all edges, so it never rehashes while loading.
+	if (out_degree != NULL)
+	{
+		long long n_edges = 0;
+		for (int i = 0; i < n_nodes; i++)
+			n_edges += out_degree[i];
+		table_reserve(g->edges, n_edges < INT_MAX ? (int)n_edges : INT_MAX);
+	}
+
+	return g;
+}
+
 /**
  * graph_is_empty() - Check if a graph is empty, i.e. has no nodes.
  * @g: Graph to check.
@@ -202,29 +248,41 @@ bool graph_is_empty(const graph *g)
  */
 graph *graph_insert_node(graph *g, const char *s)
 {
-	// The node is already in the graph. This since we can not have two nodes with the same label.
-	if (get_node_pos(g->nodes, s) != NULL)
-		return g;
+	graph_find_or_insert_node(g, s, strlen(s));
+
+	// Returns the modified graph.
+	return g;
+}
+
+/**
+ * graph_find_or_insert_node() - Finds a node by a label that need not be NUL-terminated, and
+ * inserts it if it is not in the graph.
+ * @g: Graph to manipulate.
+ * @s: Characters of the node name.
+ * @len: Number of characters in the node name.
+ *
+ * Returns: A pointer to the node with the name.
+ */
+node *graph_find_or_insert_node(graph *g, const char *s, size_t len)
+{
+	// The node is already in the graph if its label has an older id. This since we can not
+	// have two nodes with the same label.
+	int id = intern_insert_n(g->labels, s, len);
+	if (id < g->nodes_added)
+		return vec_nodeptr_get(g->by_id, id);
 
-	// More nodes than said while constructing.
-	if (g->nodes_added >= g->max_nodes)
-	{
-		fprintf(stderr, "More nodes then stated!\n");
-		graph_kill(g);
-		exit(EXIT_FAILURE);
-	}
-	
 	// The new node
-	node *n = new_node(s);
+	node *n = new_node(id, g->node_pool, g->cells, g->alloc);
 
 	// Adds the node to the graph
 	dlist_insert(g->nodes, n, dlist_first(g->nodes));
+	vec_nodeptr_push(g->by_id, n);
 
 	// Increase the amount of nodes in the graph.
 	g->nodes_added += 1;
 
-	// Returns the modified graph.
-	return g;
+	// Returns the new node.
+	return n;
 }
 
 /**
@@ -236,15 +294,9 @@ graph *graph_insert_node(graph *g, const char *s)
  */
 node *graph_find_node(const graph *g, const char *s)
 {
-	// Gets a position for the node in the graph, NULL if node is not in graph.
-	dlist_pos pos_of_node = get_node_pos(g->nodes, s);
-
-	// Node is not in graph
-	if (pos_of_node == NULL)
-		return NULL;
-	
-	// Node found, returns node
-	return dlist_inspect(g->nodes, pos_of_node);
+	// Looks the label up, NULL if node is not in graph.
+	int id = intern_lookup(g->labels, s);
+	return id == -1 ? NULL : vec_nodeptr_get(g->by_id, id);
 }
 
 /**
@@ -317,9 +369,14 @@ graph *graph_reset_seen(graph *g)
 graph *graph_insert_edge(graph *g, node *n1, node *n2)
 {
 	// Checks if the nodes are in the graph or not. If not it exits early. 
-	if (get_node_pos(g->nodes, n1->src) == NULL || get_node_pos(g->nodes, n2->src) == NULL)
+	if (!has_node(g, n1) || !has_node(g, n2))
 		return NULL;
 
+	// The edge is already in the graph, do not add n2 to the neighbors twice.
+	if (table_has_key(g->edges, edge_key(n1, n2)))
+		return g;
+	table_insert(g->edges, edge_key(n1, n2), NULL);
+
 	// Inserts n2 into n1:s neighbors list.
 	dlist_insert(n1->dest, n2, dlist_first(n1->dest));
 
@@ -327,6 +384,42 @@ graph *graph_insert_edge(graph *g, node *n1, node *n2)
 	return g;
 }
 
+/**
+ * graph_delete_edge() - Remove an edge from the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * NOTE: Undefined unless both nodes are in the graph. Does nothing if the edge is not.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_delete_edge(graph *g, node *n1, node *n2)
+{
+	// Checks if the nodes are in the graph or not. If not it exits early.
+	if (!has_node(g, n1) || !has_node(g, n2))
+		return NULL;
+
+	// The edge is not in the graph, there is nothing to remove.
+	if (!table_has_key(g->edges, edge_key(n1, n2)))
+		return g;
+	table_remove(g->edges, edge_key(n1, n2));
+
+	// Removes n2 from n1:s neighbors list, where it is exactly once since duplicates are ignored.
+	for (dlist_pos pos = dlist_first(n1->dest); !dlist_is_end(n1->dest, pos);
+	     pos = dlist_next(n1->dest, pos))
+	{
+		if (dlist_inspect(n1->dest, pos) == n2)
+		{
+			dlist_remove(n1->dest, pos);
+			break;
+		}
+	}
+
+	// Returns the graph.
+	return g;
+}
+
 /**
  * graph_neighbours() - Return a list of neighbour nodes.
  * @g: Graph to inspect.
@@ -341,6 +434,83 @@ dlist *graph_neighbours(const graph *g,const node *n)
 	return cpy_list(n->dest);
 }
 
+/**
+ * graph_node_count() - Return the number of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of nodes.
+ */
+int graph_node_count(const graph *g)
+{
+	return g->nodes_added;
+}
+
+/**
+ * graph_node_at() - Return a node by its index.
+ * @g: Graph to inspect.
+ * @i: Index of the node, 0 for the first node inserted and
+ *     graph_node_count()-1 for the last one.
+ *
+ * Returns: A pointer to the node.
+ */
+node *graph_node_at(const graph *g, int i)
+{
+	// The index of a node is its id.
+	return vec_nodeptr_get(g->by_id, i);
+}
+
+/**
+ * graph_node_index() - Return the index of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ *
+ * Returns: The index of the node, see graph_node_at().
+ */
+int graph_node_index(const graph *g, const node *n)
+{
+	return n->id;
+}
+
+/**
+ * graph_node_label() - Return the label of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ * @len: Set to the length of the label, or NULL.
+ *
+ * The labels are stored together and may move when the storage grows,
+ * so the pointer is valid only until the next node is inserted into the
+ * graph, like a string from intern_string(). Copy the label to keep it
+ * longer.
+ *
+ * Returns: The NUL-terminated label.
+ */
+const char *graph_node_label(const graph *g, const node *n, size_t *len)
+{
+	// The label is interned under the id of the node.
+	if (len != NULL)
+		*len = intern_length(g->labels, n->id);
+
+	return intern_string(g->labels, n->id);
+}
+
+/**
+ * graph_for_each_neighbour() - Call a function for every neighbour of a node.
+ * @g: Graph to inspect.
+ * @n: Node to get neighbours for.
+ * @func: Function to call with every neighbour.
+ * @arg: Argument passed on to func.
+ *
+ * Returns: Nothing.
+ */
+void graph_for_each_neighbour(const graph *g, const node *n, graph_neighbour_callback *func,
+			      void *arg)
+{
+	// Walks the neighbor list of the node in place.
+	for (dlist_pos pos = dlist_first(n->dest); !dlist_is_end(n->dest, pos);
+	     pos = dlist_next(n->dest, pos))
+		func(dlist_inspect(n->dest, pos), arg);
+}
+
 /**
  * graph_kill() - Destroy a given graph.
  * @g: Graph to destroy.
@@ -351,8 +521,32 @@ dlist *graph_neighbours(const graph *g,const node *n)
  */
 void graph_kill(graph *g)
 {
-	// Kils the list of nodes and frees the resources used by the nodes.
+	intern_kill(g->labels);
+	table_kill(g->edges);
+	// Frees the neighbor lists of the nodes, then the nodes all at once.
+	for (int i = 0; i < vec_nodeptr_size(g->by_id); i++)
+		free_node(vec_nodeptr_get(g->by_id, i));
+	vec_nodeptr_kill(g->by_id);
 	dlist_kill(g->nodes);
+	pool_kill(g->node_pool);
+	// Releases the chunks of the neighbor lists, must be done after the nodes are gone.
+	pool_kill(g->cells);
 	// Frees the remaining resources used by the graph.
-	free(g);
-}
\ No newline at end of file
+	allocator_free(g->alloc, g);
+}
+
+/**
+ * graph_print() - Iterate over the graph elements and print their values.
+ * @g: Graph to inspect.
+ *
+ * Prints the graph to stdout in the format of a map file.
+ *
+ * Returns: Nothing.
+ */
+void graph_print(const graph *g)
+{
+	// Anything printf:ed before must come first.
+	fflush(stdout);
+	graph_export(g, GRAPH_EXPORT_MAP, 0, graph_node_count(g), stdout);
+	fflush(stdout);
+}
@@ -1,15 +1,29 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
 #include <stdbool.h>
+#include <errno.h>
 
 #include <graph.h>
-#include <queue.h>
+#include <mapfile.h>
+#include <mapline.h>
+#include <mapscan.h>
+#include <mapimage.h>
+#include <mapstream.h>
+#include <mapwatch.h>
+#include <graphexport.h>
+#include <intern.h>
+#include <container_typed.h>
 
 #define MAXNODENAME 40
 #define BUFSIZE 400
 
+// Leg limit used for searches that may use any number of legs.
+#define NO_LEG_LIMIT -1
+
+// Queue of node pointers for the breadth first search.
+QUEUE_TYPED(queue_nodeptr, node *)
+
 /**
  * With the help of graph traverses a inputed map and searches
  * if two nodes are connecting of not.
@@ -18,259 +32,474 @@
  * 
  * Hand in date: 2024-03-14
  * 
+ * The origin and destination may be followed by a number k to only accept
+ * paths that use at most k legs, e.g. "UME GOT 2".
+ * 
+ * Usage: ./is_connected <map file>, or ./is_connected --image <image file> for a map compiled by
+ * map_compile, or ./is_connected --stream <map file> to answer queries while the map is loaded, or
+ * ./is_connected --watch <map file> to load the map again when it changes.
+ * 
+ * With --watch <map file> the map is loaded again in the background whenever the file is rewritten
+ * or replaced, see mapwatch.h. Searches that are running finish on the old map and later ones use
+ * the new map.
+ * 
+ * Commands start with a ':', so that they are not taken for the labels of a query. A label that
+ * starts with a ':' can therefore not be searched for.
+ * 
+ * Routes of a map loaded from a map file can be changed without loading it again. ":+ UME BMA" or
+ * ":- LLA PJA" adds or removes a route, and ":delta <file>" applies a delta file of lines such as
+ * "+ UME BMA" and "- LLA PJA".
+ * 
+ * ":export <map|dot|edges> <file> [first last]" writes the map, or the edges from the nodes with
+ * index first up to last, as a map file, a Graphviz digraph or a binary edge list, see
+ * graphexport.h.
+ * 
+ * With --stream a loader thread reads the map file, which may still be written, while the queries
+ * run. Each query is answered on the nodes and edges of the edge lines loaded when it starts, see
+ * mapstream.h, and says on stderr how many that were while the map is still loading.
+ * 
  * Version:
  *   2024-02-14: v1.0. First hand in
+ *   2026-10-18: v1.1. Leg limited searches.
+ *   2026-10-18: v1.2. The search queue is a typed queue of node pointers.
+ *   2026-10-18: v1.3. The map file is memory mapped and tokenized in place.
+ *   2026-10-18: v1.4. Map lines are classified and tokenized in one pass by map_line_scan.
+ *   2026-10-18: v1.5. The map file is lexed in blocks by a map_lexer.
+ *   2026-10-18: v1.6. The map is loaded in two passes into a graph of exactly its size.
+ *   2026-10-18: v1.7. Large map files are scanned by several threads.
+ *   2026-10-18: v1.8. Maps compiled by map_compile are loaded with --image.
+ *   2026-10-18: v1.9. Queries are answered while the map is loaded with --stream.
+ *   2026-10-18: v1.10. Routes are added and removed by map deltas.
+ *   2026-10-18: v1.11. The map is reloaded when its file changes with --watch.
+ *   2026-10-18: v1.12. The map is exported with the export command.
+ *   2026-10-18: v1.13. Commands start with a ':', so they do not hide labels.
+ *   2026-10-18: v1.14. The edges of the map are sorted before they are inserted.
+ *   2026-10-18: v1.15. The search walks the neighbours of a node without copying them.
 */
 
-// ====== HELPER FUNCTIONS
+// ====== START
 
 /**
- * @NOTE: The functions under this section are the same helper function from is_connected_help_functions.c 
- * that we were given in canvas.
+ * compare_edge_dest() - Compares two edges by their destination ids, for qsort.
+ * @a: A pointer to the first edge.
+ * @b: A pointer to the second edge.
+ * 
+ * Returns: A negative number, zero or a positive number if the destination of a is before, the
+ * same as or after the destination of b.
 */
+int compare_edge_dest(const void *a, const void *b)
+{
+	int dest_a = ((const map_edge *)a)->dest;
+	int dest_b = ((const map_edge *)b)->dest;
+
+	return (dest_a > dest_b) - (dest_a < dest_b);
+}
 
 /**
- * @brief Find position of first non-whitespace character.
- *
- * @param s - string to search.
- * @return int - Returns the position of the first non-whitespace character, or -1 if not found.
- */
-int first_non_white_space(const char *s)
+ * sort_edges() - Sorts the edges of a scanned map by source and destination.
+ * @scan: The scanned map.
+ * @n_nodes: The number of labels of the scan.
+ * 
+ * The edges are put in the row of their source, which the out-degrees give the size of, and every
+ * row is then sorted by destination. A row of the adjacency matrix is kept sorted, so an edge
+ * inserted before the edges already in its row moves them, and a node with d edges in the order
+ * of the file takes time quadratic in d to insert. In sorted order every edge is put last.
+ * 
+ * Returns: A pointer to the sorted edges, to be freed by the caller.
+*/
+map_edge *sort_edges(const map_scan *scan, int n_nodes)
 {
-    int i = 0; // Start at first char.
-
-    // Advance as long as we're loooking at white-space until we hit EOL.
-    while (s[i] && isspace(s[i])) {
-        i++;
-    }
-    // We found a non-whitespace char.
-    if (s[i]) {
-        // It was a proper characted. Return its position.
-        return i;
-    } else {
-        // It was the null terminator. Return fail.
-        return -1;
-    }
+	map_edge *sorted = malloc((scan->n_edges > 0 ? scan->n_edges : 1) * sizeof(*sorted));
+	int *row_end = malloc((n_nodes > 0 ? n_nodes : 1) * sizeof(*row_end));
+
+	// Every edge goes after the edges before it with the same source.
+	int start = 0;
+	for (int i = 0; i < n_nodes; i++)
+	{
+		row_end[i] = start;
+		start += scan->out_degree[i];
+	}
+	for (int i = 0; i < scan->n_edges; i++)
+		sorted[row_end[scan->edges[i].src]++] = scan->edges[i];
+
+	start = 0;
+	for (int i = 0; i < n_nodes; i++)
+	{
+		qsort(sorted + start, row_end[i] - start, sizeof(*sorted), compare_edge_dest);
+		start = row_end[i];
+	}
+
+	free(row_end);
+	return sorted;
 }
 
 /**
- * @brief Determine if the string is blank.
- *
- * @param s - string to search.
- * @return true if the line contains only whitespace chars.
- * @return false if the line contains at least one non-whitespace char.
- */
-
-bool line_is_blank(const char *s)
+ * parse_map() - Parses a map file into a graph.
+ * @file: The map file.
+ * 
+ * The file is read in two passes. The first one, map_scan_buffer(), checks the format, finds the
+ * distinct labels and reads the edges as pairs of label ids. Large files are split into chunks
+ * that are scanned by one thread each. The graph is then created with exactly that many nodes and
+ * room for the edges of every node, and the second pass inserts the nodes and edges from the ids,
+ * the edges sorted by sort_edges(). Memory use while loading is linear in the size of the map.
+ * The file is closed.
+ * 
+ * Returns: A pointer to the graph representing the graph, or NULL if the map file is wrong.
+*/
+graph *parse_map(mapfile *file)
 {
-    // Line is blank if it only contained white-space chars.
-    return first_non_white_space(s) < 0;
+	map_scan scan;
+	map_scan_status status = map_scan_buffer(mapfile_data(file), mapfile_size(file), 0, &scan);
+	mapfile_close(file);
+
+	// Checks that the first line that we care about is the amount of edges.
+	if (status == MAP_SCAN_NO_COUNT)
+	{
+		fprintf(stderr, "Wrong format on map file!\n");
+		return NULL;
+	}
+
+	// Checks that every line after it is an edge. Any fields after the labels are ignored.
+	if (status == MAP_SCAN_BAD_LINE)
+	{
+		fprintf(stderr, "Parsing line error, make sure map file is correct!\n");
+		return NULL;
+	}
+
+	// Inserts the nodes in the order of their ids, so the i:th node inserted has the out-degree
+	// out_degree[i] that the graph was sized for.
+	int n_nodes = intern_size(scan.labels);
+	graph *map = graph_empty_sized(n_nodes, scan.out_degree, NULL);
+	node **nodes = malloc((n_nodes > 0 ? n_nodes : 1) * sizeof(*nodes));
+	for (int id = 0; id < n_nodes; id++)
+		nodes[id] = graph_find_or_insert_node(map, intern_string(scan.labels, id),
+						      intern_length(scan.labels, id));
+
+	// Adds the edges in the order of their sources and destinations, so no edge moves another.
+	map_edge *edges = sort_edges(&scan, n_nodes);
+	for (int i = 0; i < scan.n_edges; i++)
+		map = graph_insert_edge(map, nodes[edges[i].src], nodes[edges[i].dest]);
+
+	free(edges);
+	free(nodes);
+	map_scan_free(&scan);
+
+	return map;
 }
 
 /**
- * @brief Determina if the string is a comment line.
- *
- * @param s - string to search.
- * @return true if the line is a comment line.
- * @return false if the line is not a comment line.
- *
- * A comment line has a hash sign '#' as the first non-whitespace char on the line.
- */
-bool line_is_comment(const char *s)
+ * load_map() - Opens a map file and parses it into a graph.
+ * @path: Name of the map file.
+ * 
+ * Returns: A pointer to the graph representing the map, or NULL if the file could not be opened
+ * or is wrong.
+*/
+graph *load_map(const char *path)
 {
-    int i = first_non_white_space(s);
-    return (i >= 0 && s[i] == '#');
+	// Opens and maps the file.
+	mapfile *file = mapfile_open(path);
+
+	// Checks that the file was opened correctly
+	if (file == NULL)
+	{
+		fprintf(stderr, "Invalid file name!\n");
+		return NULL;
+	}
+
+	return parse_map(file);
 }
 
 /**
- * @brief Extract node names from a line from the map file.
- *
- * @param buf - Input buffer.
- * @param n1 - Output buffer for the first node name. Must be at least MAXNODENAME+1 long.
- * @param n2 - Ditto for the second node name.
- * @return int - Returns the number of correctly parsed node names. If the return value is 2, both n1
- * and n2 contain node names. If the return value is less than 2, parsing of at least one node name
- * failed, in which case the content of n1 and n2 are undefined.
- */
-int parse_map_line(const char *buf, char *n1, char *n2)
+ * delta_line_op() - Gets the operation of a line in a map delta.
+ * @l: The scanned line.
+ * 
+ * Returns: '+' or '-' for a route to add or remove, 0 for a blank line or a comment, or -1 if the
+ * line is wrong.
+*/
+int delta_line_op(const map_line *l)
 {
-    // Create a format string the will do the work.
-    char fmt[20];
-    // This will generate the format string " %40s %40s" if MAXNODENAME is 40.
-    snprintf(fmt, sizeof(fmt), " %%%ds %%%ds", MAXNODENAME, MAXNODENAME);
-
-    // sscanf does all the necessary parsing.
-    // Node names must be separated by whitespace.
-    // Whitespace before the first node name is allowed.
-    // Anything after the second node name is ignored.
-    int n = sscanf(buf, fmt, n1, n2);
-
-    // The return value from sscanf contains the number of properly parsed format codes, i.e. the
-    // number of node names.
-    return n;
-}
+	if (l->kind == MAP_LINE_BLANK || l->kind == MAP_LINE_COMMENT)
+		return 0;
 
-// ====== START
+	// An operator and the two labels of the route. Any fields after the labels are ignored.
+	if (l->n_tokens < 3 || l->tokens[0].len != 1 ||
+	    (l->tokens[0].s[0] != '+' && l->tokens[0].s[0] != '-'))
+		return -1;
+
+	return l->tokens[0].s[0];
+}
 
 /**
- * add_edge_to_map() - Adds the nodes to the map then adds the connection between them.
+ * find_token_node() - Finds the node with a label that is a token of a line.
  * @map: A pointer to the graph.
- * @src: A string (label).
- * @dest: A string (label).
+ * @t: The token.
  * 
- * Returns: A pointer to the modified graph
+ * Returns: A pointer to the node, or NULL if there is no node with the label.
 */
-graph *add_edge_to_map(graph *map, char *src, char *dest)
+node *find_token_node(graph *map, map_token t)
 {
-	// Checks if the source node already is in the graph, if it is not we add it.
-	if (graph_find_node(map, src) == NULL)
-		map = graph_insert_node(map, src);
-
-	// Checks if the destination node already is in the graph, if it is not we add it.
-	if (graph_find_node(map, dest) == NULL)
-		map = graph_insert_node(map, dest);
-
-	// Gets the node-structure for each node.
-	node *src_node = graph_find_node(map, src);
-	node *dst_node = graph_find_node(map, dest);
+	// The token is not NUL-terminated, so the label is looked up from a copy.
+	char *label = malloc(t.len + 1);
+	memcpy(label, t.s, t.len);
+	label[t.len] = '\0';
 
-	// Adds the edge to the graph
-	map = graph_insert_edge(map, src_node, dst_node);
+	node *n = graph_find_node(map, label);
+	free(label);
 
-	// Returns the modified graph.
-	return map;
+	return n;
 }
 
 /**
- * parse_map() - Reads the file and parses it into a graph.
- * @file: A pointer to the map-file.
+ * apply_delta() - Applies a map delta to the graph.
+ * @map: A pointer to the graph.
+ * @data: The lines of the delta, need not be NUL-terminated.
+ * @size: Number of bytes in data.
  * 
- * Returns: A pointer to the graph representing the graph.
+ * Every line of a delta changes one route, "+ UME BMA" adds the route from UME to BMA and
+ * "- LLA PJA" removes the route from LLA to PJA. Blank lines and comments are allowed as in a map
+ * file. All lines are checked before the graph is changed, so a delta with a wrong line changes
+ * nothing. The nodes of an added route are inserted if they are new, and removing a route that is
+ * not in the map does nothing. Only the nodes and edges named by the delta are looked up, so the
+ * cost depends on the size of the delta and not on the size of the map.
+ * 
+ * Returns: A boolean for whether the delta was applied.
 */
-graph *parse_map(FILE *file)
+bool apply_delta(graph *map, const char *data, size_t size)
 {
-	graph *map;
-	int parsed = 0;
-	char buffer[BUFSIZE];
+	map_lexer lx;
+	map_line l;
 
-	while (fgets(buffer, 60, file) != NULL)
+	// Checks every line first.
+	map_lexer_init(&lx, data, size);
+	while (map_lexer_next(&lx, &l))
 	{
-		// Skips the line if it is a comment or blank.
-		if (!line_is_blank(buffer) && !line_is_comment(buffer))
+		if (delta_line_op(&l) == -1)
 		{
-			if (parsed == 0)
-			{
-				int max_edges;
-				
-				// Checks if the first line that we care about is a integer to represent the amount of edges
-				// the graph has. If it is not, we close the file and exit the program.
-				if (sscanf(&buffer[first_non_white_space(buffer)], "%d", &max_edges) != 1)
-				{
-					fprintf(stderr, "Wrong format on map file!\n");
-					fclose(file);
-					exit(EXIT_FAILURE);
-				}
+			fprintf(stderr, "Parsing line error, make sure delta is correct!\n");
+			return false;
+		}
+	}
 
-				// Makes the max amount of nodes that we can store twice the amount of edges,
-				// since the graph could just be pairs of nodes where one node goes to just one other node 
-				// that does not go anywhere.
-				map = graph_empty(max_edges * 2);
-				
-				parsed += 1;
-			}
-			else
-			{
-				// Makes space to store the source- & destination node labels.
-				char src[MAXNODENAME];
-				char dst[MAXNODENAME];
-				
-				// Checks if parsing the input line was correct.
-				if (parse_map_line(buffer, src, dst) != 2)
-				{
-					fprintf(stderr, "Parsing line error, make sure map file is correct!\n");
-					exit(EXIT_FAILURE);
-				}
+	int added = 0;
+	int removed = 0;
 
-				// Adds the edge to the map.
-				map = add_edge_to_map(map, src, dst);
-			}
+	// Applies the lines in order, so a route added and removed by the same delta is removed.
+	map_lexer_init(&lx, data, size);
+	while (map_lexer_next(&lx, &l))
+	{
+		int op = delta_line_op(&l);
+		if (op == '+')
+		{
+			node *src_node = graph_find_or_insert_node(map, l.tokens[1].s, l.tokens[1].len);
+			node *dest_node = graph_find_or_insert_node(map, l.tokens[2].s, l.tokens[2].len);
+			map = graph_insert_edge(map, src_node, dest_node);
+			added += 1;
+		}
+		else if (op == '-')
+		{
+			// A route between nodes that are not in the map is not in the map either.
+			node *src_node = find_token_node(map, l.tokens[1]);
+			node *dest_node = find_token_node(map, l.tokens[2]);
+			if (src_node != NULL && dest_node != NULL)
+				map = graph_delete_edge(map, src_node, dest_node);
+			removed += 1;
 		}
 	}
 
-	fclose(file);
+	printf("Applied delta, %d routes added and %d removed.\n", added, removed);
 
-	return map;
+	return true;
 }
 
 /**
- * find_path() - Searches for if there is a way to get from source node to destination node.
+ * apply_delta_file() - Applies a map delta file to the graph.
+ * @map: A pointer to the graph.
+ * @path: Name of the delta file.
+*/
+void apply_delta_file(graph *map, const char *path)
+{
+	mapfile *file = mapfile_open(path);
+	if (file == NULL)
+	{
+		fprintf(stderr, "Invalid file name!\n");
+		return;
+	}
+
+	apply_delta(map, mapfile_data(file), mapfile_size(file));
+	mapfile_close(file);
+}
+
+/**
+ * export_map_file() - Exports the map, or the edges from a range of its nodes, to a file.
+ * @map: A pointer to the graph.
+ * @input: The command, ":export <format> <file>" optionally followed by the first node index and
+ * the index after the last node.
+*/
+void export_map_file(const graph *map, const char *input)
+{
+	char format_name[MAXNODENAME + 1];
+	char path[BUFSIZE];
+	int first = 0;
+	int last = graph_node_count(map);
+	graph_export_format format;
+
+	// The file name may be longer than a label.
+	int parsed = sscanf(input, "%*s %40s %399s %d %d", format_name, path, &first, &last);
+	if ((parsed != 2 && parsed != 4) || !graph_export_format_from_name(format_name, &format))
+	{
+		fprintf(stderr, "Invalid input..\n");
+		return;
+	}
+
+	if (graph_export_file(map, format, first, last, path) != 0)
+		fprintf(stderr, "Could not write %s: %s\n", path, strerror(errno));
+	else
+		printf("Exported the map to %s.\n", path);
+}
+
+// What the breadth first search needs to queue a neighbour of the node it expands.
+typedef struct search_frontier
+{
+	graph *g;
+	queue_nodeptr *queue;
+	int queued; // Nodes queued for the next level.
+} search_frontier;
+
+/**
+ * visit_neighbour() - Queues a neighbour of the expanded node if it has not been seen, a
+ * graph_neighbour_callback.
+ * @n: The neighbour.
+ * @arg: The search_frontier of the search.
+*/
+void visit_neighbour(const node *n, void *arg)
+{
+	search_frontier *frontier = arg;
+	// The neighbour is a node of the graph being searched, so its seen status may be changed.
+	node *neighbor_node = (node *)n;
+
+	// If the node is not previously seen, we add it to the process queue and mark it as seen.
+	if (!graph_node_is_seen(frontier->g, neighbor_node))
+	{
+		frontier->g = graph_node_set_seen(frontier->g, neighbor_node, true);
+		queue_nodeptr_enqueue(frontier->queue, neighbor_node);
+		frontier->queued += 1;
+	}
+}
+
+/**
+ * find_path_within() - Searches for a path from source node to destination node that uses at most
+ * a given number of legs (edges).
  * @g: A pointer to the graph.
  * @src: A pointer to the source node.
  * @dest: A pointer to the destination node.
+ * @max_legs: The maximum number of legs the path may use, or NO_LEG_LIMIT.
  * 
- * Returns: A boolean for whether there is a path that exists.
+ * The search is a level-bounded breadth first search. Instead of storing a depth for every queued
+ * node the levels are tracked by frontier boundaries: we count how many nodes are left of the level
+ * that is being processed and how many have been queued for the next one. Nodes on the last allowed
+ * level are checked but never expanded, so the search stops as soon as the bound is reached. The
+ * neighbours of a node are walked in place by graph_for_each_neighbour(), so no list is allocated
+ * for every node that is expanded.
+ * 
+ * Returns: A boolean for whether there is a path that exists within the bound.
 */
-bool find_path(graph *g, node *src, node *dest)
+bool find_path_within(graph *g, node *src, node *dest, int max_legs)
 {
 	// Reset the seen status of the nodes in the map.
 	graph_reset_seen(g);
 
 	// Sets the startnode as seen and adds it to the processing queue.
-	// Queue does not get a free_func since we do not want to free the nodes.
+	// The queue stores the node pointers themselves and does not free the nodes.
 	g = graph_node_set_seen(g, src, true);
-	queue *nodes_to_process = queue_enqueue(queue_empty(NULL), src);
+	queue_nodeptr *nodes_to_process = queue_nodeptr_empty();
+	queue_nodeptr_enqueue(nodes_to_process, src);
+	search_frontier frontier = { g, nodes_to_process, 0 };
+
+	// Frontier bookkeeping. The start node is the only node on level 0.
+	int legs = 0;
+	int left_on_level = 1;
 
 	// This loop ensures that all nodes that need to be processed gets processed.
-	while (!queue_is_empty(nodes_to_process))
+	while (!queue_nodeptr_is_empty(nodes_to_process))
 	{
 		// Gets the node that we will look at this iteration.
-		node *node_now_process = queue_front(nodes_to_process);
-		nodes_to_process = queue_dequeue(nodes_to_process);
+		node *node_now_process = queue_nodeptr_dequeue(nodes_to_process);
+		left_on_level -= 1;
 
 		// This checks if the node is the one that we are looking for.
 		if (nodes_are_equal(dest, node_now_process))
 		{
 			// Kills the queue since we found our node.
-			queue_kill(nodes_to_process);
+			queue_nodeptr_kill(nodes_to_process);
 			return true;
 		}
 
-		// Get all of the neighboring nodes.
-		dlist *node_neighbors = graph_neighbours(g, node_now_process);
+		// Only expand the node if its neighbors are still within the leg limit.
+		if (max_legs == NO_LEG_LIMIT || legs < max_legs)
+			graph_for_each_neighbour(g, node_now_process, visit_neighbour, &frontier);
 
-		while (!dlist_is_empty(node_neighbors))
+		// The whole level has been processed, the queue now holds exactly the next level.
+		if (left_on_level == 0)
 		{
-			// Get the first neighbor in the list
-			node *now_first_neighbor_node = dlist_inspect(node_neighbors, dlist_first(node_neighbors));
-
-			// If the node is not previously seen, we add it to the process queue and mark it as seen.
-			if (!graph_node_is_seen(g, now_first_neighbor_node))
-			{
-				g = graph_node_set_seen(g, now_first_neighbor_node, true);
-				nodes_to_process = queue_enqueue(nodes_to_process, now_first_neighbor_node);
-			}
-			
-			// Remove the neighbor from the queue.
-			dlist_remove(node_neighbors, dlist_first(node_neighbors));
+			legs += 1;
+			left_on_level = frontier.queued;
+			frontier.queued = 0;
 		}
-
-		// Kills the list to not cause memory leaks.
-		dlist_kill(node_neighbors);
 	}
 	
 	// Kills the queue since we are now done.
-	queue_kill(nodes_to_process);
+	queue_nodeptr_kill(nodes_to_process);
 
 	// Node was not found.
 	return false;
 }
 
+/**
+ * find_path() - Searches for if there is a way to get from source node to destination node.
+ * @g: A pointer to the graph.
+ * @src: A pointer to the source node.
+ * @dest: A pointer to the destination node.
+ * 
+ * Returns: A boolean for whether there is a path that exists.
+*/
+bool find_path(graph *g, node *src, node *dest)
+{
+	return find_path_within(g, src, dest, NO_LEG_LIMIT);
+}
+
+/**
+ * print_search_result() - Prints the answer to a search.
+ * @buf1: Label of the origin node.
+ * @buf2: Label of the destination node.
+ * @max_legs: The maximum number of legs of the path, or NO_LEG_LIMIT.
+ * @found: Whether a path was found.
+*/
+void print_search_result(const char *buf1, const char *buf2, int max_legs, bool found)
+{
+	if (max_legs == NO_LEG_LIMIT)
+	{
+		if (found)
+			printf("There is a path from %s to %s.\n", buf1, buf2);
+		else
+			printf("There is no path from %s to %s.\n", buf1, buf2);
+	}
+	else
+	{
+		if (found)
+			printf("There is a path from %s to %s within %d legs.\n", buf1, buf2, max_legs);
+		else
+			printf("There is no path from %s to %s within %d legs.\n", buf1, buf2, max_legs);
+	}
+}
+
 /**
  * check_nodes_search() - Checks all node input from the program.
  * @map: A pointer to the map graph.
- * @src: A string
+ * @buf1: Label of the origin node.
+ * @buf2: Label of the destination node.
+ * @max_legs: The maximum number of legs of the path, or NO_LEG_LIMIT.
 */
-void check_nodes_search(graph *map, char *buf1, char *buf2)
+void check_nodes_search(graph *map, char *buf1, char *buf2, int max_legs)
 {
 	// Fetches the nodes if they exist
 	node *src_node = graph_find_node(map, buf1);
@@ -291,11 +520,176 @@ void check_nodes_search(graph *map, char *buf1, char *buf2)
 	}
 	
 	// Look for a way between the nodes, if it exist we say that and if it does not we say that.
-	if (find_path(map, src_node, dest_node))
-		printf("There is a path from %s to %s.\n", buf1, buf2);
+	print_search_result(buf1, buf2, max_legs, find_path_within(map, src_node, dest_node, max_legs));
+}
+
+/**
+ * image_find_path_within() - Searches a map image for a path from source node to destination
+ * node that uses at most a given number of legs (edges).
+ * @img: A pointer to the map image.
+ * @src: Id of the source node.
+ * @dest: Id of the destination node.
+ * @max_legs: The maximum number of legs the path may use, or NO_LEG_LIMIT.
+ * 
+ * The same level-bounded breadth first search as find_path_within(), on the node ids and CSR
+ * edges of the image. The image is read-only, so the seen status is kept in an array of its own.
+ * 
+ * Returns: A boolean for whether there is a path that exists within the bound.
+*/
+bool image_find_path_within(const map_image *img, int src, int dest, int max_legs)
+{
+	int n_nodes = map_image_n_nodes(img);
+	bool *seen = calloc(n_nodes, sizeof(bool));
+	queue_u32 *ids_to_process = queue_u32_empty();
+	bool found = false;
+
+	// Sets the startnode as seen and adds it to the processing queue.
+	seen[src] = true;
+	queue_u32_enqueue(ids_to_process, src);
+
+	// Frontier bookkeeping. The start node is the only node on level 0.
+	int legs = 0;
+	int left_on_level = 1;
+	int queued_on_next_level = 0;
+
+	while (!found && !queue_u32_is_empty(ids_to_process))
+	{
+		int id = queue_u32_dequeue(ids_to_process);
+		left_on_level -= 1;
+
+		// This checks if the node is the one that we are looking for.
+		found = (id == dest);
+
+		// Only expand the node if its neighbors are still within the leg limit.
+		if (!found && (max_legs == NO_LEG_LIMIT || legs < max_legs))
+		{
+			int n_neighbors;
+			const uint32_t *neighbors = map_image_neighbours(img, id, &n_neighbors);
+			for (int i = 0; i < n_neighbors; i++)
+			{
+				// Ids outside the image can only come from a damaged image and are skipped.
+				uint32_t neighbor = neighbors[i];
+				if (neighbor < (uint32_t)n_nodes && !seen[neighbor])
+				{
+					seen[neighbor] = true;
+					queue_u32_enqueue(ids_to_process, neighbor);
+					queued_on_next_level += 1;
+				}
+			}
+		}
+
+		// The whole level has been processed, the queue now holds exactly the next level.
+		if (left_on_level == 0)
+		{
+			legs += 1;
+			left_on_level = queued_on_next_level;
+			queued_on_next_level = 0;
+		}
+	}
+
+	queue_u32_kill(ids_to_process);
+	free(seen);
+
+	return found;
+}
+
+/**
+ * check_image_search() - Checks all node input from the program against a map image.
+ * @img: A pointer to the map image.
+ * @buf1: Label of the origin node.
+ * @buf2: Label of the destination node.
+ * @max_legs: The maximum number of legs of the path, or NO_LEG_LIMIT.
+*/
+void check_image_search(const map_image *img, char *buf1, char *buf2, int max_legs)
+{
+	// Looks the labels up in the hash index of the image.
+	int src_id = map_image_find(img, buf1);
+	int dest_id = map_image_find(img, buf2);
+
+	if (src_id == -1)
+	{
+		fprintf(stderr, "Could not find node %s\n", buf1);
+		return;
+	}
+
+	if (dest_id == -1)
+	{
+		fprintf(stderr, "Could not find node %s\n", buf2);
+		return;
+	}
+
+	print_search_result(buf1, buf2, max_legs, image_find_path_within(img, src_id, dest_id, max_legs));
+}
+
+/**
+ * check_stream_search() - Checks all node input from the program against the part of a map that
+ * has been loaded so far.
+ * @stream: A pointer to the map loader.
+ * @buf1: Label of the origin node.
+ * @buf2: Label of the destination node.
+ * @max_legs: The maximum number of legs of the path, or NO_LEG_LIMIT.
+ * 
+ * The loader waits while the search runs, so the search sees the same edges from start to end.
+ * 
+ * Returns: False if the loader stopped at an error in the map file, otherwise true.
+*/
+bool check_stream_search(map_stream *stream, char *buf1, char *buf2, int max_legs)
+{
+	map_stream_view view;
+	map_stream_acquire(stream, &view);
+
+	if (view.status == MAP_SCAN_NO_COUNT)
+		fprintf(stderr, "Wrong format on map file!\n");
+	else if (view.status == MAP_SCAN_BAD_LINE)
+		fprintf(stderr, "Parsing line error, make sure map file is correct!\n");
+	else if (view.g == NULL) // Not even the count line has been loaded yet.
+		fprintf(stderr, "Could not find node %s\n", buf1);
 	else
-		printf("There is no path from %s to %s.\n", buf1, buf2);
+		check_nodes_search(view.g, buf1, buf2, max_legs);
+
+	if (view.status == MAP_SCAN_OK && view.loading)
+		fprintf(stderr, "(Searched the first %d edges, the map is still loading.)\n", view.n_edges);
+
+	map_stream_release(stream);
+
+	return view.status == MAP_SCAN_OK;
+}
+
+/**
+ * check_watch_search() - Checks all node input from the program against the current version of a
+ * watched map.
+ * @watch: A pointer to the watched map.
+ * @buf1: Label of the origin node.
+ * @buf2: Label of the destination node.
+ * @max_legs: The maximum number of legs of the path, or NO_LEG_LIMIT.
+ * 
+ * The search holds a reference to the graph, so a reload that finishes meanwhile does not kill it.
+ * The next search gets the new graph.
+*/
+void check_watch_search(map_watch *watch, char *buf1, char *buf2, int max_legs)
+{
+	graph *map = map_watch_acquire(watch);
+	check_nodes_search(map, buf1, buf2, max_legs);
+	map_watch_release(watch, map);
+}
 
+/**
+ * kill_map() - Releases the map, whichever way it was loaded.
+ * @map: A pointer to the graph, or NULL.
+ * @img: A pointer to the map image, or NULL.
+ * @stream: A pointer to the map loader, or NULL.
+ * @watch: A pointer to the watched map, or NULL.
+*/
+void kill_map(graph *map, map_image *img, map_stream *stream, map_watch *watch)
+{
+	if (map != NULL)
+		graph_kill(map);
+	if (img != NULL)
+		map_image_close(img);
+	if (stream != NULL)
+		map_stream_stop(stream);
+	if (watch != NULL)
+		map_watch_stop(watch);
 }
 
 int main(int argc, char const *argv[])
@@ -303,25 +697,62 @@ int main(int argc, char const *argv[])
 	// Loop handler variable
 	bool quit = false;
 
+	// "--image <image file>" loads a map compiled by map_compile instead of a map file.
+	bool use_image = argc == 3 && strcmp(argv[1], "--image") == 0;
+
+	// "--stream <map file>" answers queries while a loader thread reads the map file.
+	bool use_stream = argc == 3 && strcmp(argv[1], "--stream") == 0;
+
+	// "--watch <map file>" loads the map file again whenever it changes.
+	bool use_watch = argc == 3 && strcmp(argv[1], "--watch") == 0;
+
 	// Makes sure that the correct amount of arguments were given 
-	if (argc < 2 || argc > 2)
+	if (argc != 2 && !use_image && !use_stream && !use_watch)
 	{
 		fprintf(stderr, "Expected one argument to map file...\n");
 		exit(EXIT_FAILURE);
 	}
-	
-	// Opens the file.
-	FILE *file = fopen(argv[1], "r");
-	
-	// Checks that the file was opened correctly
-	if (file == NULL) 
+
+	// Exactly one of map, img, stream and watch is used.
+	graph *map = NULL;
+	map_image *img = NULL;
+	map_stream *stream = NULL;
+	map_watch *watch = NULL;
+
+	if (use_image)
 	{
-		fprintf(stderr, "Invalid file name!\n");
-		return EXIT_FAILURE;
+		// Maps the image, nothing is parsed.
+		img = map_image_open(argv[2]);
+		if (img == NULL)
+		{
+			fprintf(stderr, errno == EINVAL ? "Wrong format on map image!\n" : "Invalid file name!\n");
+			return EXIT_FAILURE;
+		}
+	}
+	else if (use_stream)
+	{
+		// Starts the loader, the first queries are answered as soon as it has read a few lines.
+		stream = map_stream_start(argv[2]);
+		if (stream == NULL)
+		{
+			fprintf(stderr, "Invalid file name!\n");
+			return EXIT_FAILURE;
+		}
+	}
+	else if (use_watch)
+	{
+		// Loads the map, then a watcher thread loads it again whenever the file changes.
+		watch = map_watch_start(argv[2], load_map);
+		if (watch == NULL)
+			return EXIT_FAILURE;
+	}
+	else
+	{
+		// Opens and parses the file.
+		map = load_map(argv[1]);
+		if (map == NULL)
+			return EXIT_FAILURE;
 	}
-
-	// Parses the file
-	graph *map = parse_map(file);
 
 	// Stores the input for the program
 	char input_buffer[BUFSIZE];
@@ -338,18 +769,19 @@ int main(int argc, char const *argv[])
 			return EXIT_FAILURE;
 		}
 		
-		// Makes space for the labels
-		char src_lbl[MAXNODENAME];
-		char dest_lbl[MAXNODENAME];
+		// Makes space for the labels, %40s stores up to 40 chars plus the terminator.
+		char src_lbl[MAXNODENAME + 1];
+		char dest_lbl[MAXNODENAME + 1];
+		int max_legs = NO_LEG_LIMIT;
 
-		// Parses the input
-		int parsed = sscanf(input_buffer, "%40s %40s", src_lbl, dest_lbl);
+		// Parses the input, an optional third number bounds the number of legs.
+		int parsed = sscanf(input_buffer, "%40s %40s %d", src_lbl, dest_lbl, &max_legs);
 
 		// Checks if the parsing failed
 		if (parsed == EOF)
 		{
 			fprintf(stderr, "Error parsing input!\n");
-			graph_kill(map); 	// Releases the resources used by the map
+			kill_map(map, img, stream, watch); 	// Releases the resources used by the map
 			return EXIT_FAILURE;
 		}
 		
@@ -359,9 +791,57 @@ int main(int argc, char const *argv[])
 			printf("Normal exit.\n");
 			quit = true;
 		}
-		else if (parsed == 2) // The user entered two strings/labels
+		else if (parsed >= 2 && strcmp(src_lbl, ":export") == 0)
+		{
+			// A watched map is exported as it is when the export starts.
+			if (watch != NULL)
+			{
+				graph *current = map_watch_acquire(watch);
+				export_map_file(current, input_buffer);
+				map_watch_release(watch, current);
+			}
+			else if (map != NULL)
+				export_map_file(map, input_buffer);
+			else
+				fprintf(stderr, "Only a map loaded from a map file can be exported!\n");
+		}
+		else if (parsed >= 2 && (strcmp(src_lbl, ":+") == 0 || strcmp(src_lbl, ":-") == 0 ||
+					 strcmp(src_lbl, ":delta") == 0))
 		{
-			check_nodes_search(map, src_lbl, dest_lbl);
+			// Only a graph loaded from a map file can be changed.
+			if (map == NULL)
+				fprintf(stderr, "Routes can only be changed in a map loaded from a map file!\n");
+			else if (strcmp(src_lbl, ":delta") == 0)
+			{
+				// The file name may be longer than a label.
+				char delta_path[BUFSIZE];
+				sscanf(input_buffer, "%*s %399s", delta_path);
+				apply_delta_file(map, delta_path);
+			}
+			else
+			{
+				// The rest of the line, from the '+' or '-', is a line of a delta.
+				const char *line = strchr(input_buffer, ':') + 1;
+				apply_delta(map, line, strlen(line));
+			}
+		}
+		else if (parsed == 2 || (parsed == 3 && max_legs >= 0)) // Two labels and maybe a leg limit
+		{
+			if (img != NULL)
+				check_image_search(img, src_lbl, dest_lbl, max_legs);
+			else if (stream != NULL)
+			{
+				// The map file is wrong, as when it is parsed before the queries.
+				if (!check_stream_search(stream, src_lbl, dest_lbl, max_legs))
+				{
+					kill_map(map, img, stream, watch);
+					return EXIT_FAILURE;
+				}
+			}
+			else if (watch != NULL)
+				check_watch_search(watch, src_lbl, dest_lbl, max_legs);
+			else
+				check_nodes_search(map, src_lbl, dest_lbl, max_legs);
 		}
 		else // The user entered something else/extra
 		{
@@ -370,7 +850,7 @@ int main(int argc, char const *argv[])
 	} while (!quit);
 	
 	// Releases the resources used by the map.
-	graph_kill(map);
+	kill_map(map, img, stream, watch);
 	
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,466 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <allocator.h>
+
+/*
+ * Implementation of the default, arena and counting allocators.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Alignment of all memory handed out, enough for any basic type.
+#define ALLOC_ALIGN 16
+
+// Round a size up to a multiple of ALLOC_ALIGN.
+#define ALIGN_UP(n) (((n) + ALLOC_ALIGN - 1) / ALLOC_ALIGN * ALLOC_ALIGN)
+
+// Size of the first arena chunk and of the largest chunks.
+#define ARENA_FIRST_CHUNK 65536
+#define ARENA_MAX_CHUNK (16 * 1024 * 1024)
+
+/*
+ * The arena carves memory out of chunks, newest chunk first. The chunks
+ * double in size up to a limit. A block larger than a quarter of the
+ * chunk size gets a chunk of its own, placed after the newest chunk so
+ * that the newest chunk keeps its free space. Realloc of the most
+ * recent block grows it in place when it fits.
+ */
+struct arena_chunk {
+	struct arena_chunk *next;
+	size_t size; // Usable bytes after the header.
+	size_t used; // Bytes handed out.
+};
+
+// Header size, keeping the blocks aligned.
+#define CHUNK_HEADER ALIGN_UP(sizeof(struct arena_chunk))
+
+struct arena {
+	allocator alloc;
+	struct arena_chunk *chunks; // Newest chunk first.
+	size_t next_chunk_size; // Size of the next regular chunk.
+	void *last; // Most recently handed out block, or NULL.
+	size_t bytes; // Bytes handed out.
+};
+
+/*
+ * The counting allocator puts a header with the size in front of every
+ * block, so that free knows how many bytes are returned.
+ */
+struct alloc_counter {
+	allocator alloc;
+	const allocator *parent;
+	size_t allocs;
+	size_t frees;
+	size_t bytes;
+	size_t peak_bytes;
+};
+
+#define COUNTER_HEADER ALIGN_UP(sizeof(size_t))
+
+// ===========DEFAULT ALLOCATOR============
+
+static void *default_alloc(void *ctx, size_t size)
+{
+	(void)ctx;
+	return malloc(size);
+}
+
+static void *default_realloc(void *ctx, void *p, size_t old_size, size_t new_size)
+{
+	(void)ctx;
+	(void)old_size;
+	return realloc(p, new_size);
+}
+
+static void default_free(void *ctx, void *p)
+{
+	(void)ctx;
+	free(p);
+}
+
+static const allocator default_allocator={
+	default_alloc, default_realloc, default_free, NULL
+};
+
+/**
+ * allocator_default() - Return the default allocator.
+ *
+ * Returns: An allocator that uses malloc(), realloc() and free().
+ */
+const allocator *allocator_default(void)
+{
+	return &default_allocator;
+}
+
+/**
+ * allocator_alloc() - Allocate memory.
+ * @a: Allocator to use, or NULL for the default allocator.
+ * @size: Number of bytes.
+ *
+ * Returns: A pointer to the memory, or NULL if not enough memory was
+ *	    available.
+ */
+void *allocator_alloc(const allocator *a, size_t size)
+{
+	if (a == NULL) {
+		return malloc(size);
+	}
+	return a->alloc(a->ctx, size);
+}
+
+/**
+ * allocator_calloc() - Allocate cleared memory.
+ * @a: Allocator to use, or NULL for the default allocator.
+ * @n: Number of elements.
+ * @size: Size of every element.
+ *
+ * Returns: A pointer to the memory, or NULL if not enough memory was
+ *	    available.
+ */
+void *allocator_calloc(const allocator *a, size_t n, size_t size)
+{
+	if (a == NULL) {
+		return calloc(n, size);
+	}
+	if (size != 0 && n > (size_t)-1 / size) {
+		return NULL;
+	}
+	void *p=a->alloc(a->ctx, n * size);
+	if (p != NULL) {
+		memset(p, 0, n * size);
+	}
+	return p;
+}
+
+/**
+ * allocator_realloc() - Change the size of allocated memory.
+ * @a: Allocator the memory was allocated with, or NULL for the default
+ *     allocator.
+ * @p: Memory to resize, or NULL.
+ * @old_size: Current size of the memory in bytes, 0 if p is NULL.
+ * @new_size: New size in bytes.
+ *
+ * Returns: A pointer to the resized memory, or NULL if not enough
+ *	    memory was available, in which case p is left unchanged.
+ */
+void *allocator_realloc(const allocator *a, void *p, size_t old_size, size_t new_size)
+{
+	if (a == NULL) {
+		return realloc(p, new_size);
+	}
+	return a->realloc(a->ctx, p, old_size, new_size);
+}
+
+/**
+ * allocator_free() - Return allocated memory.
+ * @a: Allocator the memory was allocated with, or NULL for the default
+ *     allocator.
+ * @p: Memory to return, or NULL.
+ *
+ * Returns: Nothing.
+ */
+void allocator_free(const allocator *a, void *p)
+{
+	if (a == NULL) {
+		free(p);
+		return;
+	}
+	a->free(a->ctx, p);
+}
+
+// ===========ARENA============
+
+/**
+ * arena_new_chunk() - Internal function to allocate a chunk.
+ * @ar: Arena to manipulate.
+ * @size: Number of bytes the chunk must hold.
+ *
+ * Returns: The new chunk, or NULL if not enough memory was available.
+ */
+static struct arena_chunk *arena_new_chunk(arena *ar, size_t size)
+{
+	bool own_chunk=size > ar->next_chunk_size / 4;
+	size_t chunk_size=own_chunk ? size : ar->next_chunk_size;
+
+	struct arena_chunk *c=malloc(CHUNK_HEADER + chunk_size);
+	if (c == NULL) {
+		return NULL;
+	}
+	c->size=chunk_size;
+	c->used=0;
+
+	if (own_chunk && ar->chunks != NULL) {
+		// Keep the newest regular chunk first.
+		c->next=ar->chunks->next;
+		ar->chunks->next=c;
+	} else {
+		c->next=ar->chunks;
+		ar->chunks=c;
+		if (ar->next_chunk_size < ARENA_MAX_CHUNK) {
+			ar->next_chunk_size*=2;
+		}
+	}
+	return c;
+}
+
+static void *arena_alloc(void *ctx, size_t size)
+{
+	arena *ar=ctx;
+	size=ALIGN_UP(size > 0 ? size : 1);
+
+	struct arena_chunk *c=ar->chunks;
+	if (c == NULL || c->size - c->used < size) {
+		c=arena_new_chunk(ar, size);
+		if (c == NULL) {
+			return NULL;
+		}
+	}
+	void *p=(char *)c + CHUNK_HEADER + c->used;
+	c->used+=size;
+	ar->bytes+=size;
+	ar->last=p;
+	return p;
+}
+
+static void *arena_realloc(void *ctx, void *p, size_t old_size, size_t new_size)
+{
+	arena *ar=ctx;
+
+	// Grow or shrink the most recent block in place if possible.
+	struct arena_chunk *c=ar->chunks;
+	if (p != NULL && p == ar->last && c != NULL
+	    && (char *)p >= (char *)c + CHUNK_HEADER
+	    && (char *)p < (char *)c + CHUNK_HEADER + c->size) {
+		size_t offset=(char *)p - ((char *)c + CHUNK_HEADER);
+		size_t size=ALIGN_UP(new_size > 0 ? new_size : 1);
+		if (offset + size <= c->size) {
+			ar->bytes+=offset + size - c->used;
+			c->used=offset + size;
+			return p;
+		}
+	}
+
+	void *q=arena_alloc(ctx, new_size);
+	if (q != NULL && p != NULL) {
+		memcpy(q, p, old_size < new_size ? old_size : new_size);
+	}
+	return q;
+}
+
+static void arena_free(void *ctx, void *p)
+{
+	// The memory is returned by arena_kill().
+	(void)ctx;
+	(void)p;
+}
+
+/**
+ * arena_create() - Create an empty arena.
+ *
+ * Returns: A pointer to the new arena.
+ */
+arena *arena_create(void)
+{
+	arena *ar=calloc(1, sizeof(*ar));
+	ar->alloc.alloc=arena_alloc;
+	ar->alloc.realloc=arena_realloc;
+	ar->alloc.free=arena_free;
+	ar->alloc.ctx=ar;
+	ar->next_chunk_size=ARENA_FIRST_CHUNK;
+	return ar;
+}
+
+/**
+ * arena_allocator() - Return the allocator of an arena.
+ * @ar: Arena to allocate from.
+ *
+ * Returns: An allocator that is valid as long as the arena.
+ */
+const allocator *arena_allocator(arena *ar)
+{
+	return &ar->alloc;
+}
+
+/**
+ * arena_bytes() - Return the number of bytes handed out by an arena.
+ * @ar: Arena to inspect.
+ *
+ * Returns: The number of bytes handed out, including alignment padding.
+ */
+size_t arena_bytes(const arena *ar)
+{
+	return ar->bytes;
+}
+
+/**
+ * arena_kill() - Destroy an arena.
+ * @ar: Arena to destroy.
+ *
+ * Returns all memory handed out by the arena at once.
+ *
+ * Returns: Nothing.
+ */
+void arena_kill(arena *ar)
+{
+	struct arena_chunk *c=ar->chunks;
+	while (c != NULL) {
+		struct arena_chunk *next=c->next;
+		free(c);
+		c=next;
+	}
+	free(ar);
+}
+
+// ===========COUNTING ALLOCATOR============
+
+/**
+ * counter_add() - Internal function to count bytes taken into use.
+ * @c: Counter to update.
+ * @size: Number of bytes.
+ *
+ * Returns: Nothing.
+ */
+static void counter_add(alloc_counter *c, size_t size)
+{
+	c->allocs++;
+	c->bytes+=size;
+	if (c->bytes > c->peak_bytes) {
+		c->peak_bytes=c->bytes;
+	}
+}
+
+static void *counter_alloc(void *ctx, size_t size)
+{
+	alloc_counter *c=ctx;
+	char *p=allocator_alloc(c->parent, COUNTER_HEADER + size);
+	if (p == NULL) {
+		return NULL;
+	}
+	*(size_t *)p=size;
+	counter_add(c, size);
+	return p + COUNTER_HEADER;
+}
+
+static void *counter_realloc(void *ctx, void *p, size_t old_size, size_t new_size)
+{
+	alloc_counter *c=ctx;
+	if (p == NULL) {
+		return counter_alloc(ctx, new_size);
+	}
+	char *block=(char *)p - COUNTER_HEADER;
+	size_t size=*(size_t *)block;
+	(void)old_size;
+
+	char *q=allocator_realloc(c->parent, block, COUNTER_HEADER + size, COUNTER_HEADER + new_size);
+	if (q == NULL) {
+		return NULL;
+	}
+	*(size_t *)q=new_size;
+	c->bytes-=size;
+	counter_add(c, new_size);
+	return q + COUNTER_HEADER;
+}
+
+static void counter_free(void *ctx, void *p)
+{
+	alloc_counter *c=ctx;
+	if (p == NULL) {
+		return;
+	}
+	char *block=(char *)p - COUNTER_HEADER;
+	c->bytes-=*(size_t *)block;
+	c->frees++;
+	allocator_free(c->parent, block);
+}
+
+/**
+ * alloc_counter_create() - Create a counting allocator.
+ * @parent: Allocator to pass the calls on to, or NULL for the default
+ *	    allocator.
+ *
+ * Returns: A pointer to the new counting allocator.
+ */
+alloc_counter *alloc_counter_create(const allocator *parent)
+{
+	alloc_counter *c=calloc(1, sizeof(*c));
+	c->alloc.alloc=counter_alloc;
+	c->alloc.realloc=counter_realloc;
+	c->alloc.free=counter_free;
+	c->alloc.ctx=c;
+	c->parent=parent;
+	return c;
+}
+
+/**
+ * alloc_counter_allocator() - Return the allocator of a counter.
+ * @c: Counter to count the calls in.
+ *
+ * Returns: An allocator that is valid as long as the counter.
+ */
+const allocator *alloc_counter_allocator(alloc_counter *c)
+{
+	return &c->alloc;
+}
+
+/**
+ * alloc_counter_allocs() - Return the number of allocations.
+ * @c: Counter to inspect.
+ *
+ * Returns: The number of alloc and realloc calls that returned memory.
+ */
+size_t alloc_counter_allocs(const alloc_counter *c)
+{
+	return c->allocs;
+}
+
+/**
+ * alloc_counter_frees() - Return the number of free calls.
+ * @c: Counter to inspect.
+ *
+ * Returns: The number of free calls with memory other than NULL.
+ */
+size_t alloc_counter_frees(const alloc_counter *c)
+{
+	return c->frees;
+}
+
+/**
+ * alloc_counter_bytes() - Return the number of bytes in use.
+ * @c: Counter to inspect.
+ *
+ * Returns: The number of bytes allocated and not yet freed.
+ */
+size_t alloc_counter_bytes(const alloc_counter *c)
+{
+	return c->bytes;
+}
+
+/**
+ * alloc_counter_peak_bytes() - Return the largest number of bytes in use.
+ * @c: Counter to inspect.
+ *
+ * Returns: The largest number of bytes in use at any time.
+ */
+size_t alloc_counter_peak_bytes(const alloc_counter *c)
+{
+	return c->peak_bytes;
+}
+
+/**
+ * alloc_counter_kill() - Destroy a counting allocator.
+ * @c: Counter to destroy.
+ *
+ * Memory still allocated through the counter is not returned.
+ *
+ * Returns: Nothing.
+ */
+void alloc_counter_kill(alloc_counter *c)
+{
+	free(c);
+}
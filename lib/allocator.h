@@ -0,0 +1,197 @@
+#ifndef __ALLOCATOR_H
+#define __ALLOCATOR_H
+
+#include <stddef.h>
+#include "util.h"
+
+/*
+ * Declaration of a memory allocator interface. An allocator is a set
+ * of alloc/realloc/free functions and a context pointer that is passed
+ * to them. The containers in this directory have _alloc variants of
+ * their create functions that take an allocator and get all their own
+ * memory from it. Passing NULL as allocator selects the default
+ * allocator, which uses malloc(), realloc() and free().
+ *
+ * Two more allocators are provided:
+ *
+ *   An arena hands out memory from large chunks and ignores free. All
+ *   memory is returned at once by arena_kill(), so a container built on
+ *   an arena can be released without visiting its elements.
+ *
+ *   A counting allocator passes every call on to another allocator and
+ *   keeps statistics on the number of calls and the bytes in use.
+ *
+ * All memory returned by the allocators is aligned for any basic type
+ * (16 bytes). The allocators are not thread safe.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Allocator type. The realloc function gets the old size of the block,
+// so that allocators do not have to record the size of every block.
+typedef struct allocator {
+	void *(*alloc)(void *ctx, size_t size);
+	void *(*realloc)(void *ctx, void *p, size_t old_size, size_t new_size);
+	void (*free)(void *ctx, void *p);
+	void *ctx;
+} allocator;
+
+// Arena type.
+typedef struct arena arena;
+
+// Counting allocator type.
+typedef struct alloc_counter alloc_counter;
+
+// ==========ALLOCATOR INTERFACE==========
+
+/**
+ * allocator_default() - Return the default allocator.
+ *
+ * Returns: An allocator that uses malloc(), realloc() and free().
+ */
+const allocator *allocator_default(void);
+
+/**
+ * allocator_alloc() - Allocate memory.
+ * @a: Allocator to use, or NULL for the default allocator.
+ * @size: Number of bytes.
+ *
+ * Returns: A pointer to the memory, or NULL if not enough memory was
+ *	    available.
+ */
+void *allocator_alloc(const allocator *a, size_t size);
+
+/**
+ * allocator_calloc() - Allocate cleared memory.
+ * @a: Allocator to use, or NULL for the default allocator.
+ * @n: Number of elements.
+ * @size: Size of every element.
+ *
+ * Returns: A pointer to the memory, or NULL if not enough memory was
+ *	    available.
+ */
+void *allocator_calloc(const allocator *a, size_t n, size_t size);
+
+/**
+ * allocator_realloc() - Change the size of allocated memory.
+ * @a: Allocator the memory was allocated with, or NULL for the default
+ *     allocator.
+ * @p: Memory to resize, or NULL.
+ * @old_size: Current size of the memory in bytes, 0 if p is NULL.
+ * @new_size: New size in bytes.
+ *
+ * Returns: A pointer to the resized memory, or NULL if not enough
+ *	    memory was available, in which case p is left unchanged.
+ */
+void *allocator_realloc(const allocator *a, void *p, size_t old_size, size_t new_size);
+
+/**
+ * allocator_free() - Return allocated memory.
+ * @a: Allocator the memory was allocated with, or NULL for the default
+ *     allocator.
+ * @p: Memory to return, or NULL.
+ *
+ * Returns: Nothing.
+ */
+void allocator_free(const allocator *a, void *p);
+
+// ==========ARENA INTERFACE==========
+
+/**
+ * arena_create() - Create an empty arena.
+ *
+ * Returns: A pointer to the new arena.
+ */
+arena *arena_create(void);
+
+/**
+ * arena_allocator() - Return the allocator of an arena.
+ * @ar: Arena to allocate from.
+ *
+ * Returns: An allocator that is valid as long as the arena.
+ */
+const allocator *arena_allocator(arena *ar);
+
+/**
+ * arena_bytes() - Return the number of bytes handed out by an arena.
+ * @ar: Arena to inspect.
+ *
+ * Returns: The number of bytes handed out, including alignment padding.
+ */
+size_t arena_bytes(const arena *ar);
+
+/**
+ * arena_kill() - Destroy an arena.
+ * @ar: Arena to destroy.
+ *
+ * Returns all memory handed out by the arena at once.
+ *
+ * Returns: Nothing.
+ */
+void arena_kill(arena *ar);
+
+// ==========COUNTING ALLOCATOR INTERFACE==========
+
+/**
+ * alloc_counter_create() - Create a counting allocator.
+ * @parent: Allocator to pass the calls on to, or NULL for the default
+ *	    allocator.
+ *
+ * Returns: A pointer to the new counting allocator.
+ */
+alloc_counter *alloc_counter_create(const allocator *parent);
+
+/**
+ * alloc_counter_allocator() - Return the allocator of a counter.
+ * @c: Counter to count the calls in.
+ *
+ * Returns: An allocator that is valid as long as the counter.
+ */
+const allocator *alloc_counter_allocator(alloc_counter *c);
+
+/**
+ * alloc_counter_allocs() - Return the number of allocations.
+ * @c: Counter to inspect.
+ *
+ * Returns: The number of alloc and realloc calls that returned memory.
+ */
+size_t alloc_counter_allocs(const alloc_counter *c);
+
+/**
+ * alloc_counter_frees() - Return the number of free calls.
+ * @c: Counter to inspect.
+ *
+ * Returns: The number of free calls with memory other than NULL.
+ */
+size_t alloc_counter_frees(const alloc_counter *c);
+
+/**
+ * alloc_counter_bytes() - Return the number of bytes in use.
+ * @c: Counter to inspect.
+ *
+ * Returns: The number of bytes allocated and not yet freed.
+ */
+size_t alloc_counter_bytes(const alloc_counter *c);
+
+/**
+ * alloc_counter_peak_bytes() - Return the largest number of bytes in use.
+ * @c: Counter to inspect.
+ *
+ * Returns: The largest number of bytes in use at any time.
+ */
+size_t alloc_counter_peak_bytes(const alloc_counter *c);
+
+/**
+ * alloc_counter_kill() - Destroy a counting allocator.
+ * @c: Counter to destroy.
+ *
+ * Memory still allocated through the counter is not returned.
+ *
+ * Returns: Nothing.
+ */
+void alloc_counter_kill(alloc_counter *c);
+
+#endif
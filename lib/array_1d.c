@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <array_1d.h>
 
@@ -16,16 +17,30 @@
  *
  * Version information:
  *   2018-01-28: v1.0, first public version.
+ *   2026-10-18: v1.1, growable arrays and inline values.
+ *   2026-10-18: v1.2, memory may come from an allocator.
+ *   2026-10-18: v1.3, inline values may come from an allocator.
  */
 
 // ===========INTERNAL DATA TYPES============
 
+/*
+ * The storage may be larger than the array, so that the high index
+ * limit can be moved without reallocating every time. Storage beyond
+ * array_size is always cleared. Inline values are stored back to back
+ * in a byte buffer, with a flag per element telling if it has a value.
+ */
 struct array_1d {
 	int low; // Low index limit.
 	int high; // High index limit.
 	int array_size; // Number of array elements.
+	int capacity; // Number of elements there is storage for.
+	int value_size; // Size of inline values, or 0 if pointers are stored.
 	void **values; // Pointer to where the actual values are stored.
+	char *inline_values; // Storage for inline values.
+	bool *has_inline_value; // Which inline values are set.
 	free_function free_func;
+	const allocator *alloc; // Allocator for the structure and storage.
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
@@ -44,24 +59,43 @@ struct array_1d {
  * was available.
  */
 array_1d *array_1d_create(int lo, int hi, free_function free_func)
+{
+	return array_1d_create_alloc(lo, hi, free_func, NULL);
+}
+
+/**
+ * array_1d_create_alloc() - Create an array that uses an allocator.
+ * @lo: low index limit.
+ * @hi: high index limit.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @alloc: Allocator for the array, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_1d *array_1d_create_alloc(int lo, int hi, free_function free_func,
+				const allocator *alloc)
 {
 	// Allocate array structure.
-	array_1d *a=calloc(1, sizeof(*a));
+	array_1d *a=allocator_calloc(alloc, 1, sizeof(*a));
+	a->alloc=alloc;
 	// Store index limit.
 	a->low=lo;
 	a->high=hi;
 
 	// Number of elements.
 	a->array_size = hi-lo+1;
+	a->capacity = a->array_size > 0 ? a->array_size : 1;
 
 	// Store free function.
 	a->free_func=free_func;
 
-	a->values=calloc(a->array_size, sizeof(void *));
+	a->values=allocator_calloc(alloc, a->capacity, sizeof(void *));
 
 	// Check whether the allocation succeeded.
 	if (a->values == NULL) {
-		free(a);
+		allocator_free(alloc, a);
 		a=NULL;
 	}
 	return a;
@@ -100,6 +134,10 @@ int array_1d_high(const array_1d *a)
 void *array_1d_inspect_value(const array_1d *a, int i)
 {
 	int offset=i-array_1d_low(a);
+	if (a->value_size > 0) {
+		// Return a pointer to the inline value.
+		return a->inline_values + (size_t)offset * a->value_size;
+	}
 	// Return the value.
 	return a->values[offset];
 }
@@ -114,6 +152,9 @@ void *array_1d_inspect_value(const array_1d *a, int i)
 bool array_1d_has_value(const array_1d *a, int i)
 {
 	int offset=i-array_1d_low(a);
+	if (a->value_size > 0) {
+		return a->has_inline_value[offset];
+	}
 	// Return true if the value is not NULL.
 	return a->values[offset] != NULL;
 }
@@ -132,6 +173,14 @@ bool array_1d_has_value(const array_1d *a, int i)
 void array_1d_set_value(array_1d *a, void *v, int i)
 {
 	int offset=i-array_1d_low(a);
+	if (a->value_size > 0) {
+		// Copy the value into the array.
+		if (v != NULL) {
+			memcpy(a->inline_values + (size_t)offset * a->value_size, v, a->value_size);
+		}
+		a->has_inline_value[offset]=(v != NULL);
+		return;
+	}
 	// Call free_func if specified and old element value was non-NULL.
 	if (a->free_func != NULL && a->values[offset] != NULL) {
 		a->free_func( a->values[offset] );
@@ -151,6 +200,12 @@ void array_1d_set_value(array_1d *a, void *v, int i)
  */
 void array_1d_kill(array_1d *a)
 {
+	if (a->value_size > 0) {
+		allocator_free(a->alloc, a->inline_values);
+		allocator_free(a->alloc, a->has_inline_value);
+		allocator_free(a->alloc, a);
+		return;
+	}
 	if (a->free_func) {
 		// Return user-allocated memory for each non-NULL element.
 		for (int i=0; i<a->array_size; i++) {
@@ -160,9 +215,9 @@ void array_1d_kill(array_1d *a)
 		}
 	}
 	// Free actual storage.
-	free(a->values);
+	allocator_free(a->alloc, a->values);
 	// Free array structure.
-	free(a);
+	allocator_free(a->alloc, a);
 }
 
 /**
@@ -192,3 +247,160 @@ void array_1d_print(const array_1d *a, inspect_callback print_func)
 	}
 	printf(" ]\n");
 }
+
+/**
+ * array_1d_create_inline() - Create an array that stores values inline.
+ * @lo: low index limit.
+ * @hi: high index limit.
+ * @value_size: size in bytes of every value.
+ *
+ * The array stores copies of the values given to array_1d_set_value()
+ * rather than the pointers. array_1d_inspect_value() returns a pointer
+ * to the stored copy, which is valid until the array grows. No free
+ * function is called for inline values.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_1d *array_1d_create_inline(int lo, int hi, int value_size)
+{
+	return array_1d_create_inline_alloc(lo, hi, value_size, NULL);
+}
+
+/**
+ * array_1d_create_inline_alloc() - Create an array that stores values
+ *				    inline and uses an allocator.
+ * @lo: low index limit.
+ * @hi: high index limit.
+ * @value_size: size in bytes of every value.
+ * @alloc: Allocator for the array, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_1d *array_1d_create_inline_alloc(int lo, int hi, int value_size,
+				       const allocator *alloc)
+{
+	// Allocate array structure.
+	array_1d *a=allocator_calloc(alloc, 1, sizeof(*a));
+	a->alloc=alloc;
+	// Store index limit.
+	a->low=lo;
+	a->high=hi;
+
+	// Number of elements.
+	a->array_size = hi-lo+1;
+	a->capacity = a->array_size > 0 ? a->array_size : 1;
+	a->value_size = value_size;
+
+	a->inline_values=allocator_calloc(alloc, a->capacity, value_size);
+	a->has_inline_value=allocator_calloc(alloc, a->capacity, sizeof(bool));
+
+	// Check whether the allocation succeeded.
+	if (a->inline_values == NULL || a->has_inline_value == NULL) {
+		allocator_free(alloc, a->inline_values);
+		allocator_free(alloc, a->has_inline_value);
+		allocator_free(alloc, a);
+		a=NULL;
+	}
+	return a;
+}
+
+/**
+ * array_1d_grow() - Internal function to enlarge the storage.
+ * @a: array to modify.
+ * @capacity: new number of elements to have storage for.
+ *
+ * The new storage is cleared.
+ *
+ * Returns: Nothing.
+ */
+static void array_1d_grow(array_1d *a, int capacity)
+{
+	if (a->value_size > 0) {
+		a->inline_values=allocator_realloc(a->alloc, a->inline_values,
+						   (size_t)a->capacity * a->value_size,
+						   (size_t)capacity * a->value_size);
+		a->has_inline_value=allocator_realloc(a->alloc, a->has_inline_value,
+						      a->capacity * sizeof(bool),
+						      capacity * sizeof(bool));
+		memset(a->has_inline_value + a->capacity, 0,
+		       (capacity - a->capacity) * sizeof(bool));
+	} else {
+		a->values=allocator_realloc(a->alloc, a->values, a->capacity * sizeof(void *),
+					    capacity * sizeof(void *));
+		memset(a->values + a->capacity, 0,
+		       (capacity - a->capacity) * sizeof(void *));
+	}
+	if ((a->value_size > 0 && (a->inline_values == NULL || a->has_inline_value == NULL))
+	    || (a->value_size == 0 && a->values == NULL)) {
+		fprintf(stderr, "array_1d: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	a->capacity=capacity;
+}
+
+/**
+ * array_1d_resize() - Move the high index limit of the array.
+ * @a: array to modify.
+ * @hi: new high index limit, at least lo-1.
+ *
+ * New positions have no value. If positions are removed and free_func
+ * was specified at array creation, calls it for every removed
+ * non-NULL value.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_resize(array_1d *a, int hi)
+{
+	int size=hi-a->low+1;
+
+	// Clear the removed positions, so that the storage beyond
+	// array_size stays cleared.
+	for (int i=a->high; i>hi; i--) {
+		array_1d_set_value(a, NULL, i);
+	}
+
+	// Grow the storage at least geometrically.
+	if (size > a->capacity) {
+		int capacity=2*a->capacity;
+		array_1d_grow(a, capacity > size ? capacity : size);
+	}
+
+	a->high=hi;
+	a->array_size=size;
+}
+
+/**
+ * array_1d_reserve() - Make room for a number of elements.
+ * @a: array to modify.
+ * @n: number of elements the array should be able to hold.
+ *
+ * Makes sure that the array can grow to n elements without allocating
+ * more memory. The index limits are not changed.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_reserve(array_1d *a, int n)
+{
+	if (n > a->capacity) {
+		array_1d_grow(a, n);
+	}
+}
+
+/**
+ * array_1d_push() - Put a value after the last position of the array.
+ * @a: array to modify.
+ * @v: value to store at the new position.
+ *
+ * Increases the high index limit by one and sets the value at the new
+ * high index.
+ *
+ * Returns: The index of the new position.
+ */
+int array_1d_push(array_1d *a, void *v)
+{
+	array_1d_resize(a, a->high+1);
+	array_1d_set_value(a, v, a->high);
+	return a->high;
+}
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include "util.h"
+#include "allocator.h"
 
 /*
  * Declaration of a generic 1D array for the "Datastructures and
@@ -16,12 +17,24 @@
  *
  * An element value of NULL is considered to be "no" value.
  *
+ * The high index limit can be moved after creation with
+ * array_1d_push() and array_1d_resize(), which grow the storage
+ * geometrically so that pushing is amortized constant time.
+ *
+ * An array created by array_1d_create_inline() stores copies of
+ * fixed size values in the array itself instead of pointers. Its
+ * inspect function returns a pointer to the stored copy, and such
+ * pointers are only valid until the array grows.
+ *
  * Authors: Niclas Borlin (niclas@cs.umu.se)
  *
  * Based on earlier code by: Johan Eliasson (johane@cs.umu.se).
  *
  * Version information:
  *   v1.0 2018-01-28: First public version.
+ *   v1.1 2026-10-18: Added growable arrays and inline values.
+ *   v1.2 2026-10-18: Added array_1d_create_alloc.
+ *   v1.3 2026-10-18: Added array_1d_create_inline_alloc.
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -46,6 +59,20 @@ typedef struct array_1d array_1d;
  */
 array_1d *array_1d_create(int lo, int hi, free_function free_func);
 
+/**
+ * array_1d_create_alloc() - Create an array that uses an allocator.
+ * @lo: low index limit.
+ * @hi: high index limit.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @alloc: Allocator for the array, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_1d *array_1d_create_alloc(int lo, int hi, free_function free_func,
+				const allocator *alloc);
+
 /**
  * array_1d_low() - Return the low index limit for the array.
  * @a: array to inspect.
@@ -117,4 +144,71 @@ void array_1d_kill(array_1d *a);
  */
 void array_1d_print(const array_1d * l, inspect_callback print_func);
 
+/**
+ * array_1d_create_inline() - Create an array that stores values inline.
+ * @lo: low index limit.
+ * @hi: high index limit.
+ * @value_size: size in bytes of every value.
+ *
+ * The array stores copies of the values given to array_1d_set_value()
+ * rather than the pointers. array_1d_inspect_value() returns a pointer
+ * to the stored copy, which is valid until the array grows. No free
+ * function is called for inline values.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_1d *array_1d_create_inline(int lo, int hi, int value_size);
+
+/**
+ * array_1d_create_inline_alloc() - Create an array that stores values
+ *				    inline and uses an allocator.
+ * @lo: low index limit.
+ * @hi: high index limit.
+ * @value_size: size in bytes of every value.
+ * @alloc: Allocator for the array, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_1d *array_1d_create_inline_alloc(int lo, int hi, int value_size,
+				       const allocator *alloc);
+
+/**
+ * array_1d_resize() - Move the high index limit of the array.
+ * @a: array to modify.
+ * @hi: new high index limit, at least lo-1.
+ *
+ * New positions have no value. If positions are removed and free_func
+ * was specified at array creation, calls it for every removed
+ * non-NULL value.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_resize(array_1d *a, int hi);
+
+/**
+ * array_1d_reserve() - Make room for a number of elements.
+ * @a: array to modify.
+ * @n: number of elements the array should be able to hold.
+ *
+ * Makes sure that the array can grow to n elements without allocating
+ * more memory. The index limits are not changed.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_reserve(array_1d *a, int n);
+
+/**
+ * array_1d_push() - Put a value after the last position of the array.
+ * @a: array to modify.
+ * @v: value to store at the new position.
+ *
+ * Increases the high index limit by one and sets the value at the new
+ * high index.
+ *
+ * Returns: The index of the new position.
+ */
+int array_1d_push(array_1d *a, void *v);
+
 #endif
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <array_2d.h>
 
@@ -15,16 +16,39 @@
  * Version information:
  *   v1.0  2018-01-28: First public version.
  *   v1.1  2018-04-03: Moved freehandler to last in create parameter list.
+ *   v1.2  2026-10-18: Added sparse arrays, array_2d_next_in_row and
+ *                     array_2d_resize.
+ *   v1.3  2026-10-18: Memory may come from an allocator.
+ *   v1.4  2026-10-18: Added array_2d_reserve_row.
+ *   v1.5  2026-10-18: Values set in order are appended to their row.
  */
 
 // ===========INTERNAL DATA TYPES============
 
+/*
+ * A sparse array stores every row (first index) as an array of
+ * (second index, value) entries sorted by the second index. A row is
+ * allocated when it gets its first value and grows geometrically.
+ */
+struct sparse_entry {
+	int j; // Second index.
+	void *value;
+};
+
+struct sparse_row {
+	int size; // Number of entries.
+	int capacity; // Number of entries there is room for.
+	struct sparse_entry entries[];
+};
+
 struct array_2d {
 	int low[2]; // Low index limits.
 	int high[2]; // High index limits.
 	int array_size; // Number of array elements.
 	void **values; // Pointer to where the actual values are stored.
+	struct sparse_row **rows; // Rows of a sparse array, otherwise NULL.
 	free_function free_func;
+	const allocator *alloc; // Allocator for the structure and storage.
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
@@ -46,9 +70,29 @@ struct array_2d {
  */
 array_2d *array_2d_create(int lo1, int hi1, int lo2, int hi2,
 			  free_function free_func)
+{
+	return array_2d_create_alloc(lo1, hi1, lo2, hi2, free_func, NULL);
+}
+
+/**
+ * array_2d_create_alloc() - Create an array that uses an allocator.
+ * @lo1: low index limit for first dimension.
+ * @hi1: high index limit for first dimension.
+ * @lo2: low index limit for second dimension.
+ * @hi2: high index limit for second dimension.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @alloc: Allocator for the array, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_2d *array_2d_create_alloc(int lo1, int hi1, int lo2, int hi2,
+				free_function free_func, const allocator *alloc)
 {
 	// Allocate array structure.
-	array_2d *a=calloc(1, sizeof(*a));
+	array_2d *a=allocator_calloc(alloc, 1, sizeof(*a));
+	a->alloc=alloc;
 	// Store index limit.
 	a->low[0]=lo1;
 	a->low[1]=lo2;
@@ -61,11 +105,11 @@ array_2d *array_2d_create(int lo1, int hi1, int lo2, int hi2,
 	// Store free function.
 	a->free_func=free_func;
 
-	a->values=calloc(a->array_size, sizeof(void *));
+	a->values=allocator_calloc(alloc, a->array_size, sizeof(void *));
 
 	// Check whether the allocation succeeded.
 	if (a->values == NULL) {
-		free(a);
+		allocator_free(alloc, a);
 		a=NULL;
 	}
 	return a;
@@ -114,6 +158,113 @@ static int array_2d_linear_index(const array_2d *a,int i, int j)
 	return ix;
 }
 
+/**
+ * sparse_row_search() - Internal function to find an entry in a sparse row.
+ * @r: Row to search, or NULL.
+ * @j: Second index to search for.
+ *
+ * Returns: The index of the first entry whose second index is at least
+ *	    j, or the number of entries if there is none.
+ */
+static int sparse_row_search(const struct sparse_row *r, int j)
+{
+	if (r == NULL) {
+		return 0;
+	}
+	// Binary search in the sorted entries.
+	int lo=0;
+	int hi=r->size;
+	while (lo < hi) {
+		int mid=lo+(hi-lo)/2;
+		if (r->entries[mid].j < j) {
+			lo=mid+1;
+		} else {
+			hi=mid;
+		}
+	}
+	return lo;
+}
+
+/**
+ * sparse_row_grow() - Internal function to make room in a sparse row.
+ * @a: array the row belongs to.
+ * @rp: Pointer to the row, which may be NULL.
+ * @capacity: Number of entries the row should have room for, larger
+ *	      than its current capacity.
+ *
+ * Returns: The grown row, also stored in *rp.
+ */
+static struct sparse_row *sparse_row_grow(array_2d *a, struct sparse_row **rp, int capacity)
+{
+	struct sparse_row *r=*rp;
+	size_t old_bytes=(r == NULL) ? 0 : sizeof(*r) + r->capacity * sizeof(struct sparse_entry);
+	struct sparse_row *larger=allocator_realloc(a->alloc, r, old_bytes,
+						    sizeof(*r) + capacity * sizeof(struct sparse_entry));
+	if (larger == NULL) {
+		fprintf(stderr, "array_2d: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	if (r == NULL) {
+		larger->size=0;
+	}
+	larger->capacity=capacity;
+	*rp=larger;
+	return larger;
+}
+
+/**
+ * sparse_set_value() - Internal function to set a value in a sparse array.
+ * @a: array to modify.
+ * @v: value to set element to, or NULL to clear value.
+ * @i: First index of position to modify.
+ * @j: Second index of position to modify.
+ *
+ * Returns: Nothing.
+ */
+static void sparse_set_value(array_2d *a, void *v, int i, int j)
+{
+	struct sparse_row **rp=&a->rows[i-a->low[0]];
+	struct sparse_row *r=*rp;
+	int k;
+
+	// A value after the last one in its row, as when a row is filled
+	// in order, is appended without a search.
+	if (r != NULL && r->size > 0 && r->entries[r->size-1].j < j) {
+		k=r->size;
+	} else {
+		k=sparse_row_search(r, j);
+	}
+
+	if (r != NULL && k < r->size && r->entries[k].j == j) {
+		// The position has a value. Call free_func if specified.
+		if (a->free_func != NULL) {
+			a->free_func(r->entries[k].value);
+		}
+		if (v != NULL) {
+			r->entries[k].value=v;
+		} else {
+			// Remove the entry.
+			memmove(&r->entries[k], &r->entries[k+1],
+				(r->size-k-1) * sizeof(struct sparse_entry));
+			r->size--;
+		}
+		return;
+	}
+	if (v == NULL) {
+		return;
+	}
+
+	// Make room for a new entry.
+	if (r == NULL || r->size == r->capacity) {
+		r=sparse_row_grow(a, rp, (r == NULL) ? 2 : 2*r->capacity);
+	}
+	memmove(&r->entries[k+1], &r->entries[k],
+		(r->size-k) * sizeof(struct sparse_entry));
+	r->entries[k].j=j;
+	r->entries[k].value=v;
+	r->size++;
+}
+
 /**
  * array_2d_inspect_value() - Inspect a value at a given array position.
  * @a: array to inspect.
@@ -125,6 +276,11 @@ static int array_2d_linear_index(const array_2d *a,int i, int j)
  */
 void *array_2d_inspect_value(const array_2d *a, int i, int j)
 {
+	if (a->rows != NULL) {
+		const struct sparse_row *r=a->rows[i-a->low[0]];
+		int k=sparse_row_search(r, j);
+		return (r != NULL && k < r->size && r->entries[k].j == j) ? r->entries[k].value : NULL;
+	}
 	int ix=array_2d_linear_index(a, i, j);
 	// Return the value.
 	return a->values[ix];
@@ -140,6 +296,9 @@ void *array_2d_inspect_value(const array_2d *a, int i, int j)
  */
 bool array_2d_has_value(const array_2d *a, int i, int j)
 {
+	if (a->rows != NULL) {
+		return array_2d_inspect_value(a, i, j) != NULL;
+	}
 	int ix=array_2d_linear_index(a, i, j);
 	// Return true if the value is not NULL.
 	return a->values[ix] != NULL;
@@ -159,6 +318,10 @@ bool array_2d_has_value(const array_2d *a, int i, int j)
  */
 void array_2d_set_value(array_2d *a, void *v, int i, int j)
 {
+	if (a->rows != NULL) {
+		sparse_set_value(a, v, i, j);
+		return;
+	}
 	int ix=array_2d_linear_index(a, i, j);
 	// Call free_func if specified and old element value was non-NULL.
 	if (a->free_func != NULL && a->values[ix] != NULL) {
@@ -179,6 +342,24 @@ void array_2d_set_value(array_2d *a, void *v, int i, int j)
  */
 void array_2d_kill(array_2d *a)
 {
+	if (a->rows != NULL) {
+		int rows=a->high[0]-a->low[0]+1;
+		for (int r=0; r<rows; r++) {
+			if (a->rows[r] == NULL) {
+				continue;
+			}
+			// Return user-allocated memory for each value in the row.
+			if (a->free_func) {
+				for (int k=0; k<a->rows[r]->size; k++) {
+					a->free_func(a->rows[r]->entries[k].value);
+				}
+			}
+			allocator_free(a->alloc, a->rows[r]);
+		}
+		allocator_free(a->alloc, a->rows);
+		allocator_free(a->alloc, a);
+		return;
+	}
 	if (a->free_func) {
 		// Return user-allocated memory for each non-NULL element.
 		for (int i=0; i<a->array_size; i++) {
@@ -188,9 +369,9 @@ void array_2d_kill(array_2d *a)
 		}
 	}
 	// Free actual storage.
-	free(a->values);
+	allocator_free(a->alloc, a->values);
 	// Free array structure.
-	free(a);
+	allocator_free(a->alloc, a);
 }
 
 /**
@@ -224,3 +405,172 @@ void array_2d_print(const array_2d *a, inspect_callback print_func)
 	}
 	printf(" ]\n");
 }
+
+/**
+ * array_2d_create_sparse() - Create a sparse array without values.
+ * @lo1: low index limit for first dimension.
+ * @hi1: high index limit for first dimension.
+ * @lo2: low index limit for second dimension.
+ * @hi2: high index limit for second dimension.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ *
+ * The array only allocates memory for the positions that have values,
+ * plus one pointer for every index in the first dimension.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_2d *array_2d_create_sparse(int lo1, int hi1, int lo2, int hi2,
+				 free_function free_func)
+{
+	return array_2d_create_sparse_alloc(lo1, hi1, lo2, hi2, free_func, NULL);
+}
+
+/**
+ * array_2d_create_sparse_alloc() - Create a sparse array that uses an
+ *				    allocator.
+ * @lo1: low index limit for first dimension.
+ * @hi1: high index limit for first dimension.
+ * @lo2: low index limit for second dimension.
+ * @hi2: high index limit for second dimension.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @alloc: Allocator for the array, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_2d *array_2d_create_sparse_alloc(int lo1, int hi1, int lo2, int hi2,
+				       free_function free_func, const allocator *alloc)
+{
+	// Allocate array structure.
+	array_2d *a=allocator_calloc(alloc, 1, sizeof(*a));
+	a->alloc=alloc;
+	// Store index limit.
+	a->low[0]=lo1;
+	a->low[1]=lo2;
+	a->high[0]=hi1;
+	a->high[1]=hi2;
+
+	// Store free function.
+	a->free_func=free_func;
+
+	// One empty row per first index. Allocate at least one so that
+	// rows is never NULL for a sparse array.
+	int rows=hi1-lo1+1;
+	a->rows=allocator_calloc(alloc, rows > 0 ? rows : 1, sizeof(struct sparse_row *));
+
+	// Check whether the allocation succeeded.
+	if (a->rows == NULL) {
+		allocator_free(alloc, a);
+		a=NULL;
+	}
+	return a;
+}
+
+/**
+ * array_2d_next_in_row() - Find the next position with a value in a row.
+ * @a: array to inspect.
+ * @i: first index of the row.
+ * @j: second index to search after, or lo2-1 to search from the start.
+ *
+ * Iterate over the values in row i with:
+ *
+ *	for (j = array_2d_next_in_row(a, i, lo2-1); j <= hi2;
+ *	     j = array_2d_next_in_row(a, i, j))
+ *
+ * Returns: The smallest second index larger than j that has a value
+ *	    in row i, or hi2+1 if there is none.
+ */
+int array_2d_next_in_row(const array_2d *a, int i, int j)
+{
+	if (a->rows != NULL) {
+		const struct sparse_row *r=a->rows[i-a->low[0]];
+		int k=sparse_row_search(r, j+1);
+		return (r != NULL && k < r->size) ? r->entries[k].j : a->high[1]+1;
+	}
+
+	// Scan the row of a dense array.
+	for (j=j+1; j<=a->high[1]; j++) {
+		if (array_2d_has_value(a, i, j)) {
+			return j;
+		}
+	}
+	return a->high[1]+1;
+}
+
+/**
+ * array_2d_resize() - Move the high index limits of the array.
+ * @a: array to modify.
+ * @hi1: new high index limit for first dimension.
+ * @hi2: new high index limit for second dimension.
+ *
+ * New positions have no value. If positions are removed and free_func
+ * was specified at array creation, calls it for every removed
+ * non-NULL value.
+ *
+ * Returns: Nothing.
+ */
+void array_2d_resize(array_2d *a, int hi1, int hi2)
+{
+	// Clear all values outside the new limits.
+	for (int i=a->low[0]; i<=a->high[0]; i++) {
+		int j=(i > hi1) ? a->low[1]-1 : hi2;
+		while ((j=array_2d_next_in_row(a, i, j)) <= a->high[1]) {
+			array_2d_set_value(a, NULL, i, j);
+		}
+	}
+
+	int old_rows=a->high[0]-a->low[0]+1;
+	int rows=hi1-a->low[0]+1;
+	int cols=hi2-a->low[1]+1;
+
+	if (a->rows != NULL) {
+		// Free removed rows and add empty new ones.
+		for (int r=rows; r<old_rows; r++) {
+			allocator_free(a->alloc, a->rows[r]);
+		}
+		if (rows > old_rows) {
+			a->rows=allocator_realloc(a->alloc, a->rows,
+						  (old_rows > 0 ? old_rows : 1) * sizeof(struct sparse_row *),
+						  rows * sizeof(struct sparse_row *));
+			memset(a->rows+old_rows, 0, (rows-old_rows) * sizeof(struct sparse_row *));
+		}
+	} else {
+		// Copy the remaining values into new dense storage.
+		void **values=allocator_calloc(a->alloc, rows > 0 && cols > 0 ? rows*cols : 1,
+					       sizeof(void *));
+		for (int i=a->low[0]; i<=a->high[0] && i<=hi1; i++) {
+			for (int j=a->low[1]; j<=a->high[1] && j<=hi2; j++) {
+				values[(i-a->low[0])+(j-a->low[1])*rows]=a->values[array_2d_linear_index(a, i, j)];
+			}
+		}
+		allocator_free(a->alloc, a->values);
+		a->values=values;
+		a->array_size=rows*cols;
+	}
+
+	a->high[0]=hi1;
+	a->high[1]=hi2;
+}
+
+/**
+ * array_2d_reserve_row() - Make room for a number of values in a row.
+ * @a: array to modify.
+ * @i: first index of the row.
+ * @n: number of values the row should be able to hold.
+ *
+ * Returns: Nothing.
+ */
+void array_2d_reserve_row(array_2d *a, int i, int n)
+{
+	// Dense arrays already have room for every position.
+	if (a->rows == NULL) {
+		return;
+	}
+	struct sparse_row **rp=&a->rows[i-a->low[0]];
+	if (n > 0 && (*rp == NULL || n > (*rp)->capacity)) {
+		sparse_row_grow(a, rp, n);
+	}
+}
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include "util.h"
+#include "allocator.h"
 
 /*
  * Declaration of a generic 2D array for the "Datastructures and
@@ -16,6 +17,19 @@
  *
  * An element value of NULL is considered to be "no" value.
  *
+ * An array created by array_2d_create_sparse() only stores the
+ * positions that have values, so its memory use grows with the number
+ * of values instead of with the number of positions. It has the same
+ * interface as the ordinary (dense) array, but inspecting a position
+ * takes logarithmic time in the number of values in its row. A row is
+ * kept sorted by the second index, so setting a value before other
+ * values in its row moves them, and filling a row of d values in
+ * random order takes O(d^2) time. Values set in increasing order of
+ * the second index are appended in constant time.
+ *
+ * The values in a row can be visited in index order with
+ * array_2d_next_in_row(), which is fast for sparse arrays.
+ *
  * Authors: Niclas Borlin (niclas@cs.umu.se)
  *
  * Based on earlier code by: Johan Eliasson (johane@cs.umu.se).
@@ -23,6 +37,13 @@
  * Version information:
  *   v1.0 2018-01-28: First public version.
  *   v1.1 2018-04-03: Moved freehandler to last in create parameter list.
+ *   v1.2 2026-10-18: Added sparse arrays, array_2d_next_in_row and
+ *                    array_2d_resize.
+ *   v1.3 2026-10-18: Added array_2d_create_alloc and
+ *                    array_2d_create_sparse_alloc.
+ *   v1.4 2026-10-18: Added array_2d_reserve_row.
+ *   v1.5 2026-10-18: Documented the cost of filling a sparse row out
+ *                    of order.
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -50,6 +71,22 @@ typedef struct array_2d array_2d;
 array_2d *array_2d_create(int lo1, int hi1, int lo2, int hi2,
                           free_function free_func);
 
+/**
+ * array_2d_create_alloc() - Create an array that uses an allocator.
+ * @lo1: low index limit for first dimension.
+ * @hi1: high index limit for first dimension.
+ * @lo2: low index limit for second dimension.
+ * @hi2: high index limit for second dimension.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @alloc: Allocator for the array, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_2d *array_2d_create_alloc(int lo1, int hi1, int lo2, int hi2,
+				free_function free_func, const allocator *alloc);
+
 /**
  * array_2d_low() - Return the low index limit for the array.
  * @a: array to inspect.
@@ -126,4 +163,83 @@ void array_2d_kill(array_2d *a);
  */
 void array_2d_print(const array_2d * l, inspect_callback print_func);
 
+/**
+ * array_2d_create_sparse() - Create a sparse array without values.
+ * @lo1: low index limit for first dimension.
+ * @hi1: high index limit for first dimension.
+ * @lo2: low index limit for second dimension.
+ * @hi2: high index limit for second dimension.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ *
+ * The array only allocates memory for the positions that have values,
+ * plus one pointer for every index in the first dimension.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_2d *array_2d_create_sparse(int lo1, int hi1, int lo2, int hi2,
+				 free_function free_func);
+
+/**
+ * array_2d_create_sparse_alloc() - Create a sparse array that uses an
+ *				    allocator.
+ * @lo1: low index limit for first dimension.
+ * @hi1: high index limit for first dimension.
+ * @lo2: low index limit for second dimension.
+ * @hi2: high index limit for second dimension.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @alloc: Allocator for the array, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_2d *array_2d_create_sparse_alloc(int lo1, int hi1, int lo2, int hi2,
+				       free_function free_func, const allocator *alloc);
+
+/**
+ * array_2d_next_in_row() - Find the next position with a value in a row.
+ * @a: array to inspect.
+ * @i: first index of the row.
+ * @j: second index to search after, or lo2-1 to search from the start.
+ *
+ * Iterate over the values in row i with:
+ *
+ *	for (j = array_2d_next_in_row(a, i, lo2-1); j <= hi2;
+ *	     j = array_2d_next_in_row(a, i, j))
+ *
+ * Returns: The smallest second index larger than j that has a value
+ *	    in row i, or hi2+1 if there is none.
+ */
+int array_2d_next_in_row(const array_2d *a, int i, int j);
+
+/**
+ * array_2d_resize() - Move the high index limits of the array.
+ * @a: array to modify.
+ * @hi1: new high index limit for first dimension.
+ * @hi2: new high index limit for second dimension.
+ *
+ * New positions have no value. If positions are removed and free_func
+ * was specified at array creation, calls it for every removed
+ * non-NULL value.
+ *
+ * Returns: Nothing.
+ */
+void array_2d_resize(array_2d *a, int hi1, int hi2);
+
+/**
+ * array_2d_reserve_row() - Make room for a number of values in a row.
+ * @a: array to modify.
+ * @i: first index of the row.
+ * @n: number of values the row should be able to hold.
+ *
+ * Allocates a row of a sparse array with room for exactly n values, or
+ * grows it to that size, so that a row whose number of values is known
+ * in advance is allocated once. Does nothing for dense arrays.
+ *
+ * Returns: Nothing.
+ */
+void array_2d_reserve_row(array_2d *a, int i, int n);
+
 #endif
@@ -0,0 +1,371 @@
+#ifndef __ARRAY_TYPED_H
+#define __ARRAY_TYPED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "allocator.h"
+
+/*
+ * Typed 1D and 2D arrays that store their values in the array itself
+ * instead of as void pointers. There is no free_function; a value is
+ * copied in by set and out by get, and a position that has never been
+ * set holds zero. This saves one heap allocation per value and lets a
+ * cell shrink to the size of the value type.
+ *
+ * The arrays are generated by the macros ARRAY_1D_TYPED(name, type)
+ * and ARRAY_2D_TYPED(name, type), which define the type name and the
+ * functions name_create(), name_low(), name_high(), name_get(),
+ * name_set() and name_kill(). The 2D arrays also have name_resize().
+ * As for array_2d, the dimension number d of the 2D name_low() and
+ * name_high() is 1 or 2.
+ * All functions are static inline, so this file has no corresponding
+ * .c file.
+ *
+ * The following arrays are predefined:
+ *
+ *   array_1d_int, array_2d_int - int values.
+ *   array_1d_u8,  array_2d_u8  - uint8_t values.
+ *   array_1d_ptr, array_2d_ptr - void * values (not freed by kill).
+ *   array_1d_bit, array_2d_bit - bool values stored one bit each.
+ *
+ * array_2d_bit also has array_2d_bit_next_in_row(), which finds the
+ * next set bit of a row a machine word at a time, and
+ * array_2d_bit_create_alloc(), which takes the memory of the array from
+ * an allocator.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: Added array_2d_bit_create_alloc.
+ *   v1.2 2026-10-18: The 2D name_low() and name_high() number the
+ *		      dimensions 1 and 2, like array_2d_low().
+ */
+
+// ==========INTERNAL HELPERS============
+
+/**
+ * array_typed_alloc() - Internal function to allocate cleared memory.
+ * @n: Number of elements.
+ * @size: Size of an element.
+ *
+ * Exits the program if not enough memory was available.
+ *
+ * Returns: A pointer to the memory.
+ */
+static inline void *array_typed_alloc(size_t n, size_t size)
+{
+	void *p=calloc(n > 0 ? n : 1, size);
+	if (p == NULL) {
+		fprintf(stderr, "array_typed: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	return p;
+}
+
+/**
+ * array_typed_alloc_from() - Internal function to allocate cleared memory from an allocator.
+ * @a: Allocator to use, or NULL for the default allocator.
+ * @n: Number of elements.
+ * @size: Size of an element.
+ *
+ * Exits the program if not enough memory was available.
+ *
+ * Returns: A pointer to the memory.
+ */
+static inline void *array_typed_alloc_from(const allocator *a, size_t n, size_t size)
+{
+	void *p=allocator_calloc(a, n > 0 ? n : 1, size);
+	if (p == NULL) {
+		fprintf(stderr, "array_typed: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	return p;
+}
+
+// ==========ARRAY GENERATORS============
+
+/**
+ * ARRAY_1D_TYPED() - Define a 1D array of values of a given type.
+ * @name: Name of the array type and prefix of its functions.
+ * @type: Type of the values.
+ */
+#define ARRAY_1D_TYPED(name, type)					\
+	typedef struct name {						\
+		int low;						\
+		int high;						\
+		type *values;						\
+	} name;								\
+									\
+	static inline name *name##_create(int lo, int hi)		\
+	{								\
+		name *a=array_typed_alloc(1, sizeof(*a));		\
+		a->low=lo;						\
+		a->high=hi;						\
+		a->values=array_typed_alloc(hi-lo+1, sizeof(type));	\
+		return a;						\
+	}								\
+									\
+	static inline int name##_low(const name *a)			\
+	{								\
+		return a->low;						\
+	}								\
+									\
+	static inline int name##_high(const name *a)			\
+	{								\
+		return a->high;						\
+	}								\
+									\
+	static inline type name##_get(const name *a, int i)		\
+	{								\
+		return a->values[i-a->low];				\
+	}								\
+									\
+	static inline void name##_set(name *a, type v, int i)		\
+	{								\
+		a->values[i-a->low]=v;					\
+	}								\
+									\
+	static inline void name##_kill(name *a)				\
+	{								\
+		free(a->values);					\
+		free(a);						\
+	}
+
+/**
+ * ARRAY_2D_TYPED() - Define a 2D array of values of a given type.
+ * @name: Name of the array type and prefix of its functions.
+ * @type: Type of the values.
+ *
+ * The values are stored row by row, i.e. the values with the same
+ * first index are adjacent in memory.
+ */
+#define ARRAY_2D_TYPED(name, type)					\
+	typedef struct name {						\
+		int low[2];						\
+		int high[2];						\
+		int cols;						\
+		type *values;						\
+	} name;								\
+									\
+	static inline name *name##_create(int lo1, int hi1, int lo2, int hi2) \
+	{								\
+		name *a=array_typed_alloc(1, sizeof(*a));		\
+		a->low[0]=lo1;						\
+		a->low[1]=lo2;						\
+		a->high[0]=hi1;						\
+		a->high[1]=hi2;						\
+		a->cols=hi2-lo2+1;					\
+		a->values=array_typed_alloc((size_t)(hi1-lo1+1) * a->cols, sizeof(type)); \
+		return a;						\
+	}								\
+									\
+	static inline int name##_low(const name *a, int d)		\
+	{								\
+		return a->low[d-1];					\
+	}								\
+									\
+	static inline int name##_high(const name *a, int d)		\
+	{								\
+		return a->high[d-1];					\
+	}								\
+									\
+	static inline type name##_get(const name *a, int i, int j)	\
+	{								\
+		return a->values[(size_t)(i-a->low[0]) * a->cols + (j-a->low[1])]; \
+	}								\
+									\
+	static inline void name##_set(name *a, type v, int i, int j)	\
+	{								\
+		a->values[(size_t)(i-a->low[0]) * a->cols + (j-a->low[1])]=v; \
+	}								\
+									\
+	static inline void name##_resize(name *a, int hi1, int hi2)	\
+	{								\
+		int rows=hi1-a->low[0]+1;				\
+		int cols=hi2-a->low[1]+1;				\
+		type *values=array_typed_alloc((size_t)rows * cols, sizeof(type)); \
+		for (int r=0; r<rows && r<=a->high[0]-a->low[0]; r++) { \
+			memcpy(&values[(size_t)r * cols],		\
+			       &a->values[(size_t)r * a->cols],		\
+			       (cols < a->cols ? cols : a->cols) * sizeof(type)); \
+		}							\
+		free(a->values);					\
+		a->values=values;					\
+		a->high[0]=hi1;						\
+		a->high[1]=hi2;						\
+		a->cols=cols;						\
+	}								\
+									\
+	static inline void name##_kill(name *a)				\
+	{								\
+		free(a->values);					\
+		free(a);						\
+	}
+
+ARRAY_1D_TYPED(array_1d_int, int)
+ARRAY_1D_TYPED(array_1d_u8, uint8_t)
+ARRAY_1D_TYPED(array_1d_ptr, void *)
+
+ARRAY_2D_TYPED(array_2d_int, int)
+ARRAY_2D_TYPED(array_2d_u8, uint8_t)
+ARRAY_2D_TYPED(array_2d_ptr, void *)
+
+// ==========BIT ARRAYS============
+
+/*
+ * Bit arrays pack 64 values into every word. A 2D bit array pads each
+ * row to a whole number of words, so that rows can be scanned word by
+ * word.
+ */
+
+#define ARRAY_BIT_WORD 64
+
+// Number of words needed for n bits.
+#define ARRAY_BIT_WORDS(n) (((size_t)(n) + ARRAY_BIT_WORD - 1) / ARRAY_BIT_WORD)
+
+typedef struct array_1d_bit {
+	int low;
+	int high;
+	uint64_t *words;
+} array_1d_bit;
+
+static inline array_1d_bit *array_1d_bit_create(int lo, int hi)
+{
+	array_1d_bit *a=array_typed_alloc(1, sizeof(*a));
+	a->low=lo;
+	a->high=hi;
+	a->words=array_typed_alloc(ARRAY_BIT_WORDS(hi-lo+1), sizeof(uint64_t));
+	return a;
+}
+
+static inline bool array_1d_bit_get(const array_1d_bit *a, int i)
+{
+	int k=i-a->low;
+	return (a->words[k / ARRAY_BIT_WORD] >> (k % ARRAY_BIT_WORD)) & 1;
+}
+
+static inline void array_1d_bit_set(array_1d_bit *a, bool v, int i)
+{
+	int k=i-a->low;
+	uint64_t mask=(uint64_t)1 << (k % ARRAY_BIT_WORD);
+	if (v) {
+		a->words[k / ARRAY_BIT_WORD]|=mask;
+	} else {
+		a->words[k / ARRAY_BIT_WORD]&=~mask;
+	}
+}
+
+static inline void array_1d_bit_kill(array_1d_bit *a)
+{
+	free(a->words);
+	free(a);
+}
+
+typedef struct array_2d_bit {
+	int low[2];
+	int high[2];
+	size_t row_words; // Words per row.
+	uint64_t *words;
+	const allocator *alloc; // Allocator for the array and its words.
+} array_2d_bit;
+
+static inline array_2d_bit *array_2d_bit_create_alloc(int lo1, int hi1, int lo2, int hi2,
+						      const allocator *alloc)
+{
+	array_2d_bit *a=array_typed_alloc_from(alloc, 1, sizeof(*a));
+	a->alloc=alloc;
+	a->low[0]=lo1;
+	a->low[1]=lo2;
+	a->high[0]=hi1;
+	a->high[1]=hi2;
+	a->row_words=ARRAY_BIT_WORDS(hi2-lo2+1);
+	a->words=array_typed_alloc_from(alloc, (size_t)(hi1-lo1+1) * a->row_words,
+					sizeof(uint64_t));
+	return a;
+}
+
+static inline array_2d_bit *array_2d_bit_create(int lo1, int hi1, int lo2, int hi2)
+{
+	return array_2d_bit_create_alloc(lo1, hi1, lo2, hi2, NULL);
+}
+
+static inline bool array_2d_bit_get(const array_2d_bit *a, int i, int j)
+{
+	const uint64_t *row=&a->words[(size_t)(i-a->low[0]) * a->row_words];
+	int k=j-a->low[1];
+	return (row[k / ARRAY_BIT_WORD] >> (k % ARRAY_BIT_WORD)) & 1;
+}
+
+static inline void array_2d_bit_set(array_2d_bit *a, bool v, int i, int j)
+{
+	uint64_t *row=&a->words[(size_t)(i-a->low[0]) * a->row_words];
+	int k=j-a->low[1];
+	uint64_t mask=(uint64_t)1 << (k % ARRAY_BIT_WORD);
+	if (v) {
+		row[k / ARRAY_BIT_WORD]|=mask;
+	} else {
+		row[k / ARRAY_BIT_WORD]&=~mask;
+	}
+}
+
+/**
+ * array_2d_bit_next_in_row() - Find the next set bit in a row.
+ * @a: array to inspect.
+ * @i: first index of the row.
+ * @j: second index to search after, or lo2-1 to search from the start.
+ *
+ * Returns: The smallest second index larger than j that is set in row
+ *	    i, or hi2+1 if there is none.
+ */
+static inline int array_2d_bit_next_in_row(const array_2d_bit *a, int i, int j)
+{
+	const uint64_t *row=&a->words[(size_t)(i-a->low[0]) * a->row_words];
+	size_t k=j+1-a->low[1];
+	size_t w=k / ARRAY_BIT_WORD;
+	if (w >= a->row_words) {
+		return a->high[1]+1;
+	}
+	// Mask off the bits before k in the first word.
+	uint64_t bits=row[w] & (~(uint64_t)0 << (k % ARRAY_BIT_WORD));
+	while (bits == 0) {
+		if (++w == a->row_words) {
+			return a->high[1]+1;
+		}
+		bits=row[w];
+	}
+	int found=(int)(w * ARRAY_BIT_WORD) + __builtin_ctzll(bits) + a->low[1];
+	return found <= a->high[1] ? found : a->high[1]+1;
+}
+
+static inline void array_2d_bit_resize(array_2d_bit *a, int hi1, int hi2)
+{
+	int rows=hi1-a->low[0]+1;
+	size_t row_words=ARRAY_BIT_WORDS(hi2-a->low[1]+1);
+	uint64_t *words=array_typed_alloc_from(a->alloc, (size_t)rows * row_words, sizeof(uint64_t));
+	size_t copy=row_words < a->row_words ? row_words : a->row_words;
+	for (int r=0; r<rows && r<=a->high[0]-a->low[0]; r++) {
+		memcpy(&words[r * row_words], &a->words[r * a->row_words], copy * sizeof(uint64_t));
+	}
+	allocator_free(a->alloc, a->words);
+	a->words=words;
+	a->row_words=row_words;
+	a->high[0]=hi1;
+	a->high[1]=hi2;
+	// Clear the bits beyond the new high limit of the second index.
+	int k=hi2-a->low[1]+1;
+	if (k % ARRAY_BIT_WORD != 0) {
+		for (int r=0; r<rows; r++) {
+			words[r * row_words + k / ARRAY_BIT_WORD]&=~(~(uint64_t)0 << (k % ARRAY_BIT_WORD));
+		}
+	}
+}
+
+static inline void array_2d_bit_kill(array_2d_bit *a)
+{
+	allocator_free(a->alloc, a->words);
+	allocator_free(a->alloc, a);
+}
+
+#endif
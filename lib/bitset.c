@@ -0,0 +1,591 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <bitset.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BITSET_X86 1
+#include <immintrin.h>
+#endif
+
+/*
+ * Implementation of a dense bitset with runtime-dispatched SIMD bulk
+ * operations.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: The bulk operations stop at the shorter word array.
+ *		      Added bitset_use_implementation.
+ *   v1.2 2026-10-18: Memory may come from an allocator.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Bits per word.
+#define WORD_BITS 64
+
+// The words are allocated in blocks of one AVX2 register, aligned to
+// the register size, so that the vector loops need no tail handling.
+#define BLOCK_WORDS 4
+#define BLOCK_BYTES (BLOCK_WORDS * sizeof(uint64_t))
+
+/*
+ * Bit i is bit i%64 of word i/64. The bits from size up to the end of
+ * the allocated words are always clear, so the bulk operations can work
+ * on whole blocks.
+ */
+struct bitset {
+	uint64_t *words;
+	int size; // Number of bits.
+	size_t n_words; // Number of allocated words, a multiple of BLOCK_WORDS.
+	void *block; // The memory holding the words, freed with the allocator.
+	const allocator *alloc; // Allocator for the bitset and its words.
+};
+
+// Bulk operations on n words, n a multiple of BLOCK_WORDS.
+struct bitset_ops {
+	const char *name;
+	void (*or_words)(uint64_t *dst, const uint64_t *src, size_t n);
+	void (*and_words)(uint64_t *dst, const uint64_t *src, size_t n);
+	void (*andnot_words)(uint64_t *dst, const uint64_t *src, size_t n);
+	size_t (*count_words)(const uint64_t *w, size_t n);
+};
+
+// ===========SCALAR IMPLEMENTATION============
+
+static void or_scalar(uint64_t *dst, const uint64_t *src, size_t n)
+{
+	for (size_t i=0; i<n; i++) {
+		dst[i]|=src[i];
+	}
+}
+
+static void and_scalar(uint64_t *dst, const uint64_t *src, size_t n)
+{
+	for (size_t i=0; i<n; i++) {
+		dst[i]&=src[i];
+	}
+}
+
+static void andnot_scalar(uint64_t *dst, const uint64_t *src, size_t n)
+{
+	for (size_t i=0; i<n; i++) {
+		dst[i]&=~src[i];
+	}
+}
+
+static size_t count_scalar(const uint64_t *w, size_t n)
+{
+	size_t count=0;
+	for (size_t i=0; i<n; i++) {
+		count+=__builtin_popcountll(w[i]);
+	}
+	return count;
+}
+
+static const struct bitset_ops scalar_ops={
+	"scalar", or_scalar, and_scalar, andnot_scalar, count_scalar
+};
+
+#ifdef BITSET_X86
+
+// ===========SSE2 IMPLEMENTATION============
+
+__attribute__((target("sse2")))
+static void or_sse2(uint64_t *dst, const uint64_t *src, size_t n)
+{
+	for (size_t i=0; i<n; i+=2) {
+		__m128i a=_mm_load_si128((const __m128i *)&dst[i]);
+		__m128i b=_mm_load_si128((const __m128i *)&src[i]);
+		_mm_store_si128((__m128i *)&dst[i], _mm_or_si128(a, b));
+	}
+}
+
+__attribute__((target("sse2")))
+static void and_sse2(uint64_t *dst, const uint64_t *src, size_t n)
+{
+	for (size_t i=0; i<n; i+=2) {
+		__m128i a=_mm_load_si128((const __m128i *)&dst[i]);
+		__m128i b=_mm_load_si128((const __m128i *)&src[i]);
+		_mm_store_si128((__m128i *)&dst[i], _mm_and_si128(a, b));
+	}
+}
+
+__attribute__((target("sse2")))
+static void andnot_sse2(uint64_t *dst, const uint64_t *src, size_t n)
+{
+	for (size_t i=0; i<n; i+=2) {
+		__m128i a=_mm_load_si128((const __m128i *)&dst[i]);
+		__m128i b=_mm_load_si128((const __m128i *)&src[i]);
+		// _mm_andnot_si128 negates its first argument.
+		_mm_store_si128((__m128i *)&dst[i], _mm_andnot_si128(b, a));
+	}
+}
+
+/*
+ * SSE2 has no byte shuffle, so the bits are counted with the usual
+ * shift-and-add reduction to byte counts, and the bytes are summed with
+ * _mm_sad_epu8.
+ */
+__attribute__((target("sse2")))
+static size_t count_sse2(const uint64_t *w, size_t n)
+{
+	const __m128i m1=_mm_set1_epi8(0x55);
+	const __m128i m2=_mm_set1_epi8(0x33);
+	const __m128i m4=_mm_set1_epi8(0x0f);
+	__m128i total=_mm_setzero_si128();
+
+	for (size_t i=0; i<n; i+=2) {
+		__m128i x=_mm_load_si128((const __m128i *)&w[i]);
+		x=_mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi64(x, 1), m1));
+		x=_mm_add_epi8(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi64(x, 2), m2));
+		x=_mm_and_si128(_mm_add_epi8(x, _mm_srli_epi64(x, 4)), m4);
+		total=_mm_add_epi64(total, _mm_sad_epu8(x, _mm_setzero_si128()));
+	}
+
+	uint64_t lanes[2];
+	_mm_storeu_si128((__m128i *)lanes, total);
+	return lanes[0] + lanes[1];
+}
+
+static const struct bitset_ops sse2_ops={
+	"sse2", or_sse2, and_sse2, andnot_sse2, count_sse2
+};
+
+// ===========AVX2 IMPLEMENTATION============
+
+__attribute__((target("avx2")))
+static void or_avx2(uint64_t *dst, const uint64_t *src, size_t n)
+{
+	for (size_t i=0; i<n; i+=BLOCK_WORDS) {
+		__m256i a=_mm256_load_si256((const __m256i *)&dst[i]);
+		__m256i b=_mm256_load_si256((const __m256i *)&src[i]);
+		_mm256_store_si256((__m256i *)&dst[i], _mm256_or_si256(a, b));
+	}
+}
+
+__attribute__((target("avx2")))
+static void and_avx2(uint64_t *dst, const uint64_t *src, size_t n)
+{
+	for (size_t i=0; i<n; i+=BLOCK_WORDS) {
+		__m256i a=_mm256_load_si256((const __m256i *)&dst[i]);
+		__m256i b=_mm256_load_si256((const __m256i *)&src[i]);
+		_mm256_store_si256((__m256i *)&dst[i], _mm256_and_si256(a, b));
+	}
+}
+
+__attribute__((target("avx2")))
+static void andnot_avx2(uint64_t *dst, const uint64_t *src, size_t n)
+{
+	for (size_t i=0; i<n; i+=BLOCK_WORDS) {
+		__m256i a=_mm256_load_si256((const __m256i *)&dst[i]);
+		__m256i b=_mm256_load_si256((const __m256i *)&src[i]);
+		_mm256_store_si256((__m256i *)&dst[i], _mm256_andnot_si256(b, a));
+	}
+}
+
+/*
+ * The bits of every nibble are counted with a 16-entry lookup table in
+ * a byte shuffle (W. Mula's method), and the byte counts are summed
+ * with _mm256_sad_epu8.
+ */
+__attribute__((target("avx2")))
+static size_t count_avx2(const uint64_t *w, size_t n)
+{
+	const __m256i table=_mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+					     0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low=_mm256_set1_epi8(0x0f);
+	__m256i total=_mm256_setzero_si256();
+
+	for (size_t i=0; i<n; i+=BLOCK_WORDS) {
+		__m256i x=_mm256_load_si256((const __m256i *)&w[i]);
+		__m256i lo=_mm256_shuffle_epi8(table, _mm256_and_si256(x, low));
+		__m256i hi=_mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(x, 4), low));
+		__m256i bytes=_mm256_add_epi8(lo, hi);
+		total=_mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+	}
+
+	uint64_t lanes[4];
+	_mm256_storeu_si256((__m256i *)lanes, total);
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+static const struct bitset_ops avx2_ops={
+	"avx2", or_avx2, and_avx2, andnot_avx2, count_avx2
+};
+
+#endif
+
+// ===========DISPATCH============
+
+// The bulk operations in use.
+static const struct bitset_ops *ops=&scalar_ops;
+
+#ifdef BITSET_X86
+/**
+ * bitset_select_ops() - Internal function to select the bulk operations.
+ *
+ * Runs before main(), so the choice is made before any thread starts.
+ *
+ * Returns: Nothing.
+ */
+__attribute__((constructor))
+static void bitset_select_ops(void)
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		ops=&avx2_ops;
+	} else if (__builtin_cpu_supports("sse2")) {
+		ops=&sse2_ops;
+	}
+}
+#endif
+
+// The implementations, in order of preference.
+static const struct bitset_ops *const all_ops[]={
+#ifdef BITSET_X86
+	&avx2_ops, &sse2_ops,
+#endif
+	&scalar_ops
+};
+
+/**
+ * bitset_cpu_supports() - Internal function to check if the processor runs an implementation.
+ * @o: Bulk operations.
+ *
+ * Returns: True if the bulk operations can be used.
+ */
+static bool bitset_cpu_supports(const struct bitset_ops *o)
+{
+#ifdef BITSET_X86
+	__builtin_cpu_init();
+	if (o == &avx2_ops) {
+		return __builtin_cpu_supports("avx2");
+	}
+	if (o == &sse2_ops) {
+		return __builtin_cpu_supports("sse2");
+	}
+#endif
+	return o == &scalar_ops;
+}
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * words_for() - Internal function to compute the words needed for n bits.
+ * @n: Number of bits.
+ *
+ * Returns: The number of words, a multiple of BLOCK_WORDS and at least
+ *	    BLOCK_WORDS.
+ */
+static size_t words_for(int n)
+{
+	size_t words=((size_t)(n > 0 ? n : 0) + WORD_BITS - 1) / WORD_BITS;
+	words=(words + BLOCK_WORDS - 1) / BLOCK_WORDS * BLOCK_WORDS;
+	return words > 0 ? words : BLOCK_WORDS;
+}
+
+/**
+ * alloc_words() - Internal function to allocate cleared, aligned words.
+ * @b: Bitset the words are for.
+ * @n_words: Number of words.
+ * @block: Set to the memory to free when the words are no longer used.
+ *
+ * The allocators only align to 16 bytes, so a block more is allocated
+ * to find an aligned start in.
+ *
+ * Returns: A pointer to the words.
+ */
+static uint64_t *alloc_words(const bitset *b, size_t n_words, void **block)
+{
+	char *p=allocator_alloc(b->alloc, n_words * sizeof(uint64_t) + BLOCK_BYTES);
+	if (p == NULL) {
+		fprintf(stderr, "bitset: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	*block=p;
+	uint64_t *words=(uint64_t *)(((uintptr_t)p + BLOCK_BYTES - 1) & ~(uintptr_t)(BLOCK_BYTES - 1));
+	memset(words, 0, n_words * sizeof(uint64_t));
+	return words;
+}
+
+/**
+ * common_words() - Internal function to compute the words two bitsets both have.
+ * @a: First bitset.
+ * @b: Second bitset.
+ *
+ * A bitset that was shrunk keeps its words, so two bitsets of the same
+ * size may have a different number of words.
+ *
+ * Returns: The smaller number of words, a multiple of BLOCK_WORDS.
+ */
+static size_t common_words(const bitset *a, const bitset *b)
+{
+	return (a->n_words < b->n_words) ? a->n_words : b->n_words;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * bitset_empty() - Create a bitset with all bits cleared.
+ * @n: Number of bits.
+ *
+ * Returns: A pointer to the new bitset.
+ */
+bitset *bitset_empty(int n)
+{
+	return bitset_empty_alloc(n, NULL);
+}
+
+/**
+ * bitset_empty_alloc() - Create a bitset with all bits cleared that uses an allocator.
+ * @n: Number of bits.
+ * @a: Allocator for the bitset, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new bitset.
+ */
+bitset *bitset_empty_alloc(int n, const allocator *a)
+{
+	bitset *b=allocator_alloc(a, sizeof(*b));
+	if (b == NULL) {
+		fprintf(stderr, "bitset: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	b->alloc=a;
+	b->size=n;
+	b->n_words=words_for(n);
+	b->words=alloc_words(b, b->n_words, &b->block);
+	return b;
+}
+
+/**
+ * bitset_size() - Return the number of bits in a bitset.
+ * @b: Bitset to inspect.
+ *
+ * Returns: The number of bits.
+ */
+int bitset_size(const bitset *b)
+{
+	return b->size;
+}
+
+/**
+ * bitset_resize() - Change the number of bits in a bitset.
+ * @b: Bitset to modify.
+ * @n: New number of bits.
+ *
+ * Bits below both the old and the new size keep their value, new bits
+ * are cleared.
+ *
+ * Returns: Nothing.
+ */
+void bitset_resize(bitset *b, int n)
+{
+	size_t n_words=words_for(n);
+	if (n_words > b->n_words) {
+		void *block;
+		uint64_t *words=alloc_words(b, n_words, &block);
+		memcpy(words, b->words, b->n_words * sizeof(uint64_t));
+		allocator_free(b->alloc, b->block);
+		b->block=block;
+		b->words=words;
+		b->n_words=n_words;
+	}
+	if (n < b->size) {
+		// Clear the removed bits to keep the padding clear.
+		size_t first=n / WORD_BITS;
+		if (n % WORD_BITS != 0) {
+			b->words[first]&=~(~(uint64_t)0 << (n % WORD_BITS));
+			first++;
+		}
+		memset(&b->words[first], 0, (b->n_words - first) * sizeof(uint64_t));
+	}
+	b->size=n;
+}
+
+/**
+ * bitset_test() - Check if a bit is set.
+ * @b: Bitset to inspect.
+ * @i: Index of the bit.
+ *
+ * Returns: True if the bit is set, otherwise false.
+ */
+bool bitset_test(const bitset *b, int i)
+{
+	return (b->words[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+}
+
+/**
+ * bitset_set() - Set a bit.
+ * @b: Bitset to modify.
+ * @i: Index of the bit.
+ *
+ * Returns: Nothing.
+ */
+void bitset_set(bitset *b, int i)
+{
+	b->words[i / WORD_BITS]|=(uint64_t)1 << (i % WORD_BITS);
+}
+
+/**
+ * bitset_clear() - Clear a bit.
+ * @b: Bitset to modify.
+ * @i: Index of the bit.
+ *
+ * Returns: Nothing.
+ */
+void bitset_clear(bitset *b, int i)
+{
+	b->words[i / WORD_BITS]&=~((uint64_t)1 << (i % WORD_BITS));
+}
+
+/**
+ * bitset_test_and_set() - Set a bit and return its old value.
+ * @b: Bitset to modify.
+ * @i: Index of the bit.
+ *
+ * Returns: True if the bit was already set, otherwise false.
+ */
+bool bitset_test_and_set(bitset *b, int i)
+{
+	uint64_t mask=(uint64_t)1 << (i % WORD_BITS);
+	uint64_t *w=&b->words[i / WORD_BITS];
+	bool was_set=(*w & mask) != 0;
+	*w|=mask;
+	return was_set;
+}
+
+/**
+ * bitset_clear_all() - Clear all bits.
+ * @b: Bitset to modify.
+ *
+ * Returns: Nothing.
+ */
+void bitset_clear_all(bitset *b)
+{
+	memset(b->words, 0, b->n_words * sizeof(uint64_t));
+}
+
+/**
+ * bitset_or() - Set the bits that are set in another bitset.
+ * @dst: Bitset to modify.
+ * @src: Bitset of the same size.
+ *
+ * Returns: Nothing.
+ */
+void bitset_or(bitset *dst, const bitset *src)
+{
+	// The words of src past its end are clear.
+	ops->or_words(dst->words, src->words, common_words(dst, src));
+}
+
+/**
+ * bitset_and() - Clear the bits that are clear in another bitset.
+ * @dst: Bitset to modify.
+ * @src: Bitset of the same size.
+ *
+ * Returns: Nothing.
+ */
+void bitset_and(bitset *dst, const bitset *src)
+{
+	size_t n=common_words(dst, src);
+	ops->and_words(dst->words, src->words, n);
+	// The words of src past its end are clear.
+	memset(&dst->words[n], 0, (dst->n_words - n) * sizeof(uint64_t));
+}
+
+/**
+ * bitset_andnot() - Clear the bits that are set in another bitset.
+ * @dst: Bitset to modify.
+ * @src: Bitset of the same size.
+ *
+ * Returns: Nothing.
+ */
+void bitset_andnot(bitset *dst, const bitset *src)
+{
+	// The words of src past its end are clear.
+	ops->andnot_words(dst->words, src->words, common_words(dst, src));
+}
+
+/**
+ * bitset_count() - Count the set bits.
+ * @b: Bitset to inspect.
+ *
+ * Returns: The number of set bits.
+ */
+int bitset_count(const bitset *b)
+{
+	return (int)ops->count_words(b->words, b->n_words);
+}
+
+/**
+ * bitset_next() - Find the next set bit.
+ * @b: Bitset to inspect.
+ * @i: Index to search after, or -1 to search from the start.
+ *
+ * Returns: The smallest index larger than i of a set bit, or the size
+ *	    of the bitset if there is none.
+ */
+int bitset_next(const bitset *b, int i)
+{
+	i++;
+	if (i >= b->size) {
+		return b->size;
+	}
+	size_t w=i / WORD_BITS;
+	// Mask off the bits before i in the first word.
+	uint64_t bits=b->words[w] & (~(uint64_t)0 << (i % WORD_BITS));
+	while (bits == 0) {
+		if (++w == b->n_words) {
+			return b->size;
+		}
+		bits=b->words[w];
+	}
+	// The padding is clear, so a set bit is always below size.
+	return (int)(w * WORD_BITS) + __builtin_ctzll(bits);
+}
+
+/**
+ * bitset_kill() - Destroy a given bitset.
+ * @b: Bitset to destroy.
+ *
+ * Returns: Nothing.
+ */
+void bitset_kill(bitset *b)
+{
+	allocator_free(b->alloc, b->block);
+	allocator_free(b->alloc, b);
+}
+
+/**
+ * bitset_implementation() - Name the implementation of the bulk operations.
+ *
+ * Returns: "avx2", "sse2" or "scalar".
+ */
+const char *bitset_implementation(void)
+{
+	return ops->name;
+}
+
+/**
+ * bitset_use_implementation() - Select the implementation of the bulk operations.
+ * @name: "avx2", "sse2" or "scalar".
+ *
+ * Meant for tests and benchmarks that compare the implementations. Must
+ * not be called while another thread uses a bitset.
+ *
+ * Returns: True if the implementation exists and the processor supports
+ *	    it, otherwise false and the implementation is not changed.
+ */
+bool bitset_use_implementation(const char *name)
+{
+	for (size_t i=0; i<sizeof(all_ops) / sizeof(all_ops[0]); i++) {
+		if (strcmp(name, all_ops[i]->name) == 0 && bitset_cpu_supports(all_ops[i])) {
+			ops=all_ops[i];
+			return true;
+		}
+	}
+	return false;
+}
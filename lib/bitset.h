@@ -0,0 +1,190 @@
+#ifndef __BITSET_H
+#define __BITSET_H
+
+#include <stdbool.h>
+#include "util.h"
+#include "allocator.h"
+
+/*
+ * Declaration of a dense bitset, e.g. for visited sets and frontiers
+ * of graph searches. A bitset of size n holds the bits 0, 1, ..., n-1,
+ * all cleared when the bitset is created.
+ *
+ * The bulk operations (or, and, andnot and count) work on 256 bits at
+ * a time with AVX2 or 128 bits at a time with SSE2 when the processor
+ * supports it, and a machine word at a time otherwise. The
+ * implementation is chosen once at program start, see
+ * bitset_implementation(). Single bit operations are plain word
+ * operations.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: Added bitset_use_implementation.
+ *   v1.2 2026-10-18: Added bitset_empty_alloc.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Bitset type.
+typedef struct bitset bitset;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * bitset_empty() - Create a bitset with all bits cleared.
+ * @n: Number of bits.
+ *
+ * Returns: A pointer to the new bitset.
+ */
+bitset *bitset_empty(int n);
+
+/**
+ * bitset_empty_alloc() - Create a bitset with all bits cleared that uses an allocator.
+ * @n: Number of bits.
+ * @a: Allocator for the bitset, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new bitset.
+ */
+bitset *bitset_empty_alloc(int n, const allocator *a);
+
+/**
+ * bitset_size() - Return the number of bits in a bitset.
+ * @b: Bitset to inspect.
+ *
+ * Returns: The number of bits.
+ */
+int bitset_size(const bitset *b);
+
+/**
+ * bitset_resize() - Change the number of bits in a bitset.
+ * @b: Bitset to modify.
+ * @n: New number of bits.
+ *
+ * Bits below both the old and the new size keep their value, new bits
+ * are cleared.
+ *
+ * Returns: Nothing.
+ */
+void bitset_resize(bitset *b, int n);
+
+/**
+ * bitset_test() - Check if a bit is set.
+ * @b: Bitset to inspect.
+ * @i: Index of the bit.
+ *
+ * Returns: True if the bit is set, otherwise false.
+ */
+bool bitset_test(const bitset *b, int i);
+
+/**
+ * bitset_set() - Set a bit.
+ * @b: Bitset to modify.
+ * @i: Index of the bit.
+ *
+ * Returns: Nothing.
+ */
+void bitset_set(bitset *b, int i);
+
+/**
+ * bitset_clear() - Clear a bit.
+ * @b: Bitset to modify.
+ * @i: Index of the bit.
+ *
+ * Returns: Nothing.
+ */
+void bitset_clear(bitset *b, int i);
+
+/**
+ * bitset_test_and_set() - Set a bit and return its old value.
+ * @b: Bitset to modify.
+ * @i: Index of the bit.
+ *
+ * Returns: True if the bit was already set, otherwise false.
+ */
+bool bitset_test_and_set(bitset *b, int i);
+
+/**
+ * bitset_clear_all() - Clear all bits.
+ * @b: Bitset to modify.
+ *
+ * Returns: Nothing.
+ */
+void bitset_clear_all(bitset *b);
+
+/**
+ * bitset_or() - Set the bits that are set in another bitset.
+ * @dst: Bitset to modify.
+ * @src: Bitset of the same size.
+ *
+ * Returns: Nothing.
+ */
+void bitset_or(bitset *dst, const bitset *src);
+
+/**
+ * bitset_and() - Clear the bits that are clear in another bitset.
+ * @dst: Bitset to modify.
+ * @src: Bitset of the same size.
+ *
+ * Returns: Nothing.
+ */
+void bitset_and(bitset *dst, const bitset *src);
+
+/**
+ * bitset_andnot() - Clear the bits that are set in another bitset.
+ * @dst: Bitset to modify.
+ * @src: Bitset of the same size.
+ *
+ * Returns: Nothing.
+ */
+void bitset_andnot(bitset *dst, const bitset *src);
+
+/**
+ * bitset_count() - Count the set bits.
+ * @b: Bitset to inspect.
+ *
+ * Returns: The number of set bits.
+ */
+int bitset_count(const bitset *b);
+
+/**
+ * bitset_next() - Find the next set bit.
+ * @b: Bitset to inspect.
+ * @i: Index to search after, or -1 to search from the start.
+ *
+ * Iterate over the set bits with:
+ *
+ *	for (i = bitset_next(b, -1); i < bitset_size(b); i = bitset_next(b, i))
+ *
+ * Returns: The smallest index larger than i of a set bit, or the size
+ *	    of the bitset if there is none.
+ */
+int bitset_next(const bitset *b, int i);
+
+/**
+ * bitset_kill() - Destroy a given bitset.
+ * @b: Bitset to destroy.
+ *
+ * Returns: Nothing.
+ */
+void bitset_kill(bitset *b);
+
+/**
+ * bitset_implementation() - Name the implementation of the bulk operations.
+ *
+ * Returns: "avx2", "sse2" or "scalar".
+ */
+const char *bitset_implementation(void);
+
+/**
+ * bitset_use_implementation() - Select the implementation of the bulk operations.
+ * @name: "avx2", "sse2" or "scalar".
+ *
+ * Meant for tests and benchmarks that compare the implementations. Must
+ * not be called while another thread uses a bitset.
+ *
+ * Returns: True if the implementation exists and the processor supports
+ *	    it, otherwise false and the implementation is not changed.
+ */
+bool bitset_use_implementation(const char *name);
+
+#endif
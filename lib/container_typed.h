@@ -0,0 +1,341 @@
+#ifndef __CONTAINER_TYPED_H
+#define __CONTAINER_TYPED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "allocator.h"
+
+/*
+ * Macro "templates" for containers specialized to one value type. The
+ * generic containers in this directory store void pointers and call a
+ * free_function through a pointer, so every access goes through an
+ * extra indirection and cannot be inlined. The containers generated
+ * here store the values themselves, have no free_function, and only
+ * consist of static inline functions, so the compiler can inline and
+ * optimize loops over them like loops over plain arrays.
+ *
+ * The interfaces follow the generic containers:
+ *
+ *   VEC_TYPED(name, type) - Growable array. name_empty(),
+ *	name_empty_alloc(), name_size(), name_get(), name_set(),
+ *	name_reserve(), name_push(), name_pop(), name_clear(), name_kill().
+ *
+ *   QUEUE_TYPED(name, type) - FIFO queue in a growable circular array.
+ *	name_empty(), name_empty_alloc(), name_is_empty(), name_size(),
+ *	name_enqueue(), name_front(), name_dequeue(), name_clear(),
+ *	name_kill().
+ *
+ *   DLIST_TYPED(name, type) - Doubly linked list with the positions of
+ *	dlist.h. name_empty(), name_empty_alloc(), name_is_empty(),
+ *	name_first(), name_next(), name_is_end(), name_inspect(),
+ *	name_insert(), name_remove(), name_kill(). Positions are of type
+ *	name_pos.
+ *
+ * name_empty_alloc() takes all memory of the container, including the
+ * cells of a list, from an allocator. name_empty() uses the default
+ * allocator.
+ *
+ * The instances vec_u32 and queue_u32 are predefined. Other instances
+ * are stamped out where they are needed, e.g.
+ *
+ *	DLIST_TYPED(dlist_nodeptr, node *)
+ *
+ * Unlike the generic queue, name_dequeue() returns the removed value.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: Added name_reserve() to VEC_TYPED.
+ *   v1.2 2026-10-18: Added name_empty_alloc() to VEC_TYPED.
+ *   v1.3 2026-10-18: Added name_empty_alloc() to QUEUE_TYPED and
+ *                    DLIST_TYPED.
+ */
+
+// ==========INTERNAL HELPERS============
+
+/**
+ * container_typed_realloc_from() - Internal function to resize memory from an allocator.
+ * @a: Allocator to use, or NULL for the default allocator.
+ * @p: Memory to resize, or NULL.
+ * @old_size: Current size in bytes, 0 if p is NULL.
+ * @size: New size in bytes.
+ *
+ * Exits the program if not enough memory was available.
+ *
+ * Returns: A pointer to the resized memory.
+ */
+static inline void *container_typed_realloc_from(const allocator *a, void *p, size_t old_size,
+						 size_t size)
+{
+	p=allocator_realloc(a, p, old_size, size);
+	if (p == NULL) {
+		fprintf(stderr, "container_typed: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	return p;
+}
+
+// ==========CONTAINER GENERATORS============
+
+/**
+ * VEC_TYPED() - Define a growable array of values of a given type.
+ * @name: Name of the container type and prefix of its functions.
+ * @type: Type of the values.
+ *
+ * Indices run from 0 to name_size()-1.
+ */
+#define VEC_TYPED(name, type)						\
+	typedef struct name {						\
+		type *values;						\
+		int size;						\
+		int capacity;						\
+		const allocator *alloc;					\
+	} name;								\
+									\
+	static inline name *name##_empty_alloc(const allocator *a)	\
+	{								\
+		name *v=container_typed_realloc_from(a, NULL, 0, sizeof(*v)); \
+		v->values=NULL;						\
+		v->size=0;						\
+		v->capacity=0;						\
+		v->alloc=a;						\
+		return v;						\
+	}								\
+									\
+	static inline name *name##_empty(void)				\
+	{								\
+		return name##_empty_alloc(NULL);			\
+	}								\
+									\
+	static inline int name##_size(const name *v)			\
+	{								\
+		return v->size;						\
+	}								\
+									\
+	static inline type name##_get(const name *v, int i)		\
+	{								\
+		return v->values[i];					\
+	}								\
+									\
+	static inline void name##_set(name *v, type x, int i)		\
+	{								\
+		v->values[i]=x;						\
+	}								\
+									\
+	static inline void name##_reserve(name *v, int n)		\
+	{								\
+		if (n > v->capacity) {					\
+			v->values=container_typed_realloc_from(v->alloc, v->values, \
+				v->capacity * sizeof(type), n * sizeof(type)); \
+			v->capacity=n;					\
+		}							\
+	}								\
+									\
+	static inline void name##_push(name *v, type x)			\
+	{								\
+		if (v->size == v->capacity) {				\
+			int capacity=v->capacity == 0 ? 16 : 2*v->capacity; \
+			v->values=container_typed_realloc_from(v->alloc, v->values, \
+				v->capacity * sizeof(type), capacity * sizeof(type)); \
+			v->capacity=capacity;				\
+		}							\
+		v->values[v->size++]=x;					\
+	}								\
+									\
+	static inline type name##_pop(name *v)				\
+	{								\
+		return v->values[--v->size];				\
+	}								\
+									\
+	static inline void name##_clear(name *v)			\
+	{								\
+		v->size=0;						\
+	}								\
+									\
+	static inline void name##_kill(name *v)				\
+	{								\
+		allocator_free(v->alloc, v->values);			\
+		allocator_free(v->alloc, v);				\
+	}
+
+/**
+ * QUEUE_TYPED() - Define a FIFO queue of values of a given type.
+ * @name: Name of the container type and prefix of its functions.
+ * @type: Type of the values.
+ *
+ * The values are stored in a circular array whose capacity is a power
+ * of two, doubled when the queue is full.
+ */
+#define QUEUE_TYPED(name, type)						\
+	typedef struct name {						\
+		type *values;						\
+		int capacity;						\
+		int front;						\
+		int size;						\
+		const allocator *alloc;					\
+	} name;								\
+									\
+	static inline name *name##_empty_alloc(const allocator *a)	\
+	{								\
+		name *q=container_typed_realloc_from(a, NULL, 0, sizeof(*q)); \
+		q->capacity=16;						\
+		q->values=container_typed_realloc_from(a, NULL, 0,	\
+			q->capacity * sizeof(type));			\
+		q->front=0;						\
+		q->size=0;						\
+		q->alloc=a;						\
+		return q;						\
+	}								\
+									\
+	static inline name *name##_empty(void)				\
+	{								\
+		return name##_empty_alloc(NULL);			\
+	}								\
+									\
+	static inline bool name##_is_empty(const name *q)		\
+	{								\
+		return q->size == 0;					\
+	}								\
+									\
+	static inline int name##_size(const name *q)			\
+	{								\
+		return q->size;						\
+	}								\
+									\
+	static inline void name##_enqueue(name *q, type x)		\
+	{								\
+		if (q->size == q->capacity) {				\
+			/* Double and move the wrapped part after the old end. */ \
+			q->values=container_typed_realloc_from(q->alloc, q->values, \
+				q->capacity * sizeof(type),		\
+				2 * q->capacity * sizeof(type));	\
+			for (int i=0; i<q->front; i++) {		\
+				q->values[q->capacity+i]=q->values[i];	\
+			}						\
+			q->capacity*=2;					\
+		}							\
+		q->values[(q->front+q->size) & (q->capacity-1)]=x;	\
+		q->size++;						\
+	}								\
+									\
+	static inline type name##_front(const name *q)			\
+	{								\
+		return q->values[q->front];				\
+	}								\
+									\
+	static inline type name##_dequeue(name *q)			\
+	{								\
+		type x=q->values[q->front];				\
+		q->front=(q->front+1) & (q->capacity-1);		\
+		q->size--;						\
+		return x;						\
+	}								\
+									\
+	static inline void name##_clear(name *q)			\
+	{								\
+		q->front=0;						\
+		q->size=0;						\
+	}								\
+									\
+	static inline void name##_kill(name *q)				\
+	{								\
+		allocator_free(q->alloc, q->values);			\
+		allocator_free(q->alloc, q);				\
+	}
+
+/**
+ * DLIST_TYPED() - Define a doubly linked list of values of a given type.
+ * @name: Name of the container type and prefix of its functions.
+ * @type: Type of the values.
+ *
+ * Like dlist.h, a position is the cell before the value, so that the
+ * end of the list is a position too.
+ */
+#define DLIST_TYPED(name, type)						\
+	typedef struct name##_cell {					\
+		struct name##_cell *next;				\
+		struct name##_cell *prev;				\
+		type value;						\
+	} name##_cell;							\
+									\
+	typedef name##_cell *name##_pos;				\
+									\
+	typedef struct name {						\
+		name##_cell head;					\
+		const allocator *alloc;					\
+	} name;								\
+									\
+	static inline name *name##_empty_alloc(const allocator *a)	\
+	{								\
+		name *l=container_typed_realloc_from(a, NULL, 0, sizeof(*l)); \
+		l->head.next=&l->head;					\
+		l->head.prev=&l->head;					\
+		l->alloc=a;						\
+		return l;						\
+	}								\
+									\
+	static inline name *name##_empty(void)				\
+	{								\
+		return name##_empty_alloc(NULL);			\
+	}								\
+									\
+	static inline bool name##_is_empty(const name *l)		\
+	{								\
+		return l->head.next == &l->head;			\
+	}								\
+									\
+	static inline name##_pos name##_first(name *l)			\
+	{								\
+		return &l->head;					\
+	}								\
+									\
+	static inline name##_pos name##_next(const name *l, name##_pos p) \
+	{								\
+		(void)l;						\
+		return p->next;						\
+	}								\
+									\
+	static inline bool name##_is_end(const name *l, name##_pos p)	\
+	{								\
+		return p->next == &l->head;				\
+	}								\
+									\
+	static inline type name##_inspect(const name *l, name##_pos p)	\
+	{								\
+		(void)l;						\
+		return p->next->value;					\
+	}								\
+									\
+	static inline name##_pos name##_insert(name *l, type x, name##_pos p) \
+	{								\
+		name##_cell *c=container_typed_realloc_from(l->alloc, NULL, 0, sizeof(*c)); \
+		c->value=x;						\
+		c->prev=p;						\
+		c->next=p->next;					\
+		p->next->prev=c;					\
+		p->next=c;						\
+		return p;						\
+	}								\
+									\
+	static inline name##_pos name##_remove(name *l, name##_pos p)	\
+	{								\
+		name##_cell *c=p->next;					\
+		p->next=c->next;					\
+		c->next->prev=p;					\
+		allocator_free(l->alloc, c);				\
+		return p;						\
+	}								\
+									\
+	static inline void name##_kill(name *l)				\
+	{								\
+		while (!name##_is_empty(l)) {				\
+			name##_remove(l, &l->head);			\
+		}							\
+		allocator_free(l->alloc, l);				\
+	}
+
+VEC_TYPED(vec_u32, uint32_t)
+QUEUE_TYPED(queue_u32, uint32_t)
+
+#endif
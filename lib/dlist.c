@@ -1,5 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include <dlist.h>
 
@@ -18,6 +21,9 @@
  *   v1.0 2018-01-28: First public version.
  *   v1.1 2023-01-19: Added dlist_pos_are_equal and dlist_pos_is_valid functions.
  *   v1.2 2023-03-23: Renamed dlist_pos_are_equal to dlist_pos_is_equal.
+ *   v1.3 2026-10-18: Cells may be allocated from a pool.
+ *   v1.4 2026-10-18: Unrolled lists that store several values per cell.
+ *   v1.5 2026-10-18: Memory may come from an allocator.
  */
 
 // ===========INTERNAL DATA TYPES============
@@ -33,11 +39,127 @@ struct cell {
 };
 
 
+/*
+ * An unrolled list stores its values in chunks of DLIST_CHUNK_VALUES
+ * values. The chunks are one cache line each and are allocated aligned
+ * to their size, so the chunk an address belongs to is found by masking
+ * the address.
+ *
+ * Following the one-cell convention, the position of the value with
+ * index i in a chunk is the address of the slot before it, i.e. slot
+ * i-1. For i=0 this is the count field, so a position always points
+ * inside its chunk, also at the end of a full chunk. Positions are kept
+ * normalized: index count is only used in the last chunk, where it is
+ * the end position.
+ *
+ * Only the last chunk may be empty: the first chunk of an empty list,
+ * or a tail chunk whose last value was removed. The chunks have no back
+ * links, so an empty tail chunk is not unlinked but kept as the end
+ * position, and the next value inserted at the end goes into it. A
+ * chunk that is emptied anywhere else takes in the values of the next
+ * chunk, since they always fit. A chunk is merged with the next one
+ * when they fit in one chunk, so most chunks are at least half full.
+ */
+
+#define DLIST_CHUNK_BYTES 64
+#define DLIST_CHUNK_VALUES ((DLIST_CHUNK_BYTES - 2 * sizeof(void *)) / sizeof(void *))
+
+struct chunk {
+	struct chunk *next;
+	intptr_t count; // Number of values in the chunk.
+	void *values[DLIST_CHUNK_VALUES];
+};
+
+/*
+ * If the list has a pool, all cells except the head are allocated from
+ * it. A private pool is killed together with the list, so the cells do
+ * not have to be freed one by one. An unrolled list has no cells, its
+ * chunks are always allocated from a pool.
+ */
 struct dlist {
 	struct cell *head;
 	free_function free_func;
+	pool *cells; // Pool for the cells or chunks, or NULL to use the allocator.
+	bool owns_cells; // True if the pool is private to the list.
+	struct chunk *chunks; // First chunk of an unrolled list, otherwise NULL.
+	const allocator *alloc; // Allocator for the list, its head and its cells.
 };
 
+// ===========UNROLLED LIST HELPERS============
+
+/**
+ * chunk_of() - Return the chunk that a position points into.
+ * @p: Position in an unrolled list.
+ *
+ * Returns: The chunk holding the position.
+ */
+static struct chunk *chunk_of(const dlist_pos p)
+{
+	return (struct chunk *)((uintptr_t)p & ~(uintptr_t)(DLIST_CHUNK_BYTES - 1));
+}
+
+/**
+ * chunk_index() - Return the value index that a position refers to.
+ * @p: Position in an unrolled list.
+ *
+ * Returns: The index in the chunk of the value at the position.
+ */
+static int chunk_index(const dlist_pos p)
+{
+	ptrdiff_t offset = (char *)p - (char *)chunk_of(p) - offsetof(struct chunk, values);
+	return (int)(offset / (ptrdiff_t)sizeof(void *)) + 1;
+}
+
+/**
+ * chunk_pos() - Return the normalized position of a value in a chunk.
+ * @c: Chunk holding the value.
+ * @i: Index of the value, 0 <= i <= c->count.
+ *
+ * Returns: The position of the value.
+ */
+static dlist_pos chunk_pos(struct chunk *c, int i)
+{
+	// The end of a chunk is the start of the next one.
+	if (i == c->count && c->next != NULL) {
+		c = c->next;
+		i = 0;
+	}
+	return (dlist_pos)((char *)c + offsetof(struct chunk, values) + (i - 1) * (ptrdiff_t)sizeof(void *));
+}
+
+/**
+ * chunk_new() - Get an empty chunk from the pool of a list.
+ * @l: Unrolled list to allocate the chunk for.
+ *
+ * Returns: The new chunk.
+ */
+static struct chunk *chunk_new(dlist *l)
+{
+	struct chunk *c = pool_alloc(l->cells);
+	c->next = NULL;
+	c->count = 0;
+	return c;
+}
+
+/**
+ * chunk_merge_next() - Move the values of the next chunk into a chunk if they fit.
+ * @l: Unrolled list to manipulate.
+ * @c: Chunk to merge into.
+ *
+ * Returns: Nothing.
+ */
+static void chunk_merge_next(dlist *l, struct chunk *c)
+{
+	struct chunk *n = c->next;
+	if (n == NULL || c->count + n->count > (intptr_t)DLIST_CHUNK_VALUES) {
+		return;
+	}
+	memcpy(&c->values[c->count], n->values, n->count * sizeof(void *));
+	c->count += n->count;
+	c->next = n->next;
+	pool_free(l->cells, n);
+}
+
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
 
 /**
@@ -48,12 +170,27 @@ struct dlist {
  * Returns: A pointer to the new list.
  */
 dlist *dlist_empty(free_function free_func)
+{
+	return dlist_empty_alloc(free_func, NULL);
+}
+
+/**
+ * dlist_empty_alloc() - Create an empty dlist that uses an allocator.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @a: Allocator for the list and its cells, or NULL for the default
+ *     allocator.
+ *
+ * Returns: A pointer to the new list.
+ */
+dlist *dlist_empty_alloc(free_function free_func, const allocator *a)
 {
 	// Allocate memory for the list structure.
-	dlist *l = calloc(1, sizeof(*l));
+	dlist *l = allocator_calloc(a, 1, sizeof(*l));
+	l->alloc = a;
 
 	// Allocate memory for the list head.
-	l->head = calloc(1, sizeof(struct cell));
+	l->head = allocator_calloc(a, 1, sizeof(struct cell));
 
 	// No elements in list so far.
 	l->head->next = NULL;
@@ -64,6 +201,133 @@ dlist *dlist_empty(free_function free_func)
 	return l;
 }
 
+/**
+ * dlist_empty_pooled() - Create an empty dlist whose cells come from a pool.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @cells: A pool created by dlist_pool_create(), or NULL.
+ *
+ * If cells is NULL the list gets a private pool that is released in one
+ * go when the list is killed. Otherwise the cells are taken from and
+ * returned to the given pool, which may be shared by many lists and
+ * must outlive all of them.
+ *
+ * Returns: A pointer to the new list.
+ */
+dlist *dlist_empty_pooled(free_function free_func, pool *cells)
+{
+	dlist *l = dlist_empty(free_func);
+
+	if (cells == NULL) {
+		// Create a private pool.
+		l->cells = dlist_pool_create();
+		l->owns_cells = true;
+	} else {
+		l->cells = cells;
+	}
+
+	return l;
+}
+
+/**
+ * dlist_empty_unrolled() - Create an empty dlist that stores several
+ *			    values per cell.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @chunks: A pool created by dlist_chunk_pool_create(), or NULL.
+ *
+ * The list has the same interface as any other dlist, but its cells
+ * hold several values each, so iterating over the list touches few
+ * cache lines. Unlike the ordinary dlist, dlist_insert() and
+ * dlist_remove() make all positions in the list invalid except the one
+ * they return.
+ *
+ * If chunks is NULL the list gets a private pool that is released in
+ * one go when the list is killed. Otherwise the cells are taken from
+ * and returned to the given pool, which may be shared by many lists and
+ * must outlive all of them.
+ *
+ * Returns: A pointer to the new list.
+ */
+dlist *dlist_empty_unrolled(free_function free_func, pool *chunks)
+{
+	return dlist_empty_unrolled_alloc(free_func, chunks, NULL);
+}
+
+/**
+ * dlist_empty_unrolled_alloc() - Create an empty unrolled dlist that
+ *				  uses an allocator.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @chunks: A pool created by dlist_chunk_pool_create(), or NULL.
+ * @a: Allocator for the list and its private pool, or NULL for the
+ *     default allocator.
+ *
+ * Like dlist_empty_unrolled(). A shared pool brings its own allocator.
+ *
+ * Returns: A pointer to the new list.
+ */
+dlist *dlist_empty_unrolled_alloc(free_function free_func, pool *chunks, const allocator *a)
+{
+	// Allocate memory for the list structure.
+	dlist *l = allocator_calloc(a, 1, sizeof(*l));
+	l->alloc = a;
+
+	// Store the free function.
+	l->free_func = free_func;
+
+	if (chunks == NULL) {
+		// Create a private pool.
+		l->cells = dlist_chunk_pool_create_alloc(a);
+		l->owns_cells = true;
+	} else {
+		l->cells = chunks;
+	}
+
+	// The first chunk always exists.
+	l->chunks = chunk_new(l);
+
+	return l;
+}
+
+/**
+ * dlist_chunk_pool_create() - Create a pool for the cells of unrolled dlists.
+ *
+ * The pool must be pool_kill()-ed after all lists using it are killed.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *dlist_chunk_pool_create(void)
+{
+	return pool_create_aligned(DLIST_CHUNK_BYTES);
+}
+
+/**
+ * dlist_chunk_pool_create_alloc() - Create a pool for the cells of
+ *				     unrolled dlists that uses an allocator.
+ * @a: Allocator for the pool, or NULL for the default allocator.
+ *
+ * The pool must be pool_kill()-ed after all lists using it are killed.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *dlist_chunk_pool_create_alloc(const allocator *a)
+{
+	return pool_create_alloc(DLIST_CHUNK_BYTES, true, a);
+}
+
+/**
+ * dlist_pool_create() - Create a pool for dlist cells.
+ *
+ * The pool must be pool_kill()-ed after all lists using it are killed.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *dlist_pool_create(void)
+{
+	return pool_create(sizeof(struct cell));
+}
+
 /**
  * dlist_is_empty() - Check if a dlist is empty.
  * @l: List to check.
@@ -72,6 +336,9 @@ dlist *dlist_empty(free_function free_func)
  */
 bool dlist_is_empty(const dlist *l)
 {
+	if (l->chunks != NULL) {
+		return l->chunks->count == 0;
+	}
 	return (l->head->next == NULL);
 }
 
@@ -84,6 +351,9 @@ bool dlist_is_empty(const dlist *l)
  */
 dlist_pos dlist_first(const dlist *l)
 {
+	if (l->chunks != NULL) {
+		return chunk_pos(l->chunks, 0);
+	}
 	return l->head;
 }
 
@@ -102,6 +372,9 @@ dlist_pos dlist_next(const dlist *l, const dlist_pos p)
 		fprintf(stderr,"dlist_next: Warning: Trying to navigate "
 			"past end of list!");
 	}
+	if (l->chunks != NULL) {
+		return chunk_pos(chunk_of(p), chunk_index(p) + 1);
+	}
 	return p->next;
 }
 
@@ -114,6 +387,9 @@ dlist_pos dlist_next(const dlist *l, const dlist_pos p)
  */
 bool dlist_is_end(const dlist *l, const dlist_pos p)
 {
+	if (l->chunks != NULL) {
+		return chunk_index(p) == chunk_of(p)->count;
+	}
 	return p->next == NULL;
 }
 
@@ -133,6 +409,9 @@ void *dlist_inspect(const dlist *l, const dlist_pos p)
 		fprintf(stderr,"dlist_inspect: Warning: Trying to inspect "
 			"position at end of list!\n");
 	}
+	if (l->chunks != NULL) {
+		return chunk_of(p)->values[chunk_index(p)];
+	}
 	return p->next->value;
 }
 
@@ -149,8 +428,41 @@ void *dlist_inspect(const dlist *l, const dlist_pos p)
  */
 dlist_pos dlist_insert(dlist *l, void *v, const dlist_pos p)
 {
+	if (l->chunks != NULL) {
+		struct chunk *c = chunk_of(p);
+		int i = chunk_index(p);
+
+		// Split a full chunk in two halves and insert into the
+		// half that holds the position.
+		if (c->count == (intptr_t)DLIST_CHUNK_VALUES) {
+			int half = DLIST_CHUNK_VALUES / 2;
+			struct chunk *n = chunk_new(l);
+			n->count = c->count - half;
+			memcpy(n->values, &c->values[half], n->count * sizeof(void *));
+			c->count = half;
+			n->next = c->next;
+			c->next = n;
+			if (i > half) {
+				c = n;
+				i -= half;
+			}
+		}
+
+		// Make room for the value and store it.
+		memmove(&c->values[i + 1], &c->values[i], (c->count - i) * sizeof(void *));
+		c->values[i] = v;
+		c->count++;
+
+		return chunk_pos(c, i);
+	}
+
 	// Create new element.
-	dlist_pos new_pos=calloc(1, sizeof(struct cell));
+	dlist_pos new_pos;
+	if (l->cells != NULL) {
+		new_pos=pool_alloc(l->cells);
+	} else {
+		new_pos=allocator_calloc(l->alloc, 1, sizeof(struct cell));
+	}
 	// Set value.
 	new_pos->value=v;
 
@@ -174,6 +486,23 @@ dlist_pos dlist_insert(dlist *l, void *v, const dlist_pos p)
  */
 dlist_pos dlist_remove(dlist *l, const dlist_pos p)
 {
+	if (l->chunks != NULL) {
+		struct chunk *c = chunk_of(p);
+		int i = chunk_index(p);
+
+		// Call free_func if registered.
+		if (l->free_func != NULL) {
+			l->free_func(c->values[i]);
+		}
+		// Close the gap and keep the chunks dense.
+		memmove(&c->values[i], &c->values[i + 1], (c->count - i - 1) * sizeof(void *));
+		c->count--;
+		chunk_merge_next(l, c);
+
+		// The next value now has the index of the removed one.
+		return chunk_pos(c, i);
+	}
+
 	// Cell to remove.
 	dlist_pos c=p->next;
 
@@ -186,7 +515,11 @@ dlist_pos dlist_remove(dlist *l, const dlist_pos p)
 		l->free_func(c->value);
 	}
 	// Free the memory allocated to the cell itself.
-	free(c);
+	if (l->cells != NULL) {
+		pool_free(l->cells, c);
+	} else {
+		allocator_free(l->alloc, c);
+	}
 	// Return the position of the next element.
 	return p;
 }
@@ -203,6 +536,42 @@ dlist_pos dlist_remove(dlist *l, const dlist_pos p)
  */
 void dlist_kill(dlist *l)
 {
+	if (l->chunks != NULL) {
+		struct chunk *c = l->chunks;
+		while (c != NULL) {
+			struct chunk *next = c->next;
+			// Free the values, then give back the chunk.
+			if (l->free_func != NULL) {
+				for (int i = 0; i < c->count; i++) {
+					l->free_func(c->values[i]);
+				}
+			}
+			if (!l->owns_cells) {
+				pool_free(l->cells, c);
+			}
+			c = next;
+		}
+		if (l->owns_cells) {
+			pool_kill(l->cells);
+		}
+		allocator_free(l->alloc, l);
+		return;
+	}
+
+	if (l->owns_cells) {
+		// Only the values need to be freed one by one, the cells
+		// go away with the private pool.
+		if (l->free_func != NULL) {
+			for (struct cell *c = l->head->next; c != NULL; c = c->next) {
+				l->free_func(c->value);
+			}
+		}
+		pool_kill(l->cells);
+		allocator_free(l->alloc, l->head);
+		allocator_free(l->alloc, l);
+		return;
+	}
+
 	// Use public functions to traverse the list.
 
 	// Start with the first element (will be defined even for an
@@ -215,8 +584,8 @@ void dlist_kill(dlist *l)
 	}
 
 	// Free the head and the list itself.
-	free(l->head);
-	free(l);
+	allocator_free(l->alloc, l->head);
+	allocator_free(l->alloc, l);
 }
 
 /**
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include "util.h"
+#include "pool.h"
 
 /*
  * Declaration of a generic, directed list for the "Datastructures
@@ -25,6 +26,10 @@
  *   v1.1 2023-01-19: Added dlist_pos_equal and dlist_pos_is_valid functions.
  *   v1.2 2023-01-20: Renamed dlist_pos_equal to dlist_pos_are_equal.
  *   v1.3 2023-03-23: Renamed dlist_pos_are_equal to dlist_pos_is_equal.
+ *   v1.4 2026-10-18: Added dlist_empty_pooled and dlist_pool_create.
+ *   v1.5 2026-10-18: Added dlist_empty_unrolled and dlist_chunk_pool_create.
+ *   v1.6 2026-10-18: Added dlist_empty_alloc, dlist_empty_unrolled_alloc and
+ *                    dlist_chunk_pool_create_alloc.
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -47,6 +52,98 @@ typedef struct cell *dlist_pos;
  */
 dlist *dlist_empty(free_function free_func);
 
+/**
+ * dlist_empty_alloc() - Create an empty dlist that uses an allocator.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @a: Allocator for the list and its cells, or NULL for the default
+ *     allocator.
+ *
+ * Returns: A pointer to the new list.
+ */
+dlist *dlist_empty_alloc(free_function free_func, const allocator *a);
+
+/**
+ * dlist_empty_pooled() - Create an empty dlist whose cells come from a pool.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @cells: A pool created by dlist_pool_create(), or NULL.
+ *
+ * If cells is NULL the list gets a private pool that is released in one
+ * go when the list is killed. Otherwise the cells are taken from and
+ * returned to the given pool, which may be shared by many lists and
+ * must outlive all of them.
+ *
+ * Returns: A pointer to the new list.
+ */
+dlist *dlist_empty_pooled(free_function free_func, pool *cells);
+
+/**
+ * dlist_empty_unrolled() - Create an empty dlist that stores several
+ *			    values per cell.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @chunks: A pool created by dlist_chunk_pool_create(), or NULL.
+ *
+ * The list has the same interface as any other dlist, but its cells
+ * hold several values each, so iterating over the list touches few
+ * cache lines. Unlike the ordinary dlist, dlist_insert() and
+ * dlist_remove() make all positions in the list invalid except the one
+ * they return.
+ *
+ * If chunks is NULL the list gets a private pool that is released in
+ * one go when the list is killed. Otherwise the cells are taken from
+ * and returned to the given pool, which may be shared by many lists and
+ * must outlive all of them.
+ *
+ * Returns: A pointer to the new list.
+ */
+dlist *dlist_empty_unrolled(free_function free_func, pool *chunks);
+
+/**
+ * dlist_empty_unrolled_alloc() - Create an empty unrolled dlist that
+ *				  uses an allocator.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @chunks: A pool created by dlist_chunk_pool_create(), or NULL.
+ * @a: Allocator for the list and its private pool, or NULL for the
+ *     default allocator.
+ *
+ * Like dlist_empty_unrolled(). A shared pool brings its own allocator.
+ *
+ * Returns: A pointer to the new list.
+ */
+dlist *dlist_empty_unrolled_alloc(free_function free_func, pool *chunks, const allocator *a);
+
+/**
+ * dlist_chunk_pool_create() - Create a pool for the cells of unrolled dlists.
+ *
+ * The pool must be pool_kill()-ed after all lists using it are killed.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *dlist_chunk_pool_create(void);
+
+/**
+ * dlist_chunk_pool_create_alloc() - Create a pool for the cells of
+ *				     unrolled dlists that uses an allocator.
+ * @a: Allocator for the pool, or NULL for the default allocator.
+ *
+ * The pool must be pool_kill()-ed after all lists using it are killed.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *dlist_chunk_pool_create_alloc(const allocator *a);
+
+/**
+ * dlist_pool_create() - Create a pool for dlist cells.
+ *
+ * The pool must be pool_kill()-ed after all lists using it are killed.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *dlist_pool_create(void);
+
 /**
  * dlist_is_empty() - Check if a dlist is empty.
  * @l: List to check.
@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include "util.h"
 #include "dlist.h"
+#include "allocator.h"
 
 /*
  * Declaration of a generic graph for the "Datastructures and
@@ -28,6 +29,17 @@
  *   v1.1  2019-03-06: Changed several const node * to node *.
  *                     Fixed doc bug to state that any dynamic memory allocated
  *                     to the node NAMES is the resposibility of the user.
+ *   v1.2  2026-10-18: Added graph_empty_alloc.
+ *   v1.3  2026-10-18: Added graph_find_or_insert_node.
+ *   v1.4  2026-10-18: Added graph_empty_sized.
+ *   v1.5  2026-10-18: graph_empty() takes the expected number of nodes,
+ *                     graph_delete_edge() ignores edges not in the graph.
+ *   v1.6  2026-10-18: Added graph_node_count, graph_node_at,
+ *                     graph_node_index, graph_node_label and
+ *                     graph_for_each_neighbour. graph_print prints the
+ *                     graph in the map file format.
+ *   v1.7  2026-10-18: graph_empty_alloc() takes all memory of the graph
+ *                     from the allocator.
  */
 
 // ====================== PUBLIC DATA TYPES ==========================
@@ -36,6 +48,9 @@
 typedef struct node node;
 typedef struct graph graph;
 
+// Function called by graph_for_each_neighbour() for every neighbour.
+typedef void graph_neighbour_callback(const node *n, void *arg);
+
 // =================== NODE COMPARISON FUNCTION ======================
 
 /**
@@ -52,12 +67,42 @@ bool nodes_are_equal(const node *n1,const node *n2);
 
 /**
  * graph_empty() - Create an empty graph.
- * @max_nodes: The maximum number of nodes the graph can hold.
+ * @max_nodes: The expected number of nodes. The graph grows if more are inserted.
  *
  * Returns: A pointer to the new graph.
  */
 graph *graph_empty(int max_nodes);
 
+/**
+ * graph_empty_alloc() - Create an empty graph that uses an allocator.
+ * @max_nodes: The expected number of nodes. The graph grows if more are inserted.
+ * @a: Allocator for the graph, or NULL for the default allocator.
+ *
+ * All memory of the graph is taken from the allocator: the nodes, their
+ * labels, the lists, tables and matrices holding the edges and the seen
+ * status. Only the lists returned by graph_neighbours() use the default
+ * allocator, since they are freed by the caller.
+ *
+ * Returns: A pointer to the new graph.
+ */
+graph *graph_empty_alloc(int max_nodes, const allocator *a);
+
+/**
+ * graph_empty_sized() - Create an empty graph for a known number of nodes and edges.
+ * @n_nodes: The number of nodes that will be inserted.
+ * @out_degree: Array of n_nodes edge counts, out_degree[i] edges will be inserted
+ *              from the i:th node inserted, or NULL if not known.
+ * @a: Allocator for the graph, or NULL for the default allocator.
+ *
+ * Meant for loaders that first count the distinct nodes and the edges of every
+ * node, e.g. in a first pass over a file. The storage for the nodes, their labels
+ * and their edges is then allocated once with its final size, instead of from an
+ * upper bound or by growing.
+ *
+ * Returns: A pointer to the new graph.
+ */
+graph *graph_empty_sized(int n_nodes, const int *out_degree, const allocator *a);
+
 /**
  * graph_is_empty() - Check if a graph is empty, i.e. has no nodes.
  * @g: Graph to check.
@@ -86,6 +131,19 @@ bool graph_has_edges(const graph *g);
  */
 graph *graph_insert_node(graph *g, const char *s);
 
+/**
+ * graph_find_or_insert_node() - Find a node, inserting it if needed.
+ * @g: Graph to manipulate.
+ * @s: Characters of the node name, need not be NUL-terminated.
+ * @len: Number of characters in the node name.
+ *
+ * Looks the name up once and inserts a node with a copy of the name
+ * if there is none, e.g. for names that are views into a file buffer.
+ *
+ * Returns: A pointer to the node with the given name.
+ */
+node *graph_find_or_insert_node(graph *g, const char *s, size_t len);
+
 /**
  * graph_find_node() - Find a node stored in the graph.
  * @g: Graph to manipulate.
@@ -153,7 +211,8 @@ graph *graph_delete_node(graph *g, node *n);
  *
  * Returns: The modified graph.
  *
- * NOTE: Undefined if the edge is not in the graph.
+ * NOTE: Undefined unless both nodes are in the graph. Does nothing if
+ * the edge is not in the graph.
  */
 graph *graph_delete_edge(graph *g, node *n1, node *n2);
 
@@ -177,6 +236,64 @@ node *graph_choose_node(const graph *g);
  */
 dlist *graph_neighbours(const graph *g,const node *n);
 
+/**
+ * graph_node_count() - Return the number of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of nodes.
+ */
+int graph_node_count(const graph *g);
+
+/**
+ * graph_node_at() - Return a node by its index.
+ * @g: Graph to inspect.
+ * @i: Index of the node, 0 for the first node inserted and
+ *     graph_node_count()-1 for the last one.
+ *
+ * Returns: A pointer to the node.
+ */
+node *graph_node_at(const graph *g, int i);
+
+/**
+ * graph_node_index() - Return the index of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ *
+ * Returns: The index of the node, see graph_node_at().
+ */
+int graph_node_index(const graph *g, const node *n);
+
+/**
+ * graph_node_label() - Return the label of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ * @len: Set to the length of the label, or NULL.
+ *
+ * The labels are stored together and may move when the storage grows,
+ * so the pointer is valid only until the next node is inserted into the
+ * graph, like a string from intern_string(). Copy the label to keep it
+ * longer.
+ *
+ * Returns: The NUL-terminated label.
+ */
+const char *graph_node_label(const graph *g, const node *n, size_t *len);
+
+/**
+ * graph_for_each_neighbour() - Call a function for every neighbour of a node.
+ * @g: Graph to inspect.
+ * @n: Node to get neighbours for.
+ * @func: Function to call with every neighbour.
+ * @arg: Argument passed on to func.
+ *
+ * Unlike graph_neighbours() no list is built, so this is the fast way
+ * to walk all edges of a large graph. The graph must not be changed by
+ * func.
+ *
+ * Returns: Nothing.
+ */
+void graph_for_each_neighbour(const graph *g, const node *n, graph_neighbour_callback *func,
+			      void *arg);
+
 /**
  * graph_kill() - Destroy a given graph.
  * @g: Graph to destroy.
@@ -191,7 +308,8 @@ void graph_kill(graph *g);
  * graph_print() - Iterate over the graph elements and print their values.
  * @g: Graph to inspect.
  *
- * Iterates over the graph and prints its contents.
+ * Iterates over the graph and prints its contents to stdout, in the
+ * format of a map file (see graphexport.h).
  *
  * Returns: Nothing.
  */
@@ -0,0 +1,422 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include <graphexport.h>
+
+/*
+ * Implementation of writers that export a graph to a file.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: errno is cleared before a block is written.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Output buffer, and the edge source while the edges of a node are written.
+struct export_writer {
+	const graph *g;
+	FILE *out;
+	char *buf;
+	size_t len; // Bytes in buf.
+	int err; // errno of the first failed write, or 0.
+	const char *src; // Label of the source node.
+	size_t src_len;
+	uint32_t src_index;
+	long long n_edges; // Edges counted by export_count_edge().
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * writer_flush() - Internal function to write out the buffer.
+ * @w: Writer.
+ *
+ * Returns: Nothing.
+ */
+static void writer_flush(struct export_writer *w)
+{
+	if (w->len > 0 && w->err == 0) {
+		// fwrite() need not set errno, so an old value is not taken for its error.
+		errno=0;
+		if (fwrite(w->buf, 1, w->len, w->out) != w->len) {
+			w->err=(errno != 0) ? errno : EIO;
+		}
+	}
+	w->len=0;
+}
+
+/**
+ * writer_room() - Internal function to make room in the buffer.
+ * @w: Writer.
+ * @n: Number of bytes needed, at most GRAPH_EXPORT_BUFSIZE.
+ *
+ * Returns: Where the bytes go, the caller adds n to w->len.
+ */
+static inline char *writer_room(struct export_writer *w, size_t n)
+{
+	if (w->len + n > GRAPH_EXPORT_BUFSIZE) {
+		writer_flush(w);
+	}
+	return w->buf + w->len;
+}
+
+/**
+ * writer_put() - Internal function to add bytes to the buffer.
+ * @w: Writer.
+ * @data: Bytes to add.
+ * @n: Number of bytes, may be more than the buffer holds.
+ *
+ * Returns: Nothing.
+ */
+static void writer_put(struct export_writer *w, const void *data, size_t n)
+{
+	const char *p=data;
+
+	while (n > 0) {
+		size_t room=GRAPH_EXPORT_BUFSIZE - w->len;
+		if (room == 0) {
+			writer_flush(w);
+			room=GRAPH_EXPORT_BUFSIZE;
+		}
+		size_t k=(n < room) ? n : room;
+		memcpy(w->buf + w->len, p, k);
+		w->len+=k;
+		p+=k;
+		n-=k;
+	}
+}
+
+/**
+ * writer_put_uint() - Internal function to add a number in decimal.
+ * @w: Writer.
+ * @v: Number to add.
+ *
+ * Returns: Nothing.
+ */
+static void writer_put_uint(struct export_writer *w, unsigned long long v)
+{
+	char digits[20];
+	int n=0;
+
+	do {
+		digits[sizeof(digits) - ++n]='0' + v % 10;
+		v/=10;
+	} while (v > 0);
+	writer_put(w, digits + sizeof(digits) - n, n);
+}
+
+/**
+ * writer_put_dot_id() - Internal function to add a label as a quoted DOT id.
+ * @w: Writer.
+ * @s: The label.
+ * @len: Length of the label.
+ *
+ * Returns: Nothing.
+ */
+static void writer_put_dot_id(struct export_writer *w, const char *s, size_t len)
+{
+	writer_put(w, "\"", 1);
+	if (memchr(s, '"', len) == NULL && memchr(s, '\\', len) == NULL) {
+		writer_put(w, s, len);
+	} else {
+		for (size_t i=0; i<len; i++) {
+			if (s[i] == '"' || s[i] == '\\') {
+				writer_put(w, "\\", 1);
+			}
+			writer_put(w, &s[i], 1);
+		}
+	}
+	writer_put(w, "\"", 1);
+}
+
+/**
+ * writer_set_source() - Internal function to set the source of the next edges.
+ * @w: Writer.
+ * @i: Index of the source node.
+ *
+ * Returns: The source node.
+ */
+static const node *writer_set_source(struct export_writer *w, int i)
+{
+	const node *n=graph_node_at(w->g, i);
+	w->src=graph_node_label(w->g, n, &w->src_len);
+	w->src_index=i;
+	return n;
+}
+
+/**
+ * export_count_edge() - Internal graph_neighbour_callback that counts edges.
+ * @n: The neighbour.
+ * @arg: The writer.
+ *
+ * Returns: Nothing.
+ */
+static void export_count_edge(const node *n, void *arg)
+{
+	(void)n;
+	((struct export_writer *)arg)->n_edges++;
+}
+
+/**
+ * export_map_edge() - Internal graph_neighbour_callback that writes a map file line.
+ * @n: The neighbour.
+ * @arg: The writer.
+ *
+ * Returns: Nothing.
+ */
+static void export_map_edge(const node *n, void *arg)
+{
+	struct export_writer *w=arg;
+	size_t dest_len;
+	const char *dest=graph_node_label(w->g, n, &dest_len);
+	size_t line_len=w->src_len + dest_len + 2;
+
+	if (line_len > GRAPH_EXPORT_BUFSIZE) {
+		writer_put(w, w->src, w->src_len);
+		writer_put(w, " ", 1);
+		writer_put(w, dest, dest_len);
+		writer_put(w, "\n", 1);
+		return;
+	}
+	// The usual case: the whole line is copied into the buffer at once.
+	char *p=writer_room(w, line_len);
+	memcpy(p, w->src, w->src_len);
+	p[w->src_len]=' ';
+	memcpy(p + w->src_len + 1, dest, dest_len);
+	p[line_len - 1]='\n';
+	w->len+=line_len;
+}
+
+/**
+ * export_dot_edge() - Internal graph_neighbour_callback that writes a DOT edge.
+ * @n: The neighbour.
+ * @arg: The writer.
+ *
+ * Returns: Nothing.
+ */
+static void export_dot_edge(const node *n, void *arg)
+{
+	struct export_writer *w=arg;
+	size_t dest_len;
+	const char *dest=graph_node_label(w->g, n, &dest_len);
+
+	writer_put(w, "\t", 1);
+	writer_put_dot_id(w, w->src, w->src_len);
+	writer_put(w, " -> ", 4);
+	writer_put_dot_id(w, dest, dest_len);
+	writer_put(w, ";\n", 2);
+}
+
+/**
+ * export_binary_edge() - Internal graph_neighbour_callback that writes a binary edge.
+ * @n: The neighbour.
+ * @arg: The writer.
+ *
+ * Returns: Nothing.
+ */
+static void export_binary_edge(const node *n, void *arg)
+{
+	struct export_writer *w=arg;
+	uint32_t edge[2]={ w->src_index, graph_node_index(w->g, n) };
+
+	memcpy(writer_room(w, sizeof(edge)), edge, sizeof(edge));
+	w->len+=sizeof(edge);
+}
+
+/**
+ * export_edges() - Internal function to walk the edges of a range of nodes.
+ * @w: Writer.
+ * @first: Index of the first node.
+ * @last: Index after the last node.
+ * @func: Function to call for every edge.
+ *
+ * Returns: Nothing.
+ */
+static void export_edges(struct export_writer *w, int first, int last,
+			 graph_neighbour_callback *func)
+{
+	for (int i=first; i<last && w->err == 0; i++) {
+		const node *n=writer_set_source(w, i);
+		graph_for_each_neighbour(w->g, n, func, w);
+	}
+}
+
+/**
+ * export_map() - Internal function to write a map file.
+ * @w: Writer.
+ * @first: Index of the first node.
+ * @last: Index after the last node.
+ *
+ * Returns: Nothing.
+ */
+static void export_map(struct export_writer *w, int first, int last)
+{
+	// The edges are counted first, for the first line.
+	export_edges(w, first, last, export_count_edge);
+	writer_put_uint(w, w->n_edges);
+	writer_put(w, "\n", 1);
+	export_edges(w, first, last, export_map_edge);
+}
+
+/**
+ * export_dot() - Internal function to write a DOT digraph.
+ * @w: Writer.
+ * @first: Index of the first node.
+ * @last: Index after the last node.
+ *
+ * Returns: Nothing.
+ */
+static void export_dot(struct export_writer *w, int first, int last)
+{
+	writer_put(w, "digraph map {\n", 14);
+	for (int i=first; i<last; i++) {
+		writer_set_source(w, i);
+		writer_put(w, "\t", 1);
+		writer_put_dot_id(w, w->src, w->src_len);
+		writer_put(w, ";\n", 2);
+	}
+	export_edges(w, first, last, export_dot_edge);
+	writer_put(w, "}\n", 2);
+}
+
+/**
+ * export_binary() - Internal function to write a binary edge list.
+ * @w: Writer.
+ * @first: Index of the first node.
+ * @last: Index after the last node.
+ *
+ * Returns: Nothing.
+ */
+static void export_binary(struct export_writer *w, int first, int last)
+{
+	export_edges(w, first, last, export_count_edge);
+	if (w->n_edges > UINT32_MAX) {
+		w->err=EOVERFLOW;
+		return;
+	}
+
+	int n_nodes=graph_node_count(w->g);
+	uint32_t header[4]={ GRAPH_EXPORT_BYTE_ORDER, GRAPH_EXPORT_VERSION, n_nodes, w->n_edges };
+	writer_put(w, GRAPH_EXPORT_MAGIC, 8);
+	writer_put(w, header, sizeof(header));
+
+	// The labels of all nodes, since the edges may lead out of the range.
+	for (int i=0; i<n_nodes; i++) {
+		writer_set_source(w, i);
+		writer_put(w, w->src, w->src_len + 1);
+	}
+	export_edges(w, first, last, export_binary_edge);
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * graph_export() - Write a graph, or a range of its nodes, to a stream.
+ * @g: Graph to export.
+ * @format: Format to write.
+ * @first: Index of the first node to export.
+ * @last: Index after the last node to export.
+ * @out: Stream to write to, e.g. stdout or a file opened with "wb".
+ *
+ * The range is clipped to the nodes of the graph. The stream is not
+ * flushed or closed.
+ *
+ * Returns: 0 on success, -1 with errno set if writing failed.
+ */
+int graph_export(const graph *g, graph_export_format format, int first, int last, FILE *out)
+{
+	struct export_writer w;
+	int n=graph_node_count(g);
+
+	first=(first < 0) ? 0 : first;
+	last=(last > n) ? n : last;
+	last=(last < first) ? first : last;
+
+	memset(&w, 0, sizeof(w));
+	w.g=g;
+	w.out=out;
+	w.buf=malloc(GRAPH_EXPORT_BUFSIZE);
+	if (w.buf == NULL) {
+		errno=ENOMEM;
+		return -1;
+	}
+
+	switch (format) {
+	case GRAPH_EXPORT_MAP:
+		export_map(&w, first, last);
+		break;
+	case GRAPH_EXPORT_DOT:
+		export_dot(&w, first, last);
+		break;
+	case GRAPH_EXPORT_EDGES:
+		export_binary(&w, first, last);
+		break;
+	}
+	writer_flush(&w);
+	free(w.buf);
+
+	if (w.err != 0) {
+		errno=w.err;
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * graph_export_file() - Write a graph, or a range of its nodes, to a file.
+ * @g: Graph to export.
+ * @format: Format to write.
+ * @first: Index of the first node to export.
+ * @last: Index after the last node to export.
+ * @path: Name of the file, created or truncated.
+ *
+ * Returns: 0 on success, -1 with errno set on failure.
+ */
+int graph_export_file(const graph *g, graph_export_format format, int first, int last,
+		      const char *path)
+{
+	FILE *out=fopen(path, "wb");
+	if (out == NULL) {
+		return -1;
+	}
+
+	// The writer has its own buffer, stdio need not copy the blocks.
+	setvbuf(out, NULL, _IONBF, 0);
+	int result=graph_export(g, format, first, last, out);
+	int err=errno;
+	if (fclose(out) != 0 && result == 0) {
+		return -1;
+	}
+	errno=err;
+	return result;
+}
+
+/**
+ * graph_export_format_from_name() - Look up an export format by name.
+ * @name: "map", "dot" or "edges".
+ * @format: Set to the format.
+ *
+ * Returns: True if the name is a format, otherwise false.
+ */
+bool graph_export_format_from_name(const char *name, graph_export_format *format)
+{
+	static const struct {
+		const char *name;
+		graph_export_format format;
+	} formats[]={
+		{ "map", GRAPH_EXPORT_MAP },
+		{ "dot", GRAPH_EXPORT_DOT },
+		{ "edges", GRAPH_EXPORT_EDGES },
+	};
+
+	for (size_t i=0; i<sizeof(formats) / sizeof(formats[0]); i++) {
+		if (strcmp(name, formats[i].name) == 0) {
+			*format=formats[i].format;
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,103 @@
+#ifndef __GRAPHEXPORT_H
+#define __GRAPHEXPORT_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "util.h"
+#include "graph.h"
+
+/*
+ * Declaration of writers that export a graph to a file. The output is
+ * formatted by hand into a large buffer that is written a block at a
+ * time, so exporting a graph with millions of edges is limited by the
+ * speed of the disk rather than by formatting.
+ *
+ * A range of nodes, by the indices of graph_node_at(), can be exported
+ * instead of the whole graph. The edges from the nodes in the range are
+ * written, whichever nodes they lead to.
+ *
+ * The formats are:
+ *
+ *   GRAPH_EXPORT_MAP    A map file as read by is_connected: the number
+ *			 of edges on the first line, then one
+ *			 "<source> <destination>" line per edge.
+ *   GRAPH_EXPORT_DOT    A Graphviz digraph. The nodes in the range are
+ *			 listed first, so nodes without edges are kept.
+ *   GRAPH_EXPORT_EDGES  A binary edge list, see below.
+ *
+ * The binary edge list has a header, the labels of all nodes of the
+ * graph, NUL-terminated and in index order, and then the edges as
+ * pairs of node indices:
+ *
+ *   char     magic[8]      "MAPEDGES"
+ *   uint32_t byte_order    GRAPH_EXPORT_BYTE_ORDER
+ *   uint32_t version       GRAPH_EXPORT_VERSION
+ *   uint32_t n_nodes
+ *   uint32_t n_edges
+ *   char     labels[]      n_nodes NUL-terminated labels
+ *   uint32_t edges[2*n_edges]  Source and destination index of every edge.
+ *
+ * Integers are stored in the byte order of the machine that wrote the
+ * file, as in a map image.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Magic, byte order mark and version of a binary edge list.
+#define GRAPH_EXPORT_MAGIC "MAPEDGES"
+#define GRAPH_EXPORT_BYTE_ORDER 0x01020304u
+#define GRAPH_EXPORT_VERSION 1u
+
+// Size of the output buffer.
+#define GRAPH_EXPORT_BUFSIZE (1 << 20)
+
+// Export formats.
+typedef enum graph_export_format {
+	GRAPH_EXPORT_MAP,
+	GRAPH_EXPORT_DOT,
+	GRAPH_EXPORT_EDGES,
+} graph_export_format;
+
+// ==========EXPORT INTERFACE==========
+
+/**
+ * graph_export() - Write a graph, or a range of its nodes, to a stream.
+ * @g: Graph to export.
+ * @format: Format to write.
+ * @first: Index of the first node to export.
+ * @last: Index after the last node to export.
+ * @out: Stream to write to, e.g. stdout or a file opened with "wb".
+ *
+ * The range is clipped to the nodes of the graph. The stream is not
+ * flushed or closed.
+ *
+ * Returns: 0 on success, -1 with errno set if writing failed.
+ */
+int graph_export(const graph *g, graph_export_format format, int first, int last, FILE *out);
+
+/**
+ * graph_export_file() - Write a graph, or a range of its nodes, to a file.
+ * @g: Graph to export.
+ * @format: Format to write.
+ * @first: Index of the first node to export.
+ * @last: Index after the last node to export.
+ * @path: Name of the file, created or truncated.
+ *
+ * Returns: 0 on success, -1 with errno set on failure.
+ */
+int graph_export_file(const graph *g, graph_export_format format, int first, int last,
+		      const char *path);
+
+/**
+ * graph_export_format_from_name() - Look up an export format by name.
+ * @name: "map", "dot" or "edges".
+ * @format: Set to the format.
+ *
+ * Returns: True if the name is a format, otherwise false.
+ */
+bool graph_export_format_from_name(const char *name, graph_export_format *format);
+
+#endif
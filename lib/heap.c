@@ -0,0 +1,348 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <heap.h>
+
+/*
+ * Implementation of an indexed 4-ary min-heap.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Number of children of every heap node.
+#define HEAP_ARITY 4
+
+// Place of an id that is not in the heap.
+#define NOT_IN_HEAP -1
+
+/*
+ * The heap is an array of (priority, id) entries where the children of
+ * entry k are the entries HEAP_ARITY*k+1 ... HEAP_ARITY*k+HEAP_ARITY.
+ * The priority is stored next to the id so that sifting never has to
+ * look anywhere else. place[id] is the index of the id in the entries,
+ * or NOT_IN_HEAP.
+ */
+struct heap_entry {
+	int64_t priority;
+	int id;
+};
+
+struct heap {
+	struct heap_entry *entries;
+	int size; // Number of entries.
+	int capacity; // Number of entries there is room for.
+	int *place; // Index of every id in entries.
+	int ids; // Number of ids place has room for.
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * heap_realloc() - Internal function to resize memory.
+ * @p: Memory to resize, or NULL.
+ * @size: New size in bytes.
+ *
+ * Returns: A pointer to the resized memory.
+ */
+static void *heap_realloc(void *p, size_t size)
+{
+	p=realloc(p, size);
+	if (p == NULL) {
+		fprintf(stderr, "heap: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	return p;
+}
+
+/**
+ * heap_reserve_id() - Internal function to make room for an id.
+ * @h: Heap to manipulate.
+ * @id: Id that needs a place.
+ *
+ * Returns: Nothing.
+ */
+static void heap_reserve_id(heap *h, int id)
+{
+	if (id < h->ids) {
+		return;
+	}
+	int ids=h->ids;
+	while (ids <= id) {
+		ids*=2;
+	}
+	h->place=heap_realloc(h->place, ids * sizeof(int));
+	for (int i=h->ids; i<ids; i++) {
+		h->place[i]=NOT_IN_HEAP;
+	}
+	h->ids=ids;
+}
+
+/**
+ * sift_up() - Internal function to move an entry towards the root.
+ * @h: Heap to manipulate.
+ * @k: Index of the entry.
+ * @e: The entry. It is written to its final place.
+ *
+ * Returns: Nothing.
+ */
+static void sift_up(heap *h, int k, struct heap_entry e)
+{
+	// Move parents down until the entry has found its place.
+	while (k > 0) {
+		int parent=(k-1)/HEAP_ARITY;
+		if (h->entries[parent].priority <= e.priority) {
+			break;
+		}
+		h->entries[k]=h->entries[parent];
+		h->place[h->entries[k].id]=k;
+		k=parent;
+	}
+	h->entries[k]=e;
+	h->place[e.id]=k;
+}
+
+/**
+ * sift_down() - Internal function to move an entry away from the root.
+ * @h: Heap to manipulate.
+ * @k: Index of the entry.
+ * @e: The entry. It is written to its final place.
+ *
+ * Returns: Nothing.
+ */
+static void sift_down(heap *h, int k, struct heap_entry e)
+{
+	for (;;) {
+		int first=HEAP_ARITY*k+1;
+		if (first >= h->size) {
+			break;
+		}
+		// Find the child with the lowest priority.
+		int last=first+HEAP_ARITY < h->size ? first+HEAP_ARITY : h->size;
+		int best=first;
+		for (int c=first+1; c<last; c++) {
+			if (h->entries[c].priority < h->entries[best].priority) {
+				best=c;
+			}
+		}
+		if (h->entries[best].priority >= e.priority) {
+			break;
+		}
+		h->entries[k]=h->entries[best];
+		h->place[h->entries[k].id]=k;
+		k=best;
+	}
+	h->entries[k]=e;
+	h->place[e.id]=k;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * heap_empty() - Create an empty heap.
+ * @max_id: Expected highest id. Larger ids may be inserted too.
+ *
+ * Returns: A pointer to the new heap.
+ */
+heap *heap_empty(int max_id)
+{
+	int ids=max_id < 15 ? 16 : max_id+1;
+
+	heap *h=heap_realloc(NULL, sizeof(*h));
+	h->size=0;
+	h->capacity=16;
+	h->entries=heap_realloc(NULL, h->capacity * sizeof(struct heap_entry));
+	h->place=heap_realloc(NULL, ids * sizeof(int));
+	for (int i=0; i<ids; i++) {
+		h->place[i]=NOT_IN_HEAP;
+	}
+	h->ids=ids;
+
+	return h;
+}
+
+/**
+ * heap_is_empty() - Check if a heap is empty.
+ * @h: Heap to check.
+ *
+ * Returns: True if heap is empty, otherwise false.
+ */
+bool heap_is_empty(const heap *h)
+{
+	return h->size == 0;
+}
+
+/**
+ * heap_size() - Return the number of ids in the heap.
+ * @h: Heap to inspect.
+ *
+ * Returns: The number of ids in the heap.
+ */
+int heap_size(const heap *h)
+{
+	return h->size;
+}
+
+/**
+ * heap_contains() - Check if an id is in the heap.
+ * @h: Heap to inspect.
+ * @id: Id to look for, at least zero.
+ *
+ * Returns: True if the id is in the heap, otherwise false.
+ */
+bool heap_contains(const heap *h, int id)
+{
+	return id < h->ids && h->place[id] != NOT_IN_HEAP;
+}
+
+/**
+ * heap_insert() - Put an id with a priority in the heap.
+ * @h: Heap to manipulate.
+ * @id: Id to insert, at least zero.
+ * @priority: Priority of the id.
+ *
+ * NOTE: Undefined if the id is already in the heap.
+ *
+ * Returns: Nothing.
+ */
+void heap_insert(heap *h, int id, int64_t priority)
+{
+	heap_reserve_id(h, id);
+	if (h->size == h->capacity) {
+		h->capacity*=2;
+		h->entries=heap_realloc(h->entries, h->capacity * sizeof(struct heap_entry));
+	}
+	struct heap_entry e={ priority, id };
+	sift_up(h, h->size++, e);
+}
+
+/**
+ * heap_priority() - Inspect the priority of an id in the heap.
+ * @h: Heap to inspect.
+ * @id: Id to inspect.
+ *
+ * NOTE: Undefined unless the id is in the heap.
+ *
+ * Returns: The priority of the id.
+ */
+int64_t heap_priority(const heap *h, int id)
+{
+	return h->entries[h->place[id]].priority;
+}
+
+/**
+ * heap_decrease_priority() - Lower the priority of an id in the heap.
+ * @h: Heap to manipulate.
+ * @id: Id to change.
+ * @priority: New priority, at most the current priority of the id.
+ *
+ * NOTE: Undefined unless the id is in the heap.
+ *
+ * Returns: Nothing.
+ */
+void heap_decrease_priority(heap *h, int id, int64_t priority)
+{
+	struct heap_entry e={ priority, id };
+	sift_up(h, h->place[id], e);
+}
+
+/**
+ * heap_insert_or_decrease() - Insert an id or lower its priority.
+ * @h: Heap to manipulate.
+ * @id: Id to insert or change, at least zero.
+ * @priority: Priority of the id.
+ *
+ * Inserts the id if it is not in the heap. Otherwise lowers its
+ * priority if the given priority is lower than the current one.
+ *
+ * Returns: True if the id was inserted or its priority lowered,
+ *	    otherwise false.
+ */
+bool heap_insert_or_decrease(heap *h, int id, int64_t priority)
+{
+	if (!heap_contains(h, id)) {
+		heap_insert(h, id, priority);
+		return true;
+	}
+	if (priority < heap_priority(h, id)) {
+		heap_decrease_priority(h, id, priority);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * heap_front() - Inspect the id with the lowest priority.
+ * @h: Heap to inspect.
+ *
+ * NOTE: Undefined for an empty heap.
+ *
+ * Returns: The id at the front of the heap.
+ */
+int heap_front(const heap *h)
+{
+	return h->entries[0].id;
+}
+
+/**
+ * heap_front_priority() - Inspect the lowest priority in the heap.
+ * @h: Heap to inspect.
+ *
+ * NOTE: Undefined for an empty heap.
+ *
+ * Returns: The priority of the id at the front of the heap.
+ */
+int64_t heap_front_priority(const heap *h)
+{
+	return h->entries[0].priority;
+}
+
+/**
+ * heap_remove_front() - Remove the id with the lowest priority.
+ * @h: Heap to manipulate.
+ *
+ * NOTE: Undefined for an empty heap.
+ *
+ * Returns: The removed id.
+ */
+int heap_remove_front(heap *h)
+{
+	int id=h->entries[0].id;
+	h->place[id]=NOT_IN_HEAP;
+
+	// Move the last entry to the root and let it sift down.
+	h->size--;
+	if (h->size > 0) {
+		sift_down(h, 0, h->entries[h->size]);
+	}
+	return id;
+}
+
+/**
+ * heap_clear() - Remove all ids from the heap.
+ * @h: Heap to manipulate.
+ *
+ * Returns: Nothing.
+ */
+void heap_clear(heap *h)
+{
+	for (int k=0; k<h->size; k++) {
+		h->place[h->entries[k].id]=NOT_IN_HEAP;
+	}
+	h->size=0;
+}
+
+/**
+ * heap_kill() - Destroy a given heap.
+ * @h: Heap to destroy.
+ *
+ * Returns: Nothing.
+ */
+void heap_kill(heap *h)
+{
+	free(h->entries);
+	free(h->place);
+	free(h);
+}
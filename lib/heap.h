@@ -0,0 +1,161 @@
+#ifndef __HEAP_H
+#define __HEAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "util.h"
+
+/*
+ * Declaration of an indexed priority queue (min-heap) for best-first
+ * searches such as Dijkstra's algorithm. The heap stores integer ids
+ * 0, 1, 2, ..., e.g. node ids, each with a priority. The id with the
+ * lowest priority is at the front of the heap. Every id is in the heap
+ * at most once, and the priority of an id in the heap can be lowered
+ * with heap_decrease_priority().
+ *
+ * The heap is a 4-ary heap in an array, which is shallower than a
+ * binary heap and keeps the children of a node in one cache line. A
+ * second array maps every id to its place in the heap. Neither array
+ * allocates memory per element; both grow geometrically when larger
+ * ids are inserted.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Heap type.
+typedef struct heap heap;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * heap_empty() - Create an empty heap.
+ * @max_id: Expected highest id. Larger ids may be inserted too.
+ *
+ * Returns: A pointer to the new heap.
+ */
+heap *heap_empty(int max_id);
+
+/**
+ * heap_is_empty() - Check if a heap is empty.
+ * @h: Heap to check.
+ *
+ * Returns: True if heap is empty, otherwise false.
+ */
+bool heap_is_empty(const heap *h);
+
+/**
+ * heap_size() - Return the number of ids in the heap.
+ * @h: Heap to inspect.
+ *
+ * Returns: The number of ids in the heap.
+ */
+int heap_size(const heap *h);
+
+/**
+ * heap_contains() - Check if an id is in the heap.
+ * @h: Heap to inspect.
+ * @id: Id to look for, at least zero.
+ *
+ * Returns: True if the id is in the heap, otherwise false.
+ */
+bool heap_contains(const heap *h, int id);
+
+/**
+ * heap_insert() - Put an id with a priority in the heap.
+ * @h: Heap to manipulate.
+ * @id: Id to insert, at least zero.
+ * @priority: Priority of the id.
+ *
+ * NOTE: Undefined if the id is already in the heap.
+ *
+ * Returns: Nothing.
+ */
+void heap_insert(heap *h, int id, int64_t priority);
+
+/**
+ * heap_priority() - Inspect the priority of an id in the heap.
+ * @h: Heap to inspect.
+ * @id: Id to inspect.
+ *
+ * NOTE: Undefined unless the id is in the heap.
+ *
+ * Returns: The priority of the id.
+ */
+int64_t heap_priority(const heap *h, int id);
+
+/**
+ * heap_decrease_priority() - Lower the priority of an id in the heap.
+ * @h: Heap to manipulate.
+ * @id: Id to change.
+ * @priority: New priority, at most the current priority of the id.
+ *
+ * NOTE: Undefined unless the id is in the heap.
+ *
+ * Returns: Nothing.
+ */
+void heap_decrease_priority(heap *h, int id, int64_t priority);
+
+/**
+ * heap_insert_or_decrease() - Insert an id or lower its priority.
+ * @h: Heap to manipulate.
+ * @id: Id to insert or change, at least zero.
+ * @priority: Priority of the id.
+ *
+ * Inserts the id if it is not in the heap. Otherwise lowers its
+ * priority if the given priority is lower than the current one.
+ *
+ * Returns: True if the id was inserted or its priority lowered,
+ *	    otherwise false.
+ */
+bool heap_insert_or_decrease(heap *h, int id, int64_t priority);
+
+/**
+ * heap_front() - Inspect the id with the lowest priority.
+ * @h: Heap to inspect.
+ *
+ * NOTE: Undefined for an empty heap.
+ *
+ * Returns: The id at the front of the heap.
+ */
+int heap_front(const heap *h);
+
+/**
+ * heap_front_priority() - Inspect the lowest priority in the heap.
+ * @h: Heap to inspect.
+ *
+ * NOTE: Undefined for an empty heap.
+ *
+ * Returns: The priority of the id at the front of the heap.
+ */
+int64_t heap_front_priority(const heap *h);
+
+/**
+ * heap_remove_front() - Remove the id with the lowest priority.
+ * @h: Heap to manipulate.
+ *
+ * NOTE: Undefined for an empty heap.
+ *
+ * Returns: The removed id.
+ */
+int heap_remove_front(heap *h);
+
+/**
+ * heap_clear() - Remove all ids from the heap.
+ * @h: Heap to manipulate.
+ *
+ * Returns: Nothing.
+ */
+void heap_clear(heap *h);
+
+/**
+ * heap_kill() - Destroy a given heap.
+ * @h: Heap to destroy.
+ *
+ * Returns: Nothing.
+ */
+void heap_kill(heap *h);
+
+#endif
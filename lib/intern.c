@@ -0,0 +1,401 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <intern.h>
+
+/*
+ * Implementation of a string interner.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: Short strings are packed into an integer.
+ *   v1.2 2026-10-18: Strings may be given as pointer and length.
+ *   v1.3 2026-10-18: Added intern_reserve.
+ *   v1.4 2026-10-18: Short strings with a NUL inside are not packed.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Initial number of index slots, a power of two.
+#define INTERN_INITIAL_SLOTS 16
+
+// Initial number of bytes for the characters.
+#define INTERN_INITIAL_CHARS 256
+
+// Key of a string that is too long to be packed. No packed string has
+// a non-zero last byte.
+#define INTERN_LONG UINT64_MAX
+
+/*
+ * A string of at most 7 characters is packed with its NUL into the
+ * 64-bit key of its id, which is then also where the string is read
+ * from. Such strings are hashed and compared as integers. The key of
+ * a longer string is INTERN_LONG, and the string is stored with its NUL
+ * at chars+offsets[id]. offsets[id+1] is where the next long string
+ * starts. A short string with a NUL among its characters is stored as a
+ * long one, since the zero padding of a packed key would make it equal
+ * to the string that ends at that NUL.
+ *
+ * The index is an open addressing table with linear probing that holds
+ * id+1 for every string, 0 for an empty slot. It is kept at most half
+ * full. The lower half of the hash of every string is kept by id, so
+ * the index can grow without hashing the strings again and most
+ * mismatches are found without comparing strings.
+ */
+struct intern {
+	char *chars; // The long strings, back to back.
+	size_t chars_capacity; // Number of bytes there is room for.
+	size_t *offsets; // Start of every long string, plus the end of the last.
+	uint64_t *keys; // Packed string or INTERN_LONG for every string.
+	uint32_t *hashes; // Lower half of the hash of every string.
+	int size; // Number of strings.
+	int ids_capacity; // Number of ids there is room for.
+	int32_t *slots; // The index.
+	int slots_capacity; // Number of slots, a power of two.
+	const allocator *alloc;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * intern_grow() - Internal function to resize memory.
+ * @in: Interner the memory belongs to.
+ * @p: Memory to resize, or NULL.
+ * @old_size: Current size of the memory in bytes.
+ * @new_size: New size in bytes.
+ *
+ * Exits the program if not enough memory was available.
+ *
+ * Returns: A pointer to the resized memory.
+ */
+static void *intern_grow(intern *in, void *p, size_t old_size, size_t new_size)
+{
+	p=allocator_realloc(in->alloc, p, old_size, new_size);
+	if (p == NULL) {
+		fprintf(stderr, "intern: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	return p;
+}
+
+/**
+ * intern_pack() - Internal function to pack a short string.
+ * @s: Characters of the string.
+ * @len: Number of characters.
+ *
+ * Returns: The characters and NUL of the string in the bytes of an
+ *	    integer, or INTERN_LONG if the string is longer than 7
+ *	    characters or has a NUL among them.
+ */
+static uint64_t intern_pack(const char *s, size_t len)
+{
+	if (len >= sizeof(uint64_t) || memchr(s, '\0', len) != NULL) {
+		return INTERN_LONG;
+	}
+	uint64_t key=0;
+	memcpy(&key, s, len);
+	return key;
+}
+
+/**
+ * intern_hash() - Internal function to hash a string.
+ * @s: Characters of the string.
+ * @len: Number of characters.
+ * @key: Packed string, or INTERN_LONG.
+ *
+ * A packed string is hashed with the finalizer of the splitmix64
+ * generator, a long one with 64-bit FNV-1a followed by a final mix.
+ *
+ * Returns: The lower half of the hash.
+ */
+static uint32_t intern_hash(const char *s, size_t len, uint64_t key)
+{
+	if (key == INTERN_LONG) {
+		uint64_t h=14695981039346656037ull;
+		for (size_t i=0; i<len; i++) {
+			h=(h ^ (unsigned char)s[i]) * 1099511628211ull;
+		}
+		h^=h >> 33;
+		h*=0xff51afd7ed558ccdull;
+		return h ^ (h >> 33);
+	}
+	key=(key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+	key=(key ^ (key >> 27)) * 0x94d049bb133111ebull;
+	return key ^ (key >> 31);
+}
+
+/**
+ * intern_find() - Internal function to find the slot of a string.
+ * @in: Interner to inspect.
+ * @s: Characters of the string to look for.
+ * @len: Number of characters.
+ * @key: Packed string, or INTERN_LONG.
+ * @h: Lower half of the hash of the string.
+ *
+ * Returns: The index of the slot holding the id of the string, or of
+ *	    the empty slot where it would be placed.
+ */
+static uint32_t intern_find(const intern *in, const char *s, size_t len, uint64_t key,
+			    uint32_t h)
+{
+	uint32_t mask=in->slots_capacity-1;
+	uint32_t i=h & mask;
+
+	while (in->slots[i] != 0) {
+		int id=in->slots[i]-1;
+		// Packed strings are equal if their keys are, long ones are compared.
+		if (in->keys[id] == key && (key != INTERN_LONG ||
+					    (in->hashes[id] == h &&
+					     in->offsets[id+1]-in->offsets[id] == len+1 &&
+					     memcmp(in->chars+in->offsets[id], s, len) == 0))) {
+			return i;
+		}
+		i=(i+1) & mask;
+	}
+	return i;
+}
+
+/**
+ * intern_rehash() - Internal function to change the number of slots.
+ * @in: Interner to manipulate.
+ * @capacity: New number of slots, a power of two larger than twice the
+ *	      number of strings.
+ *
+ * Returns: Nothing.
+ */
+static void intern_rehash(intern *in, int capacity)
+{
+	allocator_free(in->alloc, in->slots);
+	in->slots_capacity=capacity;
+	in->slots=allocator_calloc(in->alloc, in->slots_capacity, sizeof(int32_t));
+	if (in->slots == NULL) {
+		fprintf(stderr, "intern: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+
+	uint32_t mask=in->slots_capacity-1;
+	for (int id=0; id<in->size; id++) {
+		uint32_t i=in->hashes[id] & mask;
+		while (in->slots[i] != 0) {
+			i=(i+1) & mask;
+		}
+		in->slots[i]=id+1;
+	}
+}
+
+/**
+ * intern_grow_ids() - Internal function to make room for more ids.
+ * @in: Interner to manipulate.
+ * @capacity: New number of ids, larger than the current one.
+ *
+ * Returns: Nothing.
+ */
+static void intern_grow_ids(intern *in, int capacity)
+{
+	in->offsets=intern_grow(in, in->offsets, (in->ids_capacity+1) * sizeof(size_t),
+				(capacity+1) * sizeof(size_t));
+	in->keys=intern_grow(in, in->keys, in->ids_capacity * sizeof(uint64_t),
+			     capacity * sizeof(uint64_t));
+	in->hashes=intern_grow(in, in->hashes, in->ids_capacity * sizeof(uint32_t),
+			       capacity * sizeof(uint32_t));
+	in->ids_capacity=capacity;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * intern_empty() - Create an empty interner.
+ * @a: Allocator for the interner, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new interner.
+ */
+intern *intern_empty(const allocator *a)
+{
+	intern *in=allocator_calloc(a, 1, sizeof(*in));
+	in->alloc=a;
+	in->chars_capacity=INTERN_INITIAL_CHARS;
+	in->chars=allocator_alloc(a, in->chars_capacity);
+	in->ids_capacity=INTERN_INITIAL_SLOTS/2;
+	in->offsets=allocator_calloc(a, in->ids_capacity+1, sizeof(size_t));
+	in->keys=allocator_alloc(a, in->ids_capacity * sizeof(uint64_t));
+	in->hashes=allocator_alloc(a, in->ids_capacity * sizeof(uint32_t));
+	in->slots_capacity=INTERN_INITIAL_SLOTS;
+	in->slots=allocator_calloc(a, in->slots_capacity, sizeof(int32_t));
+
+	return in;
+}
+
+/**
+ * intern_size() - Return the number of strings in an interner.
+ * @in: Interner to inspect.
+ *
+ * Returns: The number of distinct strings, which is also the smallest
+ *	    id not in use.
+ */
+int intern_size(const intern *in)
+{
+	return in->size;
+}
+
+/**
+ * intern_reserve() - Make room for a number of strings.
+ * @in: Interner to modify.
+ * @n: Number of distinct strings the interner should be able to hold.
+ *
+ * Returns: Nothing.
+ */
+void intern_reserve(intern *in, int n)
+{
+	if (n > in->ids_capacity) {
+		intern_grow_ids(in, n);
+	}
+
+	// The index must stay at most half full after n strings.
+	int capacity=in->slots_capacity;
+	while (2 * n > capacity) {
+		capacity*=2;
+	}
+	if (capacity > in->slots_capacity) {
+		intern_rehash(in, capacity);
+	}
+}
+
+/**
+ * intern_insert() - Intern a string.
+ * @in: Interner to modify.
+ * @s: String to intern.
+ *
+ * Copies the string into the interner unless it is already there.
+ *
+ * Returns: The id of the string.
+ */
+int intern_insert(intern *in, const char *s)
+{
+	return intern_insert_n(in, s, strlen(s));
+}
+
+/**
+ * intern_insert_n() - Intern a string given by pointer and length.
+ * @in: Interner to modify.
+ * @s: Characters of the string, need not be NUL-terminated.
+ * @n: Number of characters.
+ *
+ * Returns: The id of the string.
+ */
+int intern_insert_n(intern *in, const char *s, size_t n)
+{
+	uint64_t key=intern_pack(s, n);
+	uint32_t h=intern_hash(s, n, key);
+	uint32_t i=intern_find(in, s, n, key, h);
+	if (in->slots[i] != 0) {
+		return in->slots[i]-1;
+	}
+
+	// Make room for the id and the characters.
+	if (in->size == in->ids_capacity) {
+		intern_grow_ids(in, 2*in->ids_capacity);
+	}
+	// Only long strings take room among the characters.
+	size_t start=in->offsets[in->size];
+	size_t len=(key == INTERN_LONG) ? n+1 : 0;
+	if (start+len > in->chars_capacity) {
+		size_t capacity=in->chars_capacity;
+		while (start+len > capacity) {
+			capacity*=2;
+		}
+		in->chars=intern_grow(in, in->chars, in->chars_capacity, capacity);
+		in->chars_capacity=capacity;
+	}
+
+	// Append the string.
+	int id=in->size++;
+	if (len > 0) {
+		memcpy(in->chars+start, s, n);
+		in->chars[start+n]='\0';
+	}
+	in->offsets[id+1]=start+len;
+	in->keys[id]=key;
+	in->hashes[id]=h;
+	in->slots[i]=id+1;
+
+	// Keep the index at most half full.
+	if (2 * in->size > in->slots_capacity) {
+		intern_rehash(in, 2*in->slots_capacity);
+	}
+	return id;
+}
+
+/**
+ * intern_lookup() - Find the id of a string.
+ * @in: Interner to inspect.
+ * @s: String to look up.
+ *
+ * Returns: The id of the string, or -1 if it is not interned.
+ */
+int intern_lookup(const intern *in, const char *s)
+{
+	return intern_lookup_n(in, s, strlen(s));
+}
+
+/**
+ * intern_lookup_n() - Find the id of a string given by pointer and length.
+ * @in: Interner to inspect.
+ * @s: Characters of the string, need not be NUL-terminated.
+ * @n: Number of characters.
+ *
+ * Returns: The id of the string, or -1 if it is not interned.
+ */
+int intern_lookup_n(const intern *in, const char *s, size_t n)
+{
+	uint64_t key=intern_pack(s, n);
+	return in->slots[intern_find(in, s, n, key, intern_hash(s, n, key))]-1;
+}
+
+/**
+ * intern_string() - Return an interned string.
+ * @in: Interner to inspect.
+ * @id: Id of the string.
+ *
+ * Returns: A pointer to the interned copy of the string. The pointer
+ *	    is valid until the next call to intern_insert().
+ */
+const char *intern_string(const intern *in, int id)
+{
+	if (in->keys[id] != INTERN_LONG) {
+		return (const char *)&in->keys[id];
+	}
+	return in->chars+in->offsets[id];
+}
+
+/**
+ * intern_length() - Return the length of an interned string.
+ * @in: Interner to inspect.
+ * @id: Id of the string.
+ *
+ * Returns: The number of characters in the string.
+ */
+int intern_length(const intern *in, int id)
+{
+	if (in->keys[id] != INTERN_LONG) {
+		return strlen((const char *)&in->keys[id]);
+	}
+	return in->offsets[id+1]-in->offsets[id]-1;
+}
+
+/**
+ * intern_kill() - Destroy an interner.
+ * @in: Interner to destroy.
+ *
+ * Returns: Nothing.
+ */
+void intern_kill(intern *in)
+{
+	allocator_free(in->alloc, in->chars);
+	allocator_free(in->alloc, in->offsets);
+	allocator_free(in->alloc, in->keys);
+	allocator_free(in->alloc, in->hashes);
+	allocator_free(in->alloc, in->slots);
+	allocator_free(in->alloc, in);
+}
@@ -0,0 +1,139 @@
+#ifndef __INTERN_H
+#define __INTERN_H
+
+#include <stddef.h>
+#include "util.h"
+#include "allocator.h"
+
+/*
+ * Declaration of a string interner, e.g. for the node labels of a
+ * graph. Every distinct string inserted gets an integer id: 0 for the
+ * first string, 1 for the second, and so on. Inserting a string that
+ * is already interned returns its old id, so two strings are equal
+ * exactly when their ids are.
+ *
+ * Strings of at most 7 characters, like airport codes, are packed into
+ * a 64-bit integer per id and are hashed and compared as integers.
+ * Longer strings are copied back to back into one growing block of
+ * characters and are found by their offsets. Either way interning n
+ * strings makes O(log n) allocations rather than n. A hash index over
+ * the ids finds the id of a string.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: Short strings are packed into an integer.
+ *   v1.2 2026-10-18: Added intern_insert_n and intern_lookup_n.
+ *   v1.3 2026-10-18: Added intern_reserve.
+ *   v1.4 2026-10-18: Strings given by length may hold a NUL.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Interner type.
+typedef struct intern intern;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * intern_empty() - Create an empty interner.
+ * @a: Allocator for the interner, or NULL for the default allocator.
+ *
+ * Returns: A pointer to the new interner.
+ */
+intern *intern_empty(const allocator *a);
+
+/**
+ * intern_size() - Return the number of strings in an interner.
+ * @in: Interner to inspect.
+ *
+ * Returns: The number of distinct strings, which is also the smallest
+ *	    id not in use.
+ */
+int intern_size(const intern *in);
+
+/**
+ * intern_reserve() - Make room for a number of strings.
+ * @in: Interner to modify.
+ * @n: Number of distinct strings the interner should be able to hold.
+ *
+ * Sizes the ids and the hash index so that the interner can hold n
+ * strings without growing them. The characters of long strings still
+ * grow as needed.
+ *
+ * Returns: Nothing.
+ */
+void intern_reserve(intern *in, int n);
+
+/**
+ * intern_insert() - Intern a string.
+ * @in: Interner to modify.
+ * @s: String to intern.
+ *
+ * Copies the string into the interner unless it is already there.
+ *
+ * Returns: The id of the string.
+ */
+int intern_insert(intern *in, const char *s);
+
+/**
+ * intern_insert_n() - Intern a string given by pointer and length.
+ * @in: Interner to modify.
+ * @s: Characters of the string, need not be NUL-terminated.
+ * @n: Number of characters.
+ *
+ * Like intern_insert(), for strings that are views into a larger
+ * buffer. The interned copy is NUL-terminated. The characters may
+ * include a NUL, so "A" and the two characters "A\0" are different
+ * strings, and intern_length() tells the length of such a copy.
+ *
+ * Returns: The id of the string.
+ */
+int intern_insert_n(intern *in, const char *s, size_t n);
+
+/**
+ * intern_lookup() - Find the id of a string.
+ * @in: Interner to inspect.
+ * @s: String to look up.
+ *
+ * Returns: The id of the string, or -1 if it is not interned.
+ */
+int intern_lookup(const intern *in, const char *s);
+
+/**
+ * intern_lookup_n() - Find the id of a string given by pointer and length.
+ * @in: Interner to inspect.
+ * @s: Characters of the string, need not be NUL-terminated.
+ * @n: Number of characters.
+ *
+ * Returns: The id of the string, or -1 if it is not interned.
+ */
+int intern_lookup_n(const intern *in, const char *s, size_t n);
+
+/**
+ * intern_string() - Return an interned string.
+ * @in: Interner to inspect.
+ * @id: Id of the string.
+ *
+ * Returns: A pointer to the interned copy of the string. The pointer
+ *	    is valid until the next call to intern_insert().
+ */
+const char *intern_string(const intern *in, int id);
+
+/**
+ * intern_length() - Return the length of an interned string.
+ * @in: Interner to inspect.
+ * @id: Id of the string.
+ *
+ * Returns: The number of characters in the string.
+ */
+int intern_length(const intern *in, int id);
+
+/**
+ * intern_kill() - Destroy an interner.
+ * @in: Interner to destroy.
+ *
+ * Returns: Nothing.
+ */
+void intern_kill(intern *in);
+
+#endif
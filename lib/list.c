@@ -20,6 +20,8 @@
  *   v1.2 2023-01-20: Renamed list_pos_equal to list_pos_are_equal.
  *   v1.3 2023-02-25: Renamed list header fields head and tail.
  *   v1.4 2023-03-23: Renamed list_pos_are_equal to list_pos_is_equal.
+ *   v1.5 2026-10-18: Cells may be allocated from a pool.
+ *   v1.6 2026-10-18: Memory may come from an allocator.
  */
 
 // ===========INTERNAL DATA TYPES============
@@ -35,10 +37,18 @@ struct cell {
 	void *value;
 };
 
+/*
+ * If the list has a pool, all cells except the border cells are
+ * allocated from it. A private pool is killed together with the list,
+ * so the cells do not have to be freed one by one.
+ */
 struct list {
 	struct cell *head;
 	struct cell *tail;
 	free_function free_func;
+	pool *cells; // Pool for the cells, or NULL to use the allocator.
+	bool owns_cells; // True if the pool is private to the list.
+	const allocator *alloc; // Allocator for the list, its border cells and cells.
 };
 
 /*
@@ -53,13 +63,28 @@ struct list {
  * Returns: A pointer to the new list.
  */
 list *list_empty(free_function free_func)
+{
+	return list_empty_alloc(free_func, NULL);
+}
+
+/**
+ * list_empty_alloc() - Create an empty list that uses an allocator.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @a: Allocator for the list and its cells, or NULL for the default
+ *     allocator.
+ *
+ * Returns: A pointer to the new list.
+ */
+list *list_empty_alloc(free_function free_func, const allocator *a)
 {
 	// Allocate memory for the list head.
-	list *l = calloc(1, sizeof(list));
+	list *l = allocator_calloc(a, 1, sizeof(list));
+	l->alloc = a;
 
 	// Allocate memory for the border cells.
-	l->head = calloc(1, sizeof(struct cell));
-	l->tail = calloc(1, sizeof(struct cell));
+	l->head = allocator_calloc(a, 1, sizeof(struct cell));
+	l->tail = allocator_calloc(a, 1, sizeof(struct cell));
 
 	// Set consistent links between border elements.
 	l->head->next = l->tail;
@@ -71,6 +96,46 @@ list *list_empty(free_function free_func)
 	return l;
 }
 
+/**
+ * list_empty_pooled() - Create an empty list whose cells come from a pool.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @cells: A pool created by list_pool_create(), or NULL.
+ *
+ * If cells is NULL the list gets a private pool that is released in one
+ * go when the list is killed. Otherwise the cells are taken from and
+ * returned to the given pool, which may be shared by many lists and
+ * must outlive all of them.
+ *
+ * Returns: A pointer to the new list.
+ */
+list *list_empty_pooled(free_function free_func, pool *cells)
+{
+	list *l = list_empty(free_func);
+
+	if (cells == NULL) {
+		// Create a private pool.
+		l->cells = list_pool_create();
+		l->owns_cells = true;
+	} else {
+		l->cells = cells;
+	}
+
+	return l;
+}
+
+/**
+ * list_pool_create() - Create a pool for list cells.
+ *
+ * The pool must be pool_kill()-ed after all lists using it are killed.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *list_pool_create(void)
+{
+	return pool_create(sizeof(struct cell));
+}
+
 /**
  * list_is_empty() - Check if a list is empty.
  * @l: List to check.
@@ -178,7 +243,12 @@ void *list_inspect(const list * l, const list_pos p)
 list_pos list_insert(list * l, void *v, const list_pos p)
 {
 	// Allocate memory for a new cell.
-	list_pos elem = malloc(sizeof(struct cell));
+	list_pos elem;
+	if (l->cells != NULL) {
+		elem = pool_alloc(l->cells);
+	} else {
+		elem = allocator_alloc(l->alloc, sizeof(struct cell));
+	}
 
 	// Store the value.
 	elem->value = v;
@@ -217,7 +287,11 @@ list_pos list_remove(list *l, const list_pos p)
 		l->free_func(p->value);
 	}
 	// Free the memory allocated to the cell itself.
-	free(p);
+	if (l->cells != NULL) {
+		pool_free(l->cells, p);
+	} else {
+		allocator_free(l->alloc, p);
+	}
 	// Return the position of the next element.
 	return next_pos;
 }
@@ -234,6 +308,21 @@ list_pos list_remove(list *l, const list_pos p)
  */
 void list_kill(list * l)
 {
+	if (l->owns_cells) {
+		// Only the values need to be freed one by one, the cells
+		// go away with the private pool.
+		if (l->free_func != NULL) {
+			for (struct cell *c = l->head->next; c != l->tail; c = c->next) {
+				l->free_func(c->value);
+			}
+		}
+		pool_kill(l->cells);
+		allocator_free(l->alloc, l->head);
+		allocator_free(l->alloc, l->tail);
+		allocator_free(l->alloc, l);
+		return;
+	}
+
 	// Use public functions to traverse the list.
 
 	// Start with the first element (will be defined even for an
@@ -246,9 +335,9 @@ void list_kill(list * l)
 	}
 
 	// Free border elements and the list head.
-	free(l->head);
-	free(l->tail);
-	free(l);
+	allocator_free(l->alloc, l->head);
+	allocator_free(l->alloc, l->tail);
+	allocator_free(l->alloc, l);
 }
 
 /**
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include "util.h"
+#include "pool.h"
 
 /*
  * Declaration of a generic, undirected list for the "Datastructures
@@ -25,6 +26,8 @@
  *   v1.1 2023-01-19: Added list_pos_equal and list_pos_is_valid functions.
  *   v1.2 2023-01-20: Renamed list_pos_equal to list_pos_are_equal.
  *   v1.3 2023-03-23: Renamed list_pos_are_equal to list_pos_is_equal.
+ *   v1.4 2026-10-18: Added list_empty_pooled and list_pool_create.
+ *   v1.5 2026-10-18: Added list_empty_alloc.
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -46,6 +49,41 @@ typedef struct cell *list_pos;
  */
 list *list_empty(free_function free_func);
 
+/**
+ * list_empty_alloc() - Create an empty list that uses an allocator.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @a: Allocator for the list and its cells, or NULL for the default
+ *     allocator.
+ *
+ * Returns: A pointer to the new list.
+ */
+list *list_empty_alloc(free_function free_func, const allocator *a);
+
+/**
+ * list_empty_pooled() - Create an empty list whose cells come from a pool.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @cells: A pool created by list_pool_create(), or NULL.
+ *
+ * If cells is NULL the list gets a private pool that is released in one
+ * go when the list is killed. Otherwise the cells are taken from and
+ * returned to the given pool, which may be shared by many lists and
+ * must outlive all of them.
+ *
+ * Returns: A pointer to the new list.
+ */
+list *list_empty_pooled(free_function free_func, pool *cells);
+
+/**
+ * list_pool_create() - Create a pool for list cells.
+ *
+ * The pool must be pool_kill()-ed after all lists using it are killed.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *list_pool_create(void);
+
 /**
  * list_is_empty() - Check if a list is empty.
  * @l: List to check.
@@ -0,0 +1,185 @@
+// For mmap(), posix_madvise() and the file functions.
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <mapfile.h>
+
+/*
+ * Implementation of a read-only view of a whole file.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Size of the first buffer when a file that cannot be mapped is read.
+#define MAPFILE_READ_CHUNK 65536
+
+struct mapfile {
+	char *data; // Contents of the file.
+	size_t size; // Number of bytes in the file.
+	size_t mapped; // Number of bytes mapped, 0 if data was read with read().
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * mapfile_read() - Internal function to read a file into memory.
+ * @m: Map file to fill in.
+ * @fd: File to read, e.g. a pipe.
+ *
+ * Returns: 0 on success, -1 with errno set on failure.
+ */
+static int mapfile_read(mapfile *m, int fd)
+{
+	size_t capacity=MAPFILE_READ_CHUNK;
+	m->data=malloc(capacity);
+	m->size=0;
+	for (;;) {
+		if (m->data == NULL) {
+			errno=ENOMEM;
+			return -1;
+		}
+		ssize_t n=read(fd, m->data+m->size, capacity-m->size);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n < 0) {
+			free(m->data);
+			return -1;
+		}
+		if (n == 0) {
+			return 0;
+		}
+		m->size+=n;
+		if (m->size == capacity) {
+			capacity*=2;
+			char *larger=realloc(m->data, capacity);
+			if (larger == NULL) {
+				free(m->data);
+			}
+			m->data=larger;
+		}
+	}
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * mapfile_open() - Open a file and map it into memory.
+ * @path: Name of the file.
+ *
+ * Returns: A pointer to the new map file, or NULL if the file could
+ *	    not be opened or read, in which case errno is set.
+ */
+mapfile *mapfile_open(const char *path)
+{
+	int fd=open(path, O_RDONLY);
+	if (fd < 0) {
+		return NULL;
+	}
+
+	mapfile *m=calloc(1, sizeof(*m));
+	struct stat st;
+	if (m == NULL || fstat(fd, &st) != 0) {
+		int err=(m == NULL) ? ENOMEM : errno;
+		free(m);
+		close(fd);
+		errno=err;
+		return NULL;
+	}
+
+	// Map regular files, the mapping stays valid after the file is closed.
+	if (S_ISREG(st.st_mode) && st.st_size > 0) {
+		void *p=mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p != MAP_FAILED) {
+			// The file is parsed from start to end, so ask for read-ahead.
+			posix_madvise(p, st.st_size, POSIX_MADV_SEQUENTIAL);
+			m->data=p;
+			m->size=st.st_size;
+			m->mapped=st.st_size;
+			close(fd);
+			return m;
+		}
+	}
+
+	// Read everything else, including empty files.
+	if (mapfile_read(m, fd) != 0) {
+		int err=errno;
+		free(m);
+		close(fd);
+		errno=err;
+		return NULL;
+	}
+	close(fd);
+	return m;
+}
+
+/**
+ * mapfile_data() - Return the contents of a map file.
+ * @m: Map file to inspect.
+ *
+ * Returns: A pointer to the first byte of the file, valid until
+ *	    mapfile_close().
+ */
+const char *mapfile_data(const mapfile *m)
+{
+	return m->data;
+}
+
+/**
+ * mapfile_size() - Return the size of a map file.
+ * @m: Map file to inspect.
+ *
+ * Returns: The number of bytes in the file.
+ */
+size_t mapfile_size(const mapfile *m)
+{
+	return m->size;
+}
+
+/**
+ * mapfile_next_line() - Find the next line of a map file.
+ * @m: Map file to inspect.
+ * @pos: Offset to start at, set to the offset of the following line.
+ * @len: Set to the length of the line, without the newline.
+ *
+ * Returns: A pointer to the first character of the line, or NULL if
+ *	    there are no more lines.
+ */
+const char *mapfile_next_line(const mapfile *m, size_t *pos, size_t *len)
+{
+	if (*pos >= m->size) {
+		return NULL;
+	}
+	const char *line=m->data+*pos;
+	const char *nl=memchr(line, '\n', m->size-*pos);
+	*len=(nl != NULL) ? (size_t)(nl-line) : m->size-*pos;
+	*pos+=*len+1;
+	return line;
+}
+
+/**
+ * mapfile_close() - Unmap and close a map file.
+ * @m: Map file to close.
+ *
+ * Returns: Nothing.
+ */
+void mapfile_close(mapfile *m)
+{
+	if (m->mapped > 0) {
+		munmap(m->data, m->mapped);
+	} else {
+		free(m->data);
+	}
+	free(m);
+}
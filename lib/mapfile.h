@@ -0,0 +1,79 @@
+#ifndef __MAPFILE_H
+#define __MAPFILE_H
+
+#include <stddef.h>
+#include "util.h"
+
+/*
+ * Declaration of a read-only view of a whole file, e.g. a map file to
+ * be parsed. A regular file is memory mapped, so reading it costs page
+ * faults rather than copies, and tokens can be used as (pointer,
+ * length) views into the file without copying them. Other files, such
+ * as pipes, are read into memory.
+ *
+ * The contents are not NUL-terminated. The last line need not end
+ * with a newline.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Map file type.
+typedef struct mapfile mapfile;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * mapfile_open() - Open a file and map it into memory.
+ * @path: Name of the file.
+ *
+ * Returns: A pointer to the new map file, or NULL if the file could
+ *	    not be opened or read, in which case errno is set.
+ */
+mapfile *mapfile_open(const char *path);
+
+/**
+ * mapfile_data() - Return the contents of a map file.
+ * @m: Map file to inspect.
+ *
+ * Returns: A pointer to the first byte of the file, valid until
+ *	    mapfile_close().
+ */
+const char *mapfile_data(const mapfile *m);
+
+/**
+ * mapfile_size() - Return the size of a map file.
+ * @m: Map file to inspect.
+ *
+ * Returns: The number of bytes in the file.
+ */
+size_t mapfile_size(const mapfile *m);
+
+/**
+ * mapfile_next_line() - Find the next line of a map file.
+ * @m: Map file to inspect.
+ * @pos: Offset to start at, set to the offset of the following line.
+ * @len: Set to the length of the line, without the newline.
+ *
+ * Iterate over the lines with:
+ *
+ *	size_t pos = 0, len;
+ *	const char *line;
+ *	while ((line = mapfile_next_line(m, &pos, &len)) != NULL)
+ *
+ * Returns: A pointer to the first character of the line, or NULL if
+ *	    there are no more lines.
+ */
+const char *mapfile_next_line(const mapfile *m, size_t *pos, size_t *len);
+
+/**
+ * mapfile_close() - Unmap and close a map file.
+ * @m: Map file to close.
+ *
+ * Returns: Nothing.
+ */
+void mapfile_close(mapfile *m);
+
+#endif
@@ -0,0 +1,413 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <mapimage.h>
+#include <mapfile.h>
+
+/*
+ * Implementation of a compiled binary image of a map.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: map_image_write() returns the number of edges.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// First bytes of every image.
+#define MAP_IMAGE_MAGIC "MAPIMAGE"
+
+// Version of the format, changed whenever the layout changes.
+#define MAP_IMAGE_VERSION 1
+
+// Stored as is, so it reads differently on a machine of the other byte order.
+#define MAP_IMAGE_BYTE_ORDER 0x01020304u
+
+// Alignment of every section.
+#define MAP_IMAGE_ALIGN 8
+
+// The header at the start of an image. The section fields are offsets
+// from the start of the file.
+struct map_image_header {
+	char magic[8];
+	uint32_t byte_order;
+	uint32_t version;
+	uint32_t n_nodes;
+	uint32_t n_slots;
+	uint32_t n_edges;
+	uint32_t reserved; // Always 0.
+	uint64_t chars_size;
+	uint64_t label_offsets;
+	uint64_t chars;
+	uint64_t slots;
+	uint64_t edge_offsets;
+	uint64_t edge_targets;
+};
+
+struct map_image {
+	mapfile *file;
+	const struct map_image_header *h;
+	const uint32_t *label_offsets;
+	const char *chars;
+	const uint32_t *slots;
+	const uint32_t *edge_offsets;
+	const uint32_t *edge_targets;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * map_image_hash() - Internal function to hash a label.
+ * @s: Characters of the label.
+ * @len: Number of characters.
+ *
+ * The hash is part of the format, 64-bit FNV-1a.
+ *
+ * Returns: The hash of the label.
+ */
+static uint64_t map_image_hash(const char *s, size_t len)
+{
+	uint64_t h=14695981039346656037ull;
+	for (size_t i=0; i<len; i++) {
+		h=(h ^ (unsigned char)s[i]) * 1099511628211ull;
+	}
+	return h;
+}
+
+/**
+ * map_image_align() - Internal function to round an offset up to the
+ *		       alignment of the sections.
+ * @offset: Offset to round.
+ *
+ * Returns: The rounded offset.
+ */
+static uint64_t map_image_align(uint64_t offset)
+{
+	return (offset + MAP_IMAGE_ALIGN - 1) & ~(uint64_t)(MAP_IMAGE_ALIGN - 1);
+}
+
+/**
+ * map_image_put() - Internal function to write a section.
+ * @f: File to write to.
+ * @pos: Offset of the file position, updated.
+ * @offset: Offset of the section, at least *pos.
+ * @p: Contents of the section.
+ * @size: Number of bytes in the section.
+ *
+ * Returns: True on success.
+ */
+static bool map_image_put(FILE *f, uint64_t *pos, uint64_t offset, const void *p, size_t size)
+{
+	static const char zeros[MAP_IMAGE_ALIGN];
+
+	if (offset > *pos && fwrite(zeros, 1, offset - *pos, f) != offset - *pos) {
+		return false;
+	}
+	*pos=offset+size;
+	return size == 0 || fwrite(p, 1, size, f) == size;
+}
+
+/**
+ * map_image_build_csr() - Internal function to build the edge sections.
+ * @scan: Labels and edges of the map.
+ * @offsets: Array of n_nodes+1 offsets to fill in.
+ * @n_edges: Set to the number of edges without duplicates.
+ *
+ * The edges are grouped by source with a counting sort, which keeps the
+ * order of the file, and the duplicates of every node are dropped.
+ *
+ * Returns: The destination ids, or NULL if out of memory.
+ */
+static uint32_t *map_image_build_csr(const map_scan *scan, uint32_t *offsets, uint32_t *n_edges)
+{
+	int n=intern_size(scan->labels);
+	uint32_t *targets=malloc((scan->n_edges > 0 ? scan->n_edges : 1) * sizeof(uint32_t));
+	uint32_t *next=malloc((n > 0 ? n : 1) * sizeof(uint32_t));
+	if (targets == NULL || next == NULL) {
+		free(targets);
+		free(next);
+		return NULL;
+	}
+
+	// Group the edges by source.
+	uint32_t sum=0;
+	for (int i=0; i<n; i++) {
+		next[i]=sum;
+		sum+=scan->out_degree[i];
+	}
+	for (int i=0; i<scan->n_edges; i++) {
+		targets[next[scan->edges[i].src]++]=scan->edges[i].dest;
+	}
+
+	// Drop duplicates in place. next[] is reused to hold, for every
+	// destination, the number of the last node that had an edge to it,
+	// plus one.
+	memset(next, 0, (n > 0 ? n : 1) * sizeof(uint32_t));
+	uint32_t from=0;
+	uint32_t to=0;
+	for (int i=0; i<n; i++) {
+		uint32_t end=from+scan->out_degree[i];
+		offsets[i]=to;
+		for (; from<end; from++) {
+			uint32_t t=targets[from];
+			if (next[t] != (uint32_t)i+1) {
+				next[t]=i+1;
+				targets[to++]=t;
+			}
+		}
+	}
+	offsets[n]=to;
+	*n_edges=to;
+
+	free(next);
+	return targets;
+}
+
+/**
+ * map_image_section_ok() - Internal function to check a section of an image.
+ * @offset: Offset of the section.
+ * @count: Number of elements.
+ * @elem_size: Size of an element.
+ * @file_size: Size of the file.
+ *
+ * Returns: True if the section is aligned and lies within the file.
+ */
+static bool map_image_section_ok(uint64_t offset, uint64_t count, size_t elem_size,
+				 size_t file_size)
+{
+	return offset % MAP_IMAGE_ALIGN == 0 && offset >= sizeof(struct map_image_header) &&
+		offset <= file_size && count <= (file_size - offset) / elem_size;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * map_image_write() - Compile a scanned map into an image file.
+ * @path: Name of the image file, created or truncated.
+ * @scan: Labels and edges of the map.
+ *
+ * Returns: The number of edges written, which leaves out the duplicate
+ *	    edges of the scan, or -1 with errno set on failure.
+ */
+int map_image_write(const char *path, const map_scan *scan)
+{
+	int n=intern_size(scan->labels);
+	struct map_image_header h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, MAP_IMAGE_MAGIC, sizeof(h.magic));
+	h.byte_order=MAP_IMAGE_BYTE_ORDER;
+	h.version=MAP_IMAGE_VERSION;
+	h.n_nodes=n;
+
+	// The labels with their NULs must be addressable by 32-bit offsets,
+	// and the index must fit 32-bit slot numbers.
+	uint64_t chars_size=0;
+	for (int id=0; id<n; id++) {
+		chars_size+=intern_length(scan->labels, id) + 1;
+	}
+	if (chars_size > UINT32_MAX || n > (1 << 30)) {
+		errno=EOVERFLOW;
+		return -1;
+	}
+	h.chars_size=chars_size;
+
+	// The index is at most half full.
+	h.n_slots=2;
+	while (h.n_slots < 2 * (uint64_t)n) {
+		h.n_slots*=2;
+	}
+
+	uint32_t *label_offsets=malloc((n+1) * sizeof(uint32_t));
+	char *chars=malloc(chars_size > 0 ? chars_size : 1);
+	uint32_t *slots=calloc(h.n_slots, sizeof(uint32_t));
+	uint32_t *edge_offsets=malloc((n+1) * sizeof(uint32_t));
+	uint32_t *edge_targets=NULL;
+	if (label_offsets != NULL && chars != NULL && slots != NULL && edge_offsets != NULL) {
+		edge_targets=map_image_build_csr(scan, edge_offsets, &h.n_edges);
+	}
+
+	FILE *f=NULL;
+	bool ok=false;
+	if (edge_targets == NULL) {
+		errno=ENOMEM;
+	} else {
+		// Copy the labels and index them.
+		uint32_t pos=0;
+		for (int id=0; id<n; id++) {
+			const char *s=intern_string(scan->labels, id);
+			size_t len=intern_length(scan->labels, id);
+			label_offsets[id]=pos;
+			memcpy(chars+pos, s, len+1);
+			pos+=len+1;
+
+			uint32_t i=map_image_hash(s, len) & (h.n_slots-1);
+			while (slots[i] != 0) {
+				i=(i+1) & (h.n_slots-1);
+			}
+			slots[i]=id+1;
+		}
+		label_offsets[n]=pos;
+
+		// Lay out the sections after the header.
+		h.label_offsets=map_image_align(sizeof(h));
+		h.chars=map_image_align(h.label_offsets + (n+1) * sizeof(uint32_t));
+		h.slots=map_image_align(h.chars + chars_size);
+		h.edge_offsets=map_image_align(h.slots + h.n_slots * sizeof(uint32_t));
+		h.edge_targets=map_image_align(h.edge_offsets + (n+1) * sizeof(uint32_t));
+
+		f=fopen(path, "wb");
+	}
+
+	if (f != NULL) {
+		uint64_t at=0;
+		ok=map_image_put(f, &at, 0, &h, sizeof(h)) &&
+			map_image_put(f, &at, h.label_offsets, label_offsets, (n+1) * sizeof(uint32_t)) &&
+			map_image_put(f, &at, h.chars, chars, chars_size) &&
+			map_image_put(f, &at, h.slots, slots, h.n_slots * sizeof(uint32_t)) &&
+			map_image_put(f, &at, h.edge_offsets, edge_offsets, (n+1) * sizeof(uint32_t)) &&
+			map_image_put(f, &at, h.edge_targets, edge_targets, h.n_edges * sizeof(uint32_t));
+		int err=errno;
+		if (fclose(f) != 0 && ok) {
+			err=errno;
+			ok=false;
+		}
+		errno=err;
+	}
+
+	free(label_offsets);
+	free(chars);
+	free(slots);
+	free(edge_offsets);
+	free(edge_targets);
+	return ok ? (int)h.n_edges : -1;
+}
+
+/**
+ * map_image_open() - Map an image file into memory.
+ * @path: Name of the image file.
+ *
+ * Returns: A pointer to the image, or NULL if the file could not be
+ *	    opened or is not a valid image.
+ */
+map_image *map_image_open(const char *path)
+{
+	mapfile *file=mapfile_open(path);
+	if (file == NULL) {
+		return NULL;
+	}
+	const char *data=mapfile_data(file);
+	size_t size=mapfile_size(file);
+	const struct map_image_header *h=(const void *)data;
+
+	// Only the header is checked, so opening takes the same time for
+	// every image.
+	bool ok=size >= sizeof(*h) && memcmp(h->magic, MAP_IMAGE_MAGIC, sizeof(h->magic)) == 0 &&
+		h->byte_order == MAP_IMAGE_BYTE_ORDER && h->version == MAP_IMAGE_VERSION &&
+		h->n_slots > 0 && (h->n_slots & (h->n_slots-1)) == 0 &&
+		map_image_section_ok(h->label_offsets, (uint64_t)h->n_nodes+1, sizeof(uint32_t), size) &&
+		map_image_section_ok(h->chars, h->chars_size, 1, size) &&
+		map_image_section_ok(h->slots, h->n_slots, sizeof(uint32_t), size) &&
+		map_image_section_ok(h->edge_offsets, (uint64_t)h->n_nodes+1, sizeof(uint32_t), size) &&
+		map_image_section_ok(h->edge_targets, h->n_edges, sizeof(uint32_t), size) &&
+		h->n_nodes <= INT32_MAX &&
+		(h->chars_size == 0 || data[h->chars + h->chars_size - 1] == '\0');
+	map_image *img=ok ? malloc(sizeof(*img)) : NULL;
+	if (img == NULL) {
+		mapfile_close(file);
+		errno=ok ? ENOMEM : EINVAL;
+		return NULL;
+	}
+
+	img->file=file;
+	img->h=h;
+	img->label_offsets=(const uint32_t *)(data + h->label_offsets);
+	img->chars=data + h->chars;
+	img->slots=(const uint32_t *)(data + h->slots);
+	img->edge_offsets=(const uint32_t *)(data + h->edge_offsets);
+	img->edge_targets=(const uint32_t *)(data + h->edge_targets);
+	return img;
+}
+
+/**
+ * map_image_n_nodes() - Return the number of nodes of an image.
+ * @img: Image to inspect.
+ *
+ * Returns: The number of nodes, whose ids are 0 to n-1.
+ */
+int map_image_n_nodes(const map_image *img)
+{
+	return img->h->n_nodes;
+}
+
+/**
+ * map_image_find() - Find the id of a label.
+ * @img: Image to inspect.
+ * @s: Label to look up.
+ *
+ * Returns: The id of the node with the label, or -1 if there is none.
+ */
+int map_image_find(const map_image *img, const char *s)
+{
+	uint32_t mask=img->h->n_slots-1;
+	uint32_t i=map_image_hash(s, strlen(s)) & mask;
+
+	// A damaged index may have no empty slot, so probe each slot once.
+	for (uint32_t probes=0; probes<=mask; probes++) {
+		uint32_t v=img->slots[i];
+		if (v == 0) {
+			return -1;
+		}
+		if (v <= img->h->n_nodes && strcmp(map_image_label(img, v-1), s) == 0) {
+			return v-1;
+		}
+		i=(i+1) & mask;
+	}
+	return -1;
+}
+
+/**
+ * map_image_label() - Return the label of a node.
+ * @img: Image to inspect.
+ * @id: Id of the node.
+ *
+ * Returns: A pointer into the image, valid until map_image_close().
+ */
+const char *map_image_label(const map_image *img, int id)
+{
+	uint32_t offset=img->label_offsets[id];
+	// The last character of the labels is a NUL, so every offset in
+	// range starts a NUL-terminated string.
+	return offset < img->h->chars_size ? img->chars + offset : "";
+}
+
+/**
+ * map_image_neighbours() - Return the destinations of the edges from a node.
+ * @img: Image to inspect.
+ * @id: Id of the node.
+ * @n: Set to the number of edges.
+ *
+ * Returns: A pointer to the ids of the destinations, valid until
+ *	    map_image_close().
+ */
+const uint32_t *map_image_neighbours(const map_image *img, int id, int *n)
+{
+	uint32_t first=img->edge_offsets[id];
+	uint32_t end=img->edge_offsets[id+1];
+	*n=(first <= end && end <= img->h->n_edges) ? (int)(end-first) : 0;
+	return img->edge_targets + (*n > 0 ? first : 0);
+}
+
+/**
+ * map_image_close() - Unmap an image.
+ * @img: Image to close.
+ *
+ * Returns: Nothing.
+ */
+void map_image_close(map_image *img)
+{
+	mapfile_close(img->file);
+	free(img);
+}
@@ -0,0 +1,118 @@
+#ifndef __MAPIMAGE_H
+#define __MAPIMAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "util.h"
+#include "mapscan.h"
+
+/*
+ * Declaration of a compiled binary image of a map. An image holds a
+ * map as read-only arrays at fixed offsets, so it can be memory mapped
+ * and used at once: opening an image costs the same for any map size,
+ * and nothing is parsed, allocated per node or fixed up.
+ *
+ * An image starts with a header, followed by these sections, each
+ * aligned to 8 bytes:
+ *
+ *   label_offsets  uint32_t[n_nodes+1]  Start of label i in chars, and
+ *					  the end of the last label.
+ *   chars          char[chars_size]     The labels, NUL-terminated.
+ *   slots          uint32_t[n_slots]    Hash index: id+1 of a label,
+ *					  or 0 for an empty slot.
+ *   edge_offsets   uint32_t[n_nodes+1]  First edge of node i in
+ *					  edge_targets, and the end of the
+ *					  last node (CSR).
+ *   edge_targets   uint32_t[n_edges]    Destination ids.
+ *
+ * The hash index is open addressing with linear probing, n_slots is a
+ * power of two at least twice n_nodes, and the home slot of a label is
+ * its 64-bit FNV-1a hash modulo n_slots. Node ids are in the order the
+ * labels first appear in the map file, and the edges of a node are in
+ * file order without duplicates.
+ *
+ * Integers are stored in the byte order of the machine that wrote the
+ * image. map_image_open() refuses images of the other byte order or of
+ * another version. It checks that every section lies within the file,
+ * and the accessors check the offsets they read, but the contents are
+ * otherwise trusted.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: map_image_write() returns the number of edges.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Image type.
+typedef struct map_image map_image;
+
+// ==========IMAGE INTERFACE==========
+
+/**
+ * map_image_write() - Compile a scanned map into an image file.
+ * @path: Name of the image file, created or truncated.
+ * @scan: Labels and edges of the map.
+ *
+ * Returns: The number of edges written, which leaves out the duplicate
+ *	    edges of the scan, or -1 with errno set on failure.
+ */
+int map_image_write(const char *path, const map_scan *scan);
+
+/**
+ * map_image_open() - Map an image file into memory.
+ * @path: Name of the image file.
+ *
+ * Returns: A pointer to the image, or NULL if the file could not be
+ *	    opened or is not a valid image. errno is set to EINVAL in
+ *	    the latter case.
+ */
+map_image *map_image_open(const char *path);
+
+/**
+ * map_image_n_nodes() - Return the number of nodes of an image.
+ * @img: Image to inspect.
+ *
+ * Returns: The number of nodes, whose ids are 0 to n-1.
+ */
+int map_image_n_nodes(const map_image *img);
+
+/**
+ * map_image_find() - Find the id of a label.
+ * @img: Image to inspect.
+ * @s: Label to look up.
+ *
+ * Returns: The id of the node with the label, or -1 if there is none.
+ */
+int map_image_find(const map_image *img, const char *s);
+
+/**
+ * map_image_label() - Return the label of a node.
+ * @img: Image to inspect.
+ * @id: Id of the node.
+ *
+ * Returns: A pointer into the image, valid until map_image_close().
+ */
+const char *map_image_label(const map_image *img, int id);
+
+/**
+ * map_image_neighbours() - Return the destinations of the edges from a node.
+ * @img: Image to inspect.
+ * @id: Id of the node.
+ * @n: Set to the number of edges.
+ *
+ * Returns: A pointer to the ids of the destinations, valid until
+ *	    map_image_close().
+ */
+const uint32_t *map_image_neighbours(const map_image *img, int id, int *n);
+
+/**
+ * map_image_close() - Unmap an image.
+ * @img: Image to close.
+ *
+ * Returns: Nothing.
+ */
+void map_image_close(map_image *img);
+
+#endif
@@ -0,0 +1,437 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+
+#include <mapline.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MAPLINE_X86 1
+#include <immintrin.h>
+#endif
+
+/*
+ * Implementation of a tokenizer for the lines of map files.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: Lines are scanned with bitmasks from SIMD compares.
+ *   v1.2 2026-10-18: Added map_lexer_use_implementation.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Classifier of one block of MAP_LEXER_BLOCK bytes into bitmasks.
+struct map_classify_ops {
+	const char *name;
+	void (*classify)(const char *p, uint64_t *space, uint64_t *newline, uint64_t *hash);
+};
+
+// ===========SCALAR IMPLEMENTATION============
+
+/**
+ * swar_eq() - Internal function to find the bytes of a word equal to a byte.
+ * @x: Eight bytes.
+ * @c: Byte to find.
+ *
+ * Returns: A mask with bit i set if byte i of x, in memory order, is c.
+ */
+static inline uint64_t swar_eq(uint64_t x, unsigned char c)
+{
+	const uint64_t low7=0x7f7f7f7f7f7f7f7fULL;
+	uint64_t v=x ^ (0x0101010101010101ULL * c);
+	// The high bit of a byte is set exactly when the byte of v is zero.
+	uint64_t zero=~(((v & low7) + low7) | v | low7);
+	// Gather the high bits of the bytes into the low byte.
+	return ((zero >> 7) * 0x0102040810204080ULL) >> 56;
+}
+
+/*
+ * Whitespace is what isspace() accepts in the C locale: ' ' and '\t'
+ * to '\r'. The newline is kept out of the space mask so that lines and
+ * tokens can be told apart. The bytes are compared eight at a time
+ * within a 64-bit word.
+ */
+static void classify_scalar(const char *p, uint64_t *space, uint64_t *newline, uint64_t *hash)
+{
+	uint64_t s=0, n=0, h=0;
+	for (int i=0; i<MAP_LEXER_BLOCK; i+=8) {
+		uint64_t x;
+		memcpy(&x, p+i, sizeof(x));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		x=__builtin_bswap64(x);
+#endif
+		uint64_t sp=swar_eq(x, ' ') | swar_eq(x, '\t') | swar_eq(x, '\v') |
+			swar_eq(x, '\f') | swar_eq(x, '\r');
+		s|=sp << i;
+		n|=swar_eq(x, '\n') << i;
+		h|=swar_eq(x, '#') << i;
+	}
+	*space=s;
+	*newline=n;
+	*hash=h;
+}
+
+static const struct map_classify_ops scalar_ops={
+	"scalar", classify_scalar
+};
+
+#ifdef MAPLINE_X86
+
+// ===========SSE2 IMPLEMENTATION============
+
+/*
+ * A byte c is in '\t'..'\r' when c-9, wrapping, is at most 4, which is
+ * tested with an unsigned minimum since SSE2 has no unsigned compare.
+ */
+__attribute__((target("sse2")))
+static void classify_sse2(const char *p, uint64_t *space, uint64_t *newline, uint64_t *hash)
+{
+	const __m128i blank=_mm_set1_epi8(' ');
+	const __m128i nl=_mm_set1_epi8('\n');
+	const __m128i sharp=_mm_set1_epi8('#');
+	const __m128i nine=_mm_set1_epi8(9);
+	const __m128i four=_mm_set1_epi8(4);
+	uint64_t s=0, n=0, h=0;
+
+	for (int i=0; i<MAP_LEXER_BLOCK; i+=16) {
+		__m128i x=_mm_loadu_si128((const __m128i *)(p+i));
+		__m128i t=_mm_sub_epi8(x, nine);
+		__m128i ctrl=_mm_cmpeq_epi8(_mm_min_epu8(t, four), t);
+		__m128i sp=_mm_or_si128(_mm_cmpeq_epi8(x, blank), ctrl);
+		s|=(uint64_t)(uint16_t)_mm_movemask_epi8(sp) << i;
+		n|=(uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, nl)) << i;
+		h|=(uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, sharp)) << i;
+	}
+	*space=s & ~n;
+	*newline=n;
+	*hash=h;
+}
+
+static const struct map_classify_ops sse2_ops={
+	"sse2", classify_sse2
+};
+
+// ===========AVX2 IMPLEMENTATION============
+
+__attribute__((target("avx2")))
+static void classify_avx2(const char *p, uint64_t *space, uint64_t *newline, uint64_t *hash)
+{
+	const __m256i blank=_mm256_set1_epi8(' ');
+	const __m256i nl=_mm256_set1_epi8('\n');
+	const __m256i sharp=_mm256_set1_epi8('#');
+	const __m256i nine=_mm256_set1_epi8(9);
+	const __m256i four=_mm256_set1_epi8(4);
+	uint64_t s=0, n=0, h=0;
+
+	for (int i=0; i<MAP_LEXER_BLOCK; i+=32) {
+		__m256i x=_mm256_loadu_si256((const __m256i *)(p+i));
+		__m256i t=_mm256_sub_epi8(x, nine);
+		__m256i ctrl=_mm256_cmpeq_epi8(_mm256_min_epu8(t, four), t);
+		__m256i sp=_mm256_or_si256(_mm256_cmpeq_epi8(x, blank), ctrl);
+		s|=(uint64_t)(uint32_t)_mm256_movemask_epi8(sp) << i;
+		n|=(uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, nl)) << i;
+		h|=(uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, sharp)) << i;
+	}
+	*space=s & ~n;
+	*newline=n;
+	*hash=h;
+}
+
+static const struct map_classify_ops avx2_ops={
+	"avx2", classify_avx2
+};
+
+#endif
+
+// ===========DISPATCH============
+
+// The block classifier in use.
+static const struct map_classify_ops *ops=&scalar_ops;
+
+#ifdef MAPLINE_X86
+/**
+ * map_select_ops() - Internal function to select the block classifier.
+ *
+ * Runs before main(), so the choice is made before any thread starts.
+ *
+ * Returns: Nothing.
+ */
+__attribute__((constructor))
+static void map_select_ops(void)
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		ops=&avx2_ops;
+	} else if (__builtin_cpu_supports("sse2")) {
+		ops=&sse2_ops;
+	}
+}
+#endif
+
+// The block classifiers, in order of preference.
+static const struct map_classify_ops *const all_ops[]={
+#ifdef MAPLINE_X86
+	&avx2_ops, &sse2_ops,
+#endif
+	&scalar_ops
+};
+
+/**
+ * map_cpu_supports() - Internal function to check if the processor runs a block classifier.
+ * @o: Block classifier.
+ *
+ * Returns: True if the block classifier can be used.
+ */
+static bool map_cpu_supports(const struct map_classify_ops *o)
+{
+#ifdef MAPLINE_X86
+	__builtin_cpu_init();
+	if (o == &avx2_ops) {
+		return __builtin_cpu_supports("avx2");
+	}
+	if (o == &sse2_ops) {
+		return __builtin_cpu_supports("sse2");
+	}
+#endif
+	return o == &scalar_ops;
+}
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * map_lexer_load() - Internal function to classify the next block of the buffer.
+ * @lx: Lexer to update.
+ *
+ * Every byte where a token starts or ends and every newline becomes an
+ * event bit, so a line is scanned by visiting its events in order. The
+ * last block is copied and padded with newlines, so the classifier
+ * never reads past the end of the buffer and the last token and line
+ * end at the end of it.
+ *
+ * Returns: Nothing.
+ */
+static void map_lexer_load(map_lexer *lx)
+{
+	const char *p=lx->data+lx->next;
+	char tail[MAP_LEXER_BLOCK];
+	uint64_t space, newline, hash;
+
+	if (lx->size-lx->next < MAP_LEXER_BLOCK) {
+		size_t n=lx->size-lx->next;
+		memcpy(tail, p, n);
+		memset(tail+n, '\n', MAP_LEXER_BLOCK-n);
+		p=tail;
+	}
+	ops->classify(p, &space, &newline, &hash);
+
+	// A token starts or ends where a byte differs in kind from the one
+	// before it, which for the first byte is the last of the previous
+	// block.
+	uint64_t token=~(space | newline);
+	uint64_t before=(token << 1) | lx->carry;
+	lx->events=(token ^ before) | newline;
+	lx->newline=newline;
+	lx->hash=hash;
+	lx->carry=token >> (MAP_LEXER_BLOCK-1);
+	lx->block=lx->next;
+	lx->next+=MAP_LEXER_BLOCK;
+}
+
+/**
+ * map_line_classify() - Internal function to set the kind of a scanned line.
+ * @l: Line with its tokens set.
+ * @comment: True if the line has a comment.
+ *
+ * Returns: The kind of the line.
+ */
+static map_line_kind map_line_classify(map_line *l, bool comment)
+{
+	if (l->n_tokens == 0) {
+		l->kind=comment ? MAP_LINE_COMMENT : MAP_LINE_BLANK;
+	} else if (l->n_tokens >= 2) {
+		l->kind=MAP_LINE_EDGE;
+	} else if (map_token_to_long(l->tokens[0], &l->count)) {
+		l->kind=MAP_LINE_COUNT;
+	} else {
+		l->kind=MAP_LINE_INVALID;
+	}
+	return l->kind;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * map_line_scan() - Classify a line and split it into tokens.
+ * @line: First character of the line.
+ * @len: Length of the line, without the newline.
+ * @l: Set to the kind and tokens of the line.
+ *
+ * Returns: The kind of the line.
+ */
+map_line_kind map_line_scan(const char *line, size_t len, map_line *l)
+{
+	map_lexer lx;
+
+	map_lexer_init(&lx, line, len);
+	if (!map_lexer_next(&lx, l)) {
+		l->n_tokens=0;
+		return map_line_classify(l, false);
+	}
+	return l->kind;
+}
+
+/**
+ * map_token_to_long() - Parse a token as an integer.
+ * @t: Token to parse.
+ * @value: Set to the integer if the token is one.
+ *
+ * Returns: True if the token is an integer, otherwise false.
+ */
+bool map_token_to_long(map_token t, long *value)
+{
+	size_t i=0;
+	bool negative=false;
+
+	if (i < t.len && (t.s[i] == '-' || t.s[i] == '+')) {
+		negative=(t.s[i] == '-');
+		i++;
+	}
+	if (i == t.len) {
+		return false;
+	}
+
+	// Accumulate as a negative number, which has the larger range.
+	long v=0;
+	for (; i<t.len; i++) {
+		int d=t.s[i]-'0';
+		if (d < 0 || d > 9) {
+			return false;
+		}
+		v=(v < (LONG_MIN+d)/10) ? LONG_MIN : 10*v-d;
+	}
+	if (!negative) {
+		v=(v == LONG_MIN) ? LONG_MAX : -v;
+	}
+	*value=v;
+	return true;
+}
+
+/**
+ * map_lexer_init() - Start lexing a buffer.
+ * @lx: Lexer to initialize.
+ * @data: First byte of the buffer, need not be NUL-terminated.
+ * @size: Number of bytes in the buffer.
+ *
+ * Returns: Nothing.
+ */
+void map_lexer_init(map_lexer *lx, const char *data, size_t size)
+{
+	lx->data=data;
+	lx->size=size;
+	lx->pos=0;
+	lx->block=0;
+	lx->next=0;
+	lx->events=0;
+	lx->newline=0;
+	lx->hash=0;
+	lx->carry=0;
+}
+
+/**
+ * map_lexer_next() - Scan the next line of a buffer.
+ * @lx: Lexer to advance.
+ * @l: Set to the kind and tokens of the line.
+ *
+ * Returns: True if there was a line, false at the end of the buffer.
+ */
+bool map_lexer_next(map_lexer *lx, map_line *l)
+{
+	if (lx->pos >= lx->size) {
+		return false;
+	}
+
+	size_t p;
+	size_t start=0;
+	bool in_token=false;
+	bool comment=false;
+
+	l->n_tokens=0;
+	for (;;) {
+		uint64_t bit=0;
+		if (lx->events != 0) {
+			// Take the next event.
+			bit=lx->events & -lx->events;
+			lx->events^=bit;
+			p=lx->block+__builtin_ctzll(bit);
+		} else if (lx->next < lx->size) {
+			map_lexer_load(lx);
+			continue;
+		} else {
+			p=lx->size;
+		}
+		// The end of the buffer ends the last token and line.
+		bool end=(p >= lx->size);
+		if (end) {
+			p=lx->size;
+		}
+
+		if (in_token) {
+			// The token ends here, at whitespace, a newline or the end.
+			if (l->n_tokens < MAP_LINE_MAX_TOKENS) {
+				l->tokens[l->n_tokens].s=lx->data+start;
+				l->tokens[l->n_tokens].len=p-start;
+				l->n_tokens++;
+			}
+			in_token=false;
+		} else if (!end && !(lx->newline & bit) && !comment) {
+			// A token or a comment starts here.
+			if (lx->hash & bit) {
+				comment=true;
+			} else {
+				start=p;
+				in_token=true;
+			}
+		}
+		if (end || (lx->newline & bit)) {
+			break;
+		}
+	}
+
+	// Continue after the newline that ended the line.
+	lx->pos=p+1;
+	map_line_classify(l, comment);
+	return true;
+}
+
+/**
+ * map_lexer_implementation() - Return the name of the block classifier in use.
+ *
+ * Returns: "avx2", "sse2" or "scalar".
+ */
+const char *map_lexer_implementation(void)
+{
+	return ops->name;
+}
+
+/**
+ * map_lexer_use_implementation() - Select the block classifier.
+ * @name: "avx2", "sse2" or "scalar".
+ *
+ * Meant for tests and benchmarks that compare the classifiers. Must not
+ * be called while another thread lexes a buffer.
+ *
+ * Returns: True if the classifier exists and the processor supports
+ *	    it, otherwise false and the classifier is not changed.
+ */
+bool map_lexer_use_implementation(const char *name)
+{
+	for (size_t i=0; i<sizeof(all_ops) / sizeof(all_ops[0]); i++) {
+		if (strcmp(name, all_ops[i]->name) == 0 && map_cpu_supports(all_ops[i])) {
+			ops=all_ops[i];
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,144 @@
+#ifndef __MAPLINE_H
+#define __MAPLINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "util.h"
+
+/*
+ * Declaration of a tokenizer for the lines of map files. A map file
+ * has comment lines starting with '#', blank lines, one line with the
+ * number of edges, and one line per edge with the labels of the source
+ * and destination nodes, optionally followed by more fields. A '#' at
+ * the start of a token starts a comment that runs to the end of the
+ * line.
+ *
+ * map_line_scan() classifies a line and splits it into tokens in a
+ * single pass. The tokens are (pointer, length) views into the line,
+ * which need not be NUL-terminated, so nothing is copied.
+ *
+ * A map_lexer walks a whole buffer, e.g. a memory mapped map file, line
+ * by line. It classifies the bytes 64 at a time into bitmasks of
+ * whitespace, newlines and '#' characters with SSE2 or AVX2 compares,
+ * chosen at run time with a scalar fallback. From the masks it finds
+ * every byte where a token starts or ends or a line ends, and visits
+ * them by counting trailing zeros. It never reads past the end of the
+ * buffer.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: Added the map_lexer.
+ *   v1.2 2026-10-18: Added map_lexer_use_implementation.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Largest number of tokens kept for a line, more are ignored.
+#define MAP_LINE_MAX_TOKENS 8
+
+// Kinds of lines.
+typedef enum map_line_kind {
+	MAP_LINE_BLANK,		// Only whitespace.
+	MAP_LINE_COMMENT,	// Only a comment, possibly after whitespace.
+	MAP_LINE_COUNT,		// A single integer, the number of edges.
+	MAP_LINE_EDGE,		// Two labels, possibly followed by more fields.
+	MAP_LINE_INVALID,	// A single token that is not an integer.
+} map_line_kind;
+
+// A view of a token in a line.
+typedef struct map_token {
+	const char *s;
+	size_t len;
+} map_token;
+
+// A scanned line. For an edge, tokens[0] and tokens[1] are the labels
+// and the other tokens are the optional fields.
+typedef struct map_line {
+	map_line_kind kind;
+	int n_tokens; // Number of tokens before any comment, at most MAP_LINE_MAX_TOKENS.
+	map_token tokens[MAP_LINE_MAX_TOKENS];
+	long count; // The number of a MAP_LINE_COUNT line.
+} map_line;
+
+// Number of bytes a map_lexer classifies at a time.
+#define MAP_LEXER_BLOCK 64
+
+// A lexer over the lines of a buffer. The fields are private.
+typedef struct map_lexer {
+	const char *data;
+	size_t size;
+	size_t pos; // Offset of the next line.
+	size_t block; // Offset of the block the masks describe.
+	size_t next; // Offset of the next block to classify.
+	uint64_t events; // Bit i is set if a token starts or ends, or a line ends, at block+i.
+	uint64_t newline; // Bit i is set if byte block+i is '\n'.
+	uint64_t hash; // Bit i is set if byte block+i is '#'.
+	uint64_t carry; // 1 if the last byte of the previous block is in a token.
+} map_lexer;
+
+// ==========TOKENIZER INTERFACE==========
+
+/**
+ * map_line_scan() - Classify a line and split it into tokens.
+ * @line: First character of the line.
+ * @len: Length of the line, without the newline.
+ * @l: Set to the kind and tokens of the line.
+ *
+ * Returns: The kind of the line.
+ */
+map_line_kind map_line_scan(const char *line, size_t len, map_line *l);
+
+/**
+ * map_token_to_long() - Parse a token as an integer.
+ * @t: Token to parse.
+ * @value: Set to the integer if the token is one.
+ *
+ * The token must consist of an optional sign and decimal digits.
+ * Values outside the range of long are clamped.
+ *
+ * Returns: True if the token is an integer, otherwise false.
+ */
+bool map_token_to_long(map_token t, long *value);
+
+/**
+ * map_lexer_init() - Start lexing a buffer.
+ * @lx: Lexer to initialize.
+ * @data: First byte of the buffer, need not be NUL-terminated.
+ * @size: Number of bytes in the buffer.
+ *
+ * The last line need not end with a newline.
+ *
+ * Returns: Nothing.
+ */
+void map_lexer_init(map_lexer *lx, const char *data, size_t size);
+
+/**
+ * map_lexer_next() - Scan the next line of a buffer.
+ * @lx: Lexer to advance.
+ * @l: Set to the kind and tokens of the line, as by map_line_scan().
+ *
+ * Returns: True if there was a line, false at the end of the buffer.
+ */
+bool map_lexer_next(map_lexer *lx, map_line *l);
+
+/**
+ * map_lexer_implementation() - Return the name of the block classifier in use.
+ *
+ * Returns: "avx2", "sse2" or "scalar".
+ */
+const char *map_lexer_implementation(void);
+
+/**
+ * map_lexer_use_implementation() - Select the block classifier.
+ * @name: "avx2", "sse2" or "scalar".
+ *
+ * Meant for tests and benchmarks that compare the classifiers. Must not
+ * be called while another thread lexes a buffer.
+ *
+ * Returns: True if the classifier exists and the processor supports
+ *	    it, otherwise false and the classifier is not changed.
+ */
+bool map_lexer_use_implementation(const char *name);
+
+#endif
@@ -0,0 +1,306 @@
+// For sysconf() and the pthread functions.
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <mapscan.h>
+#include <mapline.h>
+#include <container_typed.h>
+
+/*
+ * Implementation of a parallel scanner for whole map files.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+VEC_TYPED(vec_edge, map_edge)
+VEC_TYPED(vec_int, int)
+
+/*
+ * The part of a file scanned by one thread, and what the thread found.
+ * The first line of a chunk that is not blank or a comment is kept
+ * aside, since only the merge knows if it is the count line of the
+ * file. If it is an edge it is also added to the edges.
+ */
+struct map_chunk {
+	const char *data;
+	size_t size;
+	intern *labels; // Labels of the chunk, by local id.
+	vec_edge *edges; // Edges of the chunk with local ids.
+	vec_int *out_degree; // Edges from every label, by local id.
+	bool has_first; // The chunk has a line that is not blank or a comment.
+	map_line_kind first_kind; // Kind of that line.
+	long first_count; // Count of that line if it is MAP_LINE_COUNT.
+	bool bad_line; // A later line is not an edge.
+	int *global_ids; // Merged id of every local id, NULL for the first chunk.
+	map_edge *out; // Where the edges with merged ids go.
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * map_chunk_scan() - Internal function to scan a chunk, run by a thread.
+ * @arg: The chunk.
+ *
+ * Returns: NULL.
+ */
+static void *map_chunk_scan(void *arg)
+{
+	struct map_chunk *c=arg;
+	map_lexer lx;
+	map_line l;
+
+	map_lexer_init(&lx, c->data, c->size);
+	while (map_lexer_next(&lx, &l)) {
+		if (l.kind == MAP_LINE_BLANK || l.kind == MAP_LINE_COMMENT) {
+			continue;
+		}
+		if (!c->has_first) {
+			c->has_first=true;
+			c->first_kind=l.kind;
+			c->first_count=l.count;
+			if (l.kind != MAP_LINE_EDGE) {
+				continue;
+			}
+		} else if (l.kind != MAP_LINE_EDGE) {
+			// The scan fails at this line, the rest does not matter.
+			c->bad_line=true;
+			break;
+		}
+
+		// New labels get the next local id and start out without edges.
+		map_edge e;
+		e.src=intern_insert_n(c->labels, l.tokens[0].s, l.tokens[0].len);
+		e.dest=intern_insert_n(c->labels, l.tokens[1].s, l.tokens[1].len);
+		while (vec_int_size(c->out_degree) < intern_size(c->labels)) {
+			vec_int_push(c->out_degree, 0);
+		}
+		vec_int_set(c->out_degree, vec_int_get(c->out_degree, e.src)+1, e.src);
+		vec_edge_push(c->edges, e);
+	}
+	return NULL;
+}
+
+/**
+ * map_chunk_translate() - Internal function to store the edges of a
+ *			   chunk with merged ids, run by a thread.
+ * @arg: The chunk.
+ *
+ * Returns: NULL.
+ */
+static void *map_chunk_translate(void *arg)
+{
+	struct map_chunk *c=arg;
+
+	// The edges of the first chunk already have their merged ids.
+	if (c->global_ids == NULL) {
+		return NULL;
+	}
+	for (int i=0; i<vec_edge_size(c->edges); i++) {
+		map_edge e=vec_edge_get(c->edges, i);
+		c->out[i].src=c->global_ids[e.src];
+		c->out[i].dest=c->global_ids[e.dest];
+	}
+	return NULL;
+}
+
+/**
+ * map_scan_run() - Internal function to run a function on every chunk.
+ * @chunks: The chunks.
+ * @n: Number of chunks.
+ * @func: Function to run.
+ *
+ * Chunk 0 is handled by the calling thread, the others by one thread
+ * each. A chunk whose thread can not be started is also handled by the
+ * calling thread.
+ *
+ * Returns: Nothing.
+ */
+static void map_scan_run(struct map_chunk *chunks, int n, void *(*func)(void *))
+{
+	pthread_t threads[MAP_SCAN_MAX_THREADS];
+	bool started[MAP_SCAN_MAX_THREADS];
+
+	for (int i=1; i<n; i++) {
+		started[i]=(pthread_create(&threads[i], NULL, func, &chunks[i]) == 0);
+	}
+	func(&chunks[0]);
+	for (int i=1; i<n; i++) {
+		if (started[i]) {
+			pthread_join(threads[i], NULL);
+		} else {
+			func(&chunks[i]);
+		}
+	}
+}
+
+/**
+ * map_scan_threads() - Internal function to pick the number of threads.
+ * @size: Number of bytes to scan.
+ * @n_threads: Number of threads asked for, or 0.
+ *
+ * Returns: The number of threads to use, at least 1.
+ */
+static int map_scan_threads(size_t size, int n_threads)
+{
+	if (n_threads <= 0) {
+		long cpus=sysconf(_SC_NPROCESSORS_ONLN);
+		size_t by_size=size / MAP_SCAN_MIN_CHUNK;
+		n_threads=(cpus > 0) ? (int)cpus : 1;
+		if (by_size < (size_t)n_threads) {
+			n_threads=by_size > 0 ? (int)by_size : 1;
+		}
+	}
+	return n_threads < MAP_SCAN_MAX_THREADS ? n_threads : MAP_SCAN_MAX_THREADS;
+}
+
+/**
+ * map_scan_check() - Internal function to check the lines of a file.
+ * @chunks: The scanned chunks.
+ * @n: Number of chunks.
+ * @count: Set to the edge count of the file.
+ *
+ * Visits the chunks in file order, so the error is the one a scan by
+ * one thread would find first.
+ *
+ * Returns: MAP_SCAN_OK or the error.
+ */
+static map_scan_status map_scan_check(const struct map_chunk *chunks, int n, long *count)
+{
+	bool has_count=false;
+
+	for (int i=0; i<n; i++) {
+		const struct map_chunk *c=&chunks[i];
+		if (c->has_first && !has_count) {
+			// The first line of the file must be the edge count.
+			if (c->first_kind != MAP_LINE_COUNT || c->first_count < 0 ||
+			    c->first_count > INT_MAX) {
+				return MAP_SCAN_NO_COUNT;
+			}
+			has_count=true;
+			*count=c->first_count;
+		} else if (c->has_first && c->first_kind != MAP_LINE_EDGE) {
+			return MAP_SCAN_BAD_LINE;
+		}
+		if (c->bad_line) {
+			return MAP_SCAN_BAD_LINE;
+		}
+	}
+	return has_count ? MAP_SCAN_OK : MAP_SCAN_NO_COUNT;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * map_scan_buffer() - Scan a map file.
+ * @data: Contents of the file, need not be NUL-terminated.
+ * @size: Number of bytes in the file.
+ * @n_threads: Number of threads to use, or 0 for one per processor
+ *	       but at most one per MAP_SCAN_MIN_CHUNK bytes.
+ * @s: Set to the labels and edges of the file on success.
+ *
+ * Returns: MAP_SCAN_OK, or the first error in the file.
+ */
+map_scan_status map_scan_buffer(const char *data, size_t size, int n_threads, map_scan *s)
+{
+	struct map_chunk chunks[MAP_SCAN_MAX_THREADS];
+	int n=map_scan_threads(size, n_threads);
+
+	// Split the file into chunks that start at the beginning of a line.
+	size_t start=0;
+	for (int i=0; i<n; i++) {
+		size_t end=size;
+		size_t p=(size / n) * (i+1);
+		if (i < n-1 && p <= start) {
+			// The chunk before ran past this one, which is empty.
+			end=start;
+		} else if (i < n-1) {
+			// End after the first newline at or after byte p-1.
+			const char *nl=memchr(data+p-1, '\n', size-(p-1));
+			end=(nl != NULL) ? (size_t)(nl-data)+1 : size;
+		}
+		memset(&chunks[i], 0, sizeof(chunks[i]));
+		chunks[i].data=data+start;
+		chunks[i].size=end-start;
+		chunks[i].labels=intern_empty(NULL);
+		chunks[i].edges=vec_edge_empty();
+		chunks[i].out_degree=vec_int_empty();
+		start=end;
+	}
+
+	map_scan_run(chunks, n, map_chunk_scan);
+	map_scan_status status=map_scan_check(chunks, n, &s->count);
+
+	if (status == MAP_SCAN_OK) {
+		// The labels of the first chunk keep their ids, the others
+		// are merged in file order.
+		intern *labels=chunks[0].labels;
+		vec_int *out_degree=chunks[0].out_degree;
+		vec_edge *edges=chunks[0].edges;
+		long n_edges=vec_edge_size(edges);
+
+		for (int i=1; i<n; i++) {
+			struct map_chunk *c=&chunks[i];
+			int n_labels=intern_size(c->labels);
+			c->global_ids=malloc((n_labels > 0 ? n_labels : 1) * sizeof(int));
+			for (int id=0; id<n_labels; id++) {
+				int g=intern_insert_n(labels, intern_string(c->labels, id),
+						      intern_length(c->labels, id));
+				c->global_ids[id]=g;
+				while (vec_int_size(out_degree) <= g) {
+					vec_int_push(out_degree, 0);
+				}
+				vec_int_set(out_degree, vec_int_get(out_degree, g) +
+					    vec_int_get(c->out_degree, id), g);
+			}
+			n_edges+=vec_edge_size(c->edges);
+		}
+
+		// The edges of the first chunk are already in place, the
+		// threads copy the others after them with the merged ids.
+		vec_edge_reserve(edges, n_edges > 0 ? n_edges : 1);
+		map_edge *out=edges->values+vec_edge_size(edges);
+		for (int i=1; i<n; i++) {
+			chunks[i].out=out;
+			out+=vec_edge_size(chunks[i].edges);
+		}
+		map_scan_run(chunks, n, map_chunk_translate);
+
+		// Hand the storage of the first chunk over to the result.
+		s->labels=labels;
+		s->edges=edges->values;
+		s->n_edges=n_edges;
+		s->out_degree=out_degree->values;
+		free(edges);
+		free(out_degree);
+	}
+
+	for (int i=(status == MAP_SCAN_OK) ? 1 : 0; i<n; i++) {
+		intern_kill(chunks[i].labels);
+		vec_edge_kill(chunks[i].edges);
+		vec_int_kill(chunks[i].out_degree);
+		free(chunks[i].global_ids);
+	}
+	return status;
+}
+
+/**
+ * map_scan_free() - Free the result of a scan.
+ * @s: Scan to free.
+ *
+ * Returns: Nothing.
+ */
+void map_scan_free(map_scan *s)
+{
+	intern_kill(s->labels);
+	free(s->edges);
+	free(s->out_degree);
+}
@@ -0,0 +1,83 @@
+#ifndef __MAPSCAN_H
+#define __MAPSCAN_H
+
+#include <stddef.h>
+#include "util.h"
+#include "intern.h"
+
+/*
+ * Declaration of a parallel scanner for whole map files. The scanner
+ * checks the format of a map file, interns its labels and reads its
+ * edges as pairs of label ids, so that a graph can be built from them
+ * without touching the file again.
+ *
+ * A large file is split at newlines into one chunk per thread. Every
+ * thread lexes its chunk and interns the labels in a table of its own,
+ * without locks. The tables are then merged in file order, so a label
+ * gets the same id as in a scan by one thread: 0 for the first label in
+ * the file, 1 for the next new one, and so on. Finally the threads
+ * rewrite their edges with the merged ids.
+ *
+ * The file must be compiled with -pthread.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Buffers smaller than this many bytes per thread are not split
+// further when the number of threads is picked automatically.
+#define MAP_SCAN_MIN_CHUNK (1 << 20)
+
+// Largest number of threads used.
+#define MAP_SCAN_MAX_THREADS 64
+
+// An edge as the ids of its labels.
+typedef struct map_edge {
+	int src;
+	int dest;
+} map_edge;
+
+// Result of a scan.
+typedef enum map_scan_status {
+	MAP_SCAN_OK,
+	MAP_SCAN_NO_COUNT,	// The first line is not a valid edge count.
+	MAP_SCAN_BAD_LINE,	// A line after the count is not an edge.
+} map_scan_status;
+
+// A scanned map file.
+typedef struct map_scan {
+	intern *labels;	// Every distinct label, by id in order of appearance.
+	map_edge *edges;	// The edges in the order of the file.
+	int n_edges;
+	int *out_degree;	// Number of edges from every label, by id.
+	long count;	// The edge count stated by the file.
+} map_scan;
+
+// ==========SCANNER INTERFACE==========
+
+/**
+ * map_scan_buffer() - Scan a map file.
+ * @data: Contents of the file, need not be NUL-terminated.
+ * @size: Number of bytes in the file.
+ * @n_threads: Number of threads to use, or 0 for one per processor
+ *	       but at most one per MAP_SCAN_MIN_CHUNK bytes.
+ * @s: Set to the labels and edges of the file on success.
+ *
+ * The result is the same for any number of threads. On failure nothing
+ * is left allocated.
+ *
+ * Returns: MAP_SCAN_OK, or the first error in the file.
+ */
+map_scan_status map_scan_buffer(const char *data, size_t size, int n_threads, map_scan *s);
+
+/**
+ * map_scan_free() - Free the result of a scan.
+ * @s: Scan to free.
+ *
+ * Returns: Nothing.
+ */
+void map_scan_free(map_scan *s);
+
+#endif
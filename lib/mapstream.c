@@ -0,0 +1,317 @@
+// For nanosleep(), poll() and the pthread functions.
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <mapstream.h>
+#include <mapline.h>
+
+/*
+ * Implementation of a streaming loader for map files.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: A file without a count line is a format error.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Initial size of the read buffer, it grows to hold the longest line.
+#define MAP_STREAM_BUFSIZE (1 << 20)
+
+// Milliseconds to wait at the end of a file before reading again.
+#define MAP_STREAM_POLL_MS 10
+
+// Milliseconds a regular file must stay unchanged at its end to be complete.
+#define MAP_STREAM_SETTLE_MS 1000
+
+/*
+ * The fields below the lock are shared between the loader and the
+ * queries, and only used while holding it.
+ */
+struct map_stream {
+	int fd;
+	bool regular; // The file is a regular file that may still grow.
+	pthread_t thread;
+	pthread_rwlock_t lock;
+	graph *g;
+	long count; // Edge count of the file, valid once g is created.
+	int n_edges;
+	bool loading;
+	bool stop; // Set by map_stream_stop().
+	map_scan_status status;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * map_stream_stopping() - Internal function to check if the loader should stop.
+ * @s: Loader to check.
+ *
+ * Returns: True if map_stream_stop() has been called.
+ */
+static bool map_stream_stopping(map_stream *s)
+{
+	pthread_rwlock_rdlock(&s->lock);
+	bool stop=s->stop;
+	pthread_rwlock_unlock(&s->lock);
+	return stop;
+}
+
+/**
+ * map_stream_add_line() - Internal function to add a line to the graph.
+ * @s: Loader, its lock held for writing.
+ * @l: The line.
+ *
+ * Returns: False if the line is a format error, otherwise true.
+ */
+static bool map_stream_add_line(map_stream *s, const map_line *l)
+{
+	if (l->kind == MAP_LINE_BLANK || l->kind == MAP_LINE_COMMENT) {
+		return true;
+	}
+	if (s->g == NULL) {
+		// The first line must be the edge count, which sizes the graph.
+		if (l->kind != MAP_LINE_COUNT || l->count < 0 || l->count > INT_MAX) {
+			s->status=MAP_SCAN_NO_COUNT;
+			return false;
+		}
+		s->count=l->count;
+		s->g=graph_empty(l->count > INT_MAX / 2 ? INT_MAX : 2 * (int)l->count);
+		return true;
+	}
+	if (l->kind != MAP_LINE_EDGE) {
+		s->status=MAP_SCAN_BAD_LINE;
+		return false;
+	}
+	node *src=graph_find_or_insert_node(s->g, l->tokens[0].s, l->tokens[0].len);
+	node *dest=graph_find_or_insert_node(s->g, l->tokens[1].s, l->tokens[1].len);
+	s->g=graph_insert_edge(s->g, src, dest);
+	s->n_edges++;
+	return true;
+}
+
+/**
+ * map_stream_add_lines() - Internal function to add whole lines to the graph.
+ * @s: Loader.
+ * @data: First byte of the lines.
+ * @size: Number of bytes, ending after a newline unless it is the end of the file.
+ *
+ * Publishes the lines in batches of at most MAP_STREAM_BATCH edges.
+ *
+ * Returns: False if a line is a format error or the loader is stopped,
+ *	    otherwise true.
+ */
+static bool map_stream_add_lines(map_stream *s, const char *data, size_t size)
+{
+	map_lexer lx;
+	map_line l;
+	bool more=true;
+	bool ok=true;
+
+	map_lexer_init(&lx, data, size);
+	while (ok && more) {
+		pthread_rwlock_wrlock(&s->lock);
+		ok=!s->stop;
+		for (int n=0; ok && n<MAP_STREAM_BATCH && (more=map_lexer_next(&lx, &l)); n++) {
+			ok=map_stream_add_line(s, &l);
+		}
+		pthread_rwlock_unlock(&s->lock);
+	}
+	return ok;
+}
+
+/**
+ * map_stream_missing() - Internal function to count the edges still to be read.
+ * @s: Loader.
+ *
+ * Returns: The number of edges the count line states that have not been
+ *	    read, 0 if there are more, or LONG_MAX before the count line.
+ */
+static long map_stream_missing(map_stream *s)
+{
+	pthread_rwlock_rdlock(&s->lock);
+	long missing=(s->g == NULL) ? LONG_MAX : s->count - s->n_edges;
+	pthread_rwlock_unlock(&s->lock);
+	return missing > 0 ? missing : 0;
+}
+
+/**
+ * map_stream_load() - Internal function that reads the file, run by the loader thread.
+ * @arg: The loader.
+ *
+ * Returns: NULL.
+ */
+static void *map_stream_load(void *arg)
+{
+	map_stream *s=arg;
+	size_t cap=MAP_STREAM_BUFSIZE;
+	size_t len=0; // Bytes in buf, all of them after the last whole line added.
+	int idle=0; // Milliseconds since the file last grew.
+	char *buf=malloc(cap);
+	bool ok=(buf != NULL);
+
+	while (ok && !map_stream_stopping(s)) {
+		if (len == cap) {
+			// A line longer than the buffer.
+			char *bigger=realloc(buf, 2 * cap);
+			if (bigger == NULL) {
+				break;
+			}
+			buf=bigger;
+			cap*=2;
+		}
+
+		// Wait a while for a pipe to have data, so a stop is noticed.
+		struct pollfd pfd={ .fd=s->fd, .events=POLLIN };
+		if (poll(&pfd, 1, MAP_STREAM_POLL_MS) == 0) {
+			continue;
+		}
+		ssize_t n=read(s->fd, buf+len, cap-len);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n < 0) {
+			break;
+		}
+
+		if (n == 0) {
+			// A regular file may still be written until it has the
+			// edges of its count line, or has not grown for a while.
+			// Anything else ends here. A last line without a newline
+			// may be cut short, so it is only taken at the end.
+			bool settled=(idle >= MAP_STREAM_SETTLE_MS);
+			if (s->regular && map_stream_missing(s) > 0 && !settled) {
+				struct timespec ts={ 0, MAP_STREAM_POLL_MS * 1000000L };
+				nanosleep(&ts, NULL);
+				idle+=MAP_STREAM_POLL_MS;
+				continue;
+			}
+			ok=map_stream_add_lines(s, buf, len);
+			break;
+		}
+
+		// Add the whole lines and keep the start of the last one.
+		idle=0;
+		len+=n;
+		size_t whole=len;
+		while (whole > 0 && buf[whole-1] != '\n') {
+			whole--;
+		}
+		ok=map_stream_add_lines(s, buf, whole);
+		memmove(buf, buf+whole, len-whole);
+		len-=whole;
+	}
+
+	free(buf);
+	pthread_rwlock_wrlock(&s->lock);
+	s->loading=false;
+	// A file that ended before its count line, e.g. an empty file.
+	if (s->g == NULL && s->status == MAP_SCAN_OK) {
+		s->status=MAP_SCAN_NO_COUNT;
+	}
+	pthread_rwlock_unlock(&s->lock);
+	return NULL;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * map_stream_start() - Open a map file and start loading it.
+ * @path: Name of the file, e.g. a file that is still being written.
+ *
+ * Returns: A pointer to the loader, or NULL if the file could not be
+ *	    opened or the thread not started, in which case errno is set.
+ */
+map_stream *map_stream_start(const char *path)
+{
+	map_stream *s=calloc(1, sizeof(*s));
+	if (s == NULL) {
+		return NULL;
+	}
+	s->fd=open(path, O_RDONLY);
+	if (s->fd < 0) {
+		free(s);
+		return NULL;
+	}
+
+	struct stat st;
+	s->regular=(fstat(s->fd, &st) == 0 && S_ISREG(st.st_mode));
+	s->loading=true;
+	s->status=MAP_SCAN_OK;
+	pthread_rwlock_init(&s->lock, NULL);
+
+	int err=pthread_create(&s->thread, NULL, map_stream_load, s);
+	if (err != 0) {
+		pthread_rwlock_destroy(&s->lock);
+		close(s->fd);
+		free(s);
+		errno=err;
+		return NULL;
+	}
+	return s;
+}
+
+/**
+ * map_stream_acquire() - Get the published prefix of the graph.
+ * @s: Loader to query.
+ * @view: Set to the graph and how much of the file it holds.
+ *
+ * Holds the loader back until map_stream_release(), so the graph in
+ * view does not change meanwhile. The graph may be searched, and the
+ * seen status of its nodes changed, by one thread at a time, but
+ * nothing else. Several threads may hold the graph at once, so they
+ * must not all change the seen status.
+ *
+ * Returns: Nothing.
+ */
+void map_stream_acquire(map_stream *s, map_stream_view *view)
+{
+	pthread_rwlock_rdlock(&s->lock);
+	view->g=s->g;
+	view->n_edges=s->n_edges;
+	view->loading=s->loading;
+	view->status=s->status;
+}
+
+/**
+ * map_stream_release() - Let the loader continue after a query.
+ * @s: Loader to release.
+ *
+ * Returns: Nothing.
+ */
+void map_stream_release(map_stream *s)
+{
+	pthread_rwlock_unlock(&s->lock);
+}
+
+/**
+ * map_stream_stop() - Stop loading and free the loader and its graph.
+ * @s: Loader to stop.
+ *
+ * Returns: Nothing.
+ */
+void map_stream_stop(map_stream *s)
+{
+	pthread_rwlock_wrlock(&s->lock);
+	s->stop=true;
+	pthread_rwlock_unlock(&s->lock);
+	pthread_join(s->thread, NULL);
+
+	if (s->g != NULL) {
+		graph_kill(s->g);
+	}
+	pthread_rwlock_destroy(&s->lock);
+	close(s->fd);
+	free(s);
+}
@@ -0,0 +1,95 @@
+#ifndef __MAPSTREAM_H
+#define __MAPSTREAM_H
+
+#include <stdbool.h>
+#include "util.h"
+#include "graph.h"
+#include "mapscan.h"
+
+/*
+ * Declaration of a streaming loader for map files. A loader thread
+ * reads the file while it is still being written and adds its edges to
+ * a graph, so queries can start before the whole map is loaded.
+ *
+ * Visibility rule: the loader adds the edge lines in batches, in file
+ * order, while holding the write side of a lock, and queries hold the
+ * read side while they run. A query therefore sees exactly the nodes
+ * and edges of the first n edge lines of the file, where n is the
+ * number of edges published when it acquired the graph, and nothing
+ * the loader adds while it runs.
+ *
+ * A regular file is complete once it has as many edge lines as its
+ * count line states, or once it has not grown for a second, since the
+ * count only sizes the graph. Until then the loader waits at the end of
+ * the file for more lines to be written. Other files, such as pipes,
+ * end at their end of file. Since a writer may be in the middle of a
+ * line, a last line without a newline is only read once the file is
+ * complete. A file that ends without a count line, e.g. an empty file,
+ * gets the status MAP_SCAN_NO_COUNT.
+ *
+ * The file must be compiled with -pthread.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: A file without a count line is a format error.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Number of edge lines added per hold of the write lock.
+#define MAP_STREAM_BATCH 4096
+
+// Streaming loader type.
+typedef struct map_stream map_stream;
+
+// What a query sees, filled in by map_stream_acquire().
+typedef struct map_stream_view {
+	graph *g; // The graph, NULL until the count line has been read.
+	int n_edges; // Number of edge lines in the graph.
+	bool loading; // True if the loader may still add edges.
+	map_scan_status status; // MAP_SCAN_OK, or the format error that stopped the loader.
+} map_stream_view;
+
+// ==========LOADER INTERFACE==========
+
+/**
+ * map_stream_start() - Open a map file and start loading it.
+ * @path: Name of the file, e.g. a file that is still being written.
+ *
+ * Returns: A pointer to the loader, or NULL if the file could not be
+ *	    opened or the thread not started, in which case errno is set.
+ */
+map_stream *map_stream_start(const char *path);
+
+/**
+ * map_stream_acquire() - Get the published prefix of the graph.
+ * @s: Loader to query.
+ * @view: Set to the graph and how much of the file it holds.
+ *
+ * Holds the loader back until map_stream_release(), so the graph in
+ * view does not change meanwhile. The graph may be searched, and the
+ * seen status of its nodes changed, by one thread at a time, but
+ * nothing else. Several threads may hold the graph at once, so they
+ * must not all change the seen status.
+ *
+ * Returns: Nothing.
+ */
+void map_stream_acquire(map_stream *s, map_stream_view *view);
+
+/**
+ * map_stream_release() - Let the loader continue after a query.
+ * @s: Loader to release.
+ *
+ * Returns: Nothing.
+ */
+void map_stream_release(map_stream *s);
+
+/**
+ * map_stream_stop() - Stop loading and free the loader and its graph.
+ * @s: Loader to stop.
+ *
+ * Returns: Nothing.
+ */
+void map_stream_stop(map_stream *s);
+
+#endif
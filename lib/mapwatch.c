@@ -0,0 +1,273 @@
+// For poll(), strdup() and the pthread functions.
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+#include <mapwatch.h>
+
+/*
+ * Implementation of a map that is loaded again whenever its file changes.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Milliseconds the watcher waits for events before it checks for a stop.
+#define MAP_WATCH_POLL_MS 100
+
+// A graph and the number of references to it.
+struct map_version {
+	graph *g;
+	int refs;
+};
+
+/*
+ * The fields below the mutex are shared between the watcher and the
+ * queries, and only used while holding it.
+ */
+struct map_watch {
+	char *path;
+	const char *name; // The file name part of path.
+	map_load_function *load;
+	int fd; // inotify descriptor watching the directory of the file.
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t drained; // Signalled when the old graph loses its last reference.
+	struct map_version current;
+	struct map_version old; // Graph that was swapped out, NULL if none.
+	int reloads;
+	bool stop;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * map_watch_stopping() - Internal function to check if the watcher should stop.
+ * @w: Watched map.
+ *
+ * Returns: True if map_watch_stop() has been called.
+ */
+static bool map_watch_stopping(map_watch *w)
+{
+	pthread_mutex_lock(&w->mutex);
+	bool stop=w->stop;
+	pthread_mutex_unlock(&w->mutex);
+	return stop;
+}
+
+/**
+ * map_watch_changed() - Internal function to read the pending inotify events.
+ * @w: Watched map.
+ *
+ * Returns: True if one of the events is about the file.
+ */
+static bool map_watch_changed(map_watch *w)
+{
+	char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	bool changed=false;
+	ssize_t n;
+
+	// The descriptor is non-blocking, read until no events are left.
+	while ((n=read(w->fd, buf, sizeof(buf))) > 0) {
+		for (char *p=buf; p<buf+n; ) {
+			const struct inotify_event *ev=(const struct inotify_event *)p;
+			if (ev->len > 0 && strcmp(ev->name, w->name) == 0) {
+				changed=true;
+			}
+			p+=sizeof(struct inotify_event) + ev->len;
+		}
+	}
+	return changed;
+}
+
+/**
+ * map_watch_swap() - Internal function to swap in a new graph and free the old one.
+ * @w: Watched map.
+ * @g: The new graph.
+ *
+ * Waits for the references to the old graph to be released before it
+ * is killed.
+ *
+ * Returns: Nothing.
+ */
+static void map_watch_swap(map_watch *w, graph *g)
+{
+	pthread_mutex_lock(&w->mutex);
+	w->old=w->current;
+	w->current.g=g;
+	w->current.refs=0;
+	w->reloads++;
+	while (w->old.refs > 0) {
+		pthread_cond_wait(&w->drained, &w->mutex);
+	}
+	graph *old=w->old.g;
+	w->old.g=NULL;
+	pthread_mutex_unlock(&w->mutex);
+
+	// Nobody can reach the old graph any more.
+	graph_kill(old);
+}
+
+/**
+ * map_watch_run() - Internal function that reloads the map, run by the watcher thread.
+ * @arg: The watched map.
+ *
+ * Returns: NULL.
+ */
+static void *map_watch_run(void *arg)
+{
+	map_watch *w=arg;
+	struct pollfd pfd={ .fd=w->fd, .events=POLLIN };
+
+	while (!map_watch_stopping(w)) {
+		if (poll(&pfd, 1, MAP_WATCH_POLL_MS) <= 0 || !map_watch_changed(w)) {
+			continue;
+		}
+		graph *g=w->load(w->path);
+		if (g == NULL) {
+			fprintf(stderr, "Could not reload %s, keeping the old map.\n", w->path);
+			continue;
+		}
+		map_watch_swap(w, g);
+	}
+	return NULL;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * map_watch_start() - Load a map file and start watching it.
+ * @path: Name of the file.
+ * @load: Function that loads the file, called on the watcher thread
+ *	  for every reload.
+ *
+ * Returns: A pointer to the watched map, or NULL if the file could not
+ *	    be loaded or watched.
+ */
+map_watch *map_watch_start(const char *path, map_load_function *load)
+{
+	map_watch *w=calloc(1, sizeof(*w));
+	if (w == NULL) {
+		return NULL;
+	}
+	w->path=strdup(path);
+	w->load=load;
+
+	// Watch the directory, so a file renamed over the map is noticed.
+	const char *slash=strrchr(w->path, '/');
+	char *dir=strdup(slash == NULL ? "." : w->path);
+	if (slash != NULL) {
+		dir[slash == w->path ? 1 : slash-w->path]='\0';
+	}
+	w->name=(slash == NULL) ? w->path : slash+1;
+	w->fd=inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	bool watched=(w->fd >= 0 &&
+		      inotify_add_watch(w->fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) >= 0);
+	free(dir);
+
+	// The first graph is loaded before the watcher starts.
+	w->current.g=watched ? load(w->path) : NULL;
+	if (w->current.g == NULL) {
+		if (w->fd >= 0) {
+			close(w->fd);
+		}
+		free(w->path);
+		free(w);
+		return NULL;
+	}
+
+	pthread_mutex_init(&w->mutex, NULL);
+	pthread_cond_init(&w->drained, NULL);
+	if (pthread_create(&w->thread, NULL, map_watch_run, w) != 0) {
+		graph_kill(w->current.g);
+		pthread_cond_destroy(&w->drained);
+		pthread_mutex_destroy(&w->mutex);
+		close(w->fd);
+		free(w->path);
+		free(w);
+		return NULL;
+	}
+	return w;
+}
+
+/**
+ * map_watch_acquire() - Take a reference to the current graph.
+ * @w: Watched map.
+ *
+ * The graph is not killed before the reference is released. The graph
+ * may be searched, and the seen status of its nodes changed, by one
+ * thread at a time, but nothing else.
+ *
+ * Returns: The current graph.
+ */
+graph *map_watch_acquire(map_watch *w)
+{
+	pthread_mutex_lock(&w->mutex);
+	w->current.refs++;
+	graph *g=w->current.g;
+	pthread_mutex_unlock(&w->mutex);
+	return g;
+}
+
+/**
+ * map_watch_release() - Release a reference to a graph.
+ * @w: Watched map.
+ * @g: Graph returned by map_watch_acquire().
+ *
+ * Returns: Nothing.
+ */
+void map_watch_release(map_watch *w, graph *g)
+{
+	pthread_mutex_lock(&w->mutex);
+	if (g == w->current.g) {
+		w->current.refs--;
+	} else if (--w->old.refs == 0) {
+		// The swap waits for the last reference to the old graph.
+		pthread_cond_signal(&w->drained);
+	}
+	pthread_mutex_unlock(&w->mutex);
+}
+
+/**
+ * map_watch_reloads() - Return the number of times the map was loaded again.
+ * @w: Watched map.
+ *
+ * Returns: The number of graphs swapped in since the map was started.
+ */
+int map_watch_reloads(map_watch *w)
+{
+	pthread_mutex_lock(&w->mutex);
+	int reloads=w->reloads;
+	pthread_mutex_unlock(&w->mutex);
+	return reloads;
+}
+
+/**
+ * map_watch_stop() - Stop watching and free the watched map and its graphs.
+ * @w: Watched map, whose references must all be released.
+ *
+ * Returns: Nothing.
+ */
+void map_watch_stop(map_watch *w)
+{
+	pthread_mutex_lock(&w->mutex);
+	w->stop=true;
+	pthread_mutex_unlock(&w->mutex);
+	pthread_join(w->thread, NULL);
+
+	graph_kill(w->current.g);
+	pthread_cond_destroy(&w->drained);
+	pthread_mutex_destroy(&w->mutex);
+	close(w->fd);
+	free(w->path);
+	free(w);
+}
@@ -0,0 +1,93 @@
+#ifndef __MAPWATCH_H
+#define __MAPWATCH_H
+
+#include <stdbool.h>
+#include "util.h"
+#include "graph.h"
+
+/*
+ * Declaration of a map that is loaded again whenever its file changes.
+ * A watcher thread waits for the file to be rewritten or replaced, as
+ * reported by inotify, loads it into a new graph and then swaps the new
+ * graph in for the old one.
+ *
+ * The graphs are reference counted. A query holds a reference from
+ * map_watch_acquire() to map_watch_release(), so a query that is running
+ * during a swap finishes on the old graph and the next one gets the new
+ * graph. The old graph is killed by the watcher thread once the last
+ * reference to it is released, so neither loading nor freeing a graph
+ * happens on the thread that answers queries. At most two graphs exist
+ * at a time, the watcher waits for the old one to be released before it
+ * loads the file again.
+ *
+ * The file is loaded again when it is closed after writing or when
+ * another file is renamed to its name. Replacing the file by a rename
+ * is safer, since a file that is rewritten while it is loaded may be
+ * read half written.
+ *
+ * The file must be compiled with -pthread.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Function that loads a map file into a new graph, or returns NULL if
+// the file can not be loaded.
+typedef graph *map_load_function(const char *path);
+
+// Watched map type.
+typedef struct map_watch map_watch;
+
+// ==========WATCH INTERFACE==========
+
+/**
+ * map_watch_start() - Load a map file and start watching it.
+ * @path: Name of the file.
+ * @load: Function that loads the file, called on the watcher thread
+ *	  for every reload.
+ *
+ * Returns: A pointer to the watched map, or NULL if the file could not
+ *	    be loaded or watched.
+ */
+map_watch *map_watch_start(const char *path, map_load_function *load);
+
+/**
+ * map_watch_acquire() - Take a reference to the current graph.
+ * @w: Watched map.
+ *
+ * The graph is not killed before the reference is released. The graph
+ * may be searched, and the seen status of its nodes changed, by one
+ * thread at a time, but nothing else.
+ *
+ * Returns: The current graph.
+ */
+graph *map_watch_acquire(map_watch *w);
+
+/**
+ * map_watch_release() - Release a reference to a graph.
+ * @w: Watched map.
+ * @g: Graph returned by map_watch_acquire().
+ *
+ * Returns: Nothing.
+ */
+void map_watch_release(map_watch *w, graph *g);
+
+/**
+ * map_watch_reloads() - Return the number of times the map was loaded again.
+ * @w: Watched map.
+ *
+ * Returns: The number of graphs swapped in since the map was started.
+ */
+int map_watch_reloads(map_watch *w);
+
+/**
+ * map_watch_stop() - Stop watching and free the watched map and its graphs.
+ * @w: Watched map, whose references must all be released.
+ *
+ * Returns: Nothing.
+ */
+void map_watch_stop(map_watch *w);
+
+#endif
@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#include <mpmc_queue.h>
+
+/*
+ * Implementation of a bounded lock-free queue for several producer and
+ * several consumer threads.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+/*
+ * The queue is a ring of cells where every cell carries a sequence
+ * number (D. Vyukov's bounded MPMC queue). A cell with sequence number
+ * pos is free for the producer that claims position pos, and a cell
+ * with sequence number pos+1 holds the value for the consumer that
+ * claims position pos. Producers and consumers claim positions with a
+ * compare-and-swap on their own counter, so they only contend with
+ * threads of the same kind, and hand over cells through the sequence
+ * numbers.
+ *
+ * The two counters are kept on separate cache lines so that producers
+ * and consumers do not invalidate each other's counter.
+ */
+
+#define CACHE_LINE 64
+
+struct mpmc_cell {
+	atomic_size_t sequence;
+	void *value;
+};
+
+struct mpmc_queue {
+	struct mpmc_cell *cells;
+	size_t mask; // Capacity minus one.
+	char pad0[CACHE_LINE];
+	atomic_size_t enqueue_pos; // Next position for producers.
+	char pad1[CACHE_LINE - sizeof(atomic_size_t)];
+	atomic_size_t dequeue_pos; // Next position for consumers.
+	char pad2[CACHE_LINE - sizeof(atomic_size_t)];
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * mpmc_queue_empty() - Create an empty queue.
+ * @capacity: Maximum number of elements, rounded up to a power of two.
+ *
+ * Returns: A pointer to the new queue.
+ */
+mpmc_queue *mpmc_queue_empty(int capacity)
+{
+	// Round the capacity up to a power of two, at least two.
+	size_t size=2;
+	while (size < (size_t)capacity) {
+		size*=2;
+	}
+
+	mpmc_queue *q=calloc(1, sizeof(*q));
+	q->cells=malloc(size * sizeof(struct mpmc_cell));
+	q->mask=size - 1;
+
+	// Every cell is free for the producer of the same position.
+	for (size_t i=0; i<size; i++) {
+		atomic_init(&q->cells[i].sequence, i);
+	}
+	atomic_init(&q->enqueue_pos, 0);
+	atomic_init(&q->dequeue_pos, 0);
+
+	return q;
+}
+
+/**
+ * mpmc_queue_enqueue() - Put a value at the end of the queue.
+ * @q: Queue to manipulate.
+ * @v: Value (pointer) to be put in the queue.
+ *
+ * Returns: True if the value was put in the queue, false if the queue
+ *	    was full.
+ */
+bool mpmc_queue_enqueue(mpmc_queue *q, void *v)
+{
+	struct mpmc_cell *cell;
+	size_t pos=atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+
+	for (;;) {
+		cell=&q->cells[pos & q->mask];
+		size_t seq=atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		ptrdiff_t diff=(ptrdiff_t)seq - (ptrdiff_t)pos;
+
+		if (diff == 0) {
+			// The cell is free, try to claim the position.
+			if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1,
+								  memory_order_relaxed,
+								  memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			// The cell still holds the value from one lap ago.
+			return false;
+		} else {
+			// Another producer claimed the position, start over.
+			pos=atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+		}
+	}
+
+	// Store the value and hand the cell over to the consumers.
+	cell->value=v;
+	atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+
+	return true;
+}
+
+/**
+ * mpmc_queue_dequeue() - Take the value at the front of the queue.
+ * @q: Queue to manipulate.
+ * @v: Where to store the value.
+ *
+ * Returns: True if a value was taken from the queue, false if the queue
+ *	    was empty.
+ */
+bool mpmc_queue_dequeue(mpmc_queue *q, void **v)
+{
+	struct mpmc_cell *cell;
+	size_t pos=atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+
+	for (;;) {
+		cell=&q->cells[pos & q->mask];
+		size_t seq=atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		ptrdiff_t diff=(ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
+
+		if (diff == 0) {
+			// The cell holds a value, try to claim the position.
+			if (atomic_compare_exchange_weak_explicit(&q->dequeue_pos, &pos, pos + 1,
+								  memory_order_relaxed,
+								  memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			// No producer has filled the cell yet.
+			return false;
+		} else {
+			// Another consumer claimed the position, start over.
+			pos=atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+		}
+	}
+
+	// Take the value and free the cell for the producer one lap ahead.
+	*v=cell->value;
+	atomic_store_explicit(&cell->sequence, pos + q->mask + 1, memory_order_release);
+
+	return true;
+}
+
+/**
+ * mpmc_queue_kill() - Destroy a given queue.
+ * @q: Queue to destroy.
+ *
+ * No other thread may use the queue during or after the call. The
+ * values left in the queue are not freed.
+ *
+ * Returns: Nothing.
+ */
+void mpmc_queue_kill(mpmc_queue *q)
+{
+	free(q->cells);
+	free(q);
+}
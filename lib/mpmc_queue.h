@@ -0,0 +1,67 @@
+#ifndef __MPMC_QUEUE_H
+#define __MPMC_QUEUE_H
+
+#include <stdbool.h>
+#include "util.h"
+
+/*
+ * Declaration of a bounded lock-free queue for several producer and
+ * several consumer threads. The queue stores void pointers and has a
+ * fixed capacity given at creation. Enqueue and dequeue never block;
+ * they report a full or an empty queue to the caller instead.
+ *
+ * All functions except mpmc_queue_empty() and mpmc_queue_kill() may be
+ * called from any number of threads at the same time. The queue must
+ * be compiled with C11 atomics (<stdatomic.h>).
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Queue type.
+typedef struct mpmc_queue mpmc_queue;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * mpmc_queue_empty() - Create an empty queue.
+ * @capacity: Maximum number of elements, rounded up to a power of two.
+ *
+ * Returns: A pointer to the new queue.
+ */
+mpmc_queue *mpmc_queue_empty(int capacity);
+
+/**
+ * mpmc_queue_enqueue() - Put a value at the end of the queue.
+ * @q: Queue to manipulate.
+ * @v: Value (pointer) to be put in the queue.
+ *
+ * Returns: True if the value was put in the queue, false if the queue
+ *	    was full.
+ */
+bool mpmc_queue_enqueue(mpmc_queue *q, void *v);
+
+/**
+ * mpmc_queue_dequeue() - Take the value at the front of the queue.
+ * @q: Queue to manipulate.
+ * @v: Where to store the value.
+ *
+ * Returns: True if a value was taken from the queue, false if the queue
+ *	    was empty.
+ */
+bool mpmc_queue_dequeue(mpmc_queue *q, void **v);
+
+/**
+ * mpmc_queue_kill() - Destroy a given queue.
+ * @q: Queue to destroy.
+ *
+ * No other thread may use the queue during or after the call. The
+ * values left in the queue are not freed.
+ *
+ * Returns: Nothing.
+ */
+void mpmc_queue_kill(mpmc_queue *q);
+
+#endif
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <pool.h>
+
+/*
+ * Implementation of a pool of fixed size memory cells.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: Added pool_create_aligned.
+ *   v1.2 2026-10-18: Added pool_create_alloc.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+/*
+ * The cells are carved out of slabs. Every slab starts with a link to
+ * the previously allocated slab so that all slabs can be freed on
+ * kill. The slabs double in size up to a limit, so a small list does
+ * not waste memory while a large one needs few slab allocations.
+ * Returned cells are linked into a free-list through their first word.
+ * In an aligned pool the slabs are allocated one cell larger than
+ * needed and the cells start at the first multiple of the cell size
+ * after the slab header, so every cell stays aligned.
+ */
+
+// Number of cells in the first and the largest slabs.
+#define POOL_FIRST_SLAB_CELLS 32
+#define POOL_MAX_SLAB_CELLS 65536
+
+struct slab {
+	struct slab *next;
+};
+
+// Size of the slab header, keeping the alignment of pointers.
+#define SLAB_HEADER ((sizeof(struct slab) + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *))
+
+struct free_cell {
+	struct free_cell *next;
+};
+
+struct pool {
+	size_t cell_size; // Size of every cell, at least one pointer.
+	bool aligned; // True if the cells are aligned to their size.
+	struct slab *slabs; // Most recently allocated slab.
+	char *unused; // First never handed out cell in the newest slab.
+	int unused_cells; // Number of never handed out cells left.
+	int slab_cells; // Number of cells in the newest slab.
+	struct free_cell *free_cells; // Returned cells.
+	const allocator *alloc; // Allocator for the pool and the slabs.
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * pool_create() - Create an empty pool.
+ * @cell_size: Size in bytes of every cell handed out by the pool.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *pool_create(size_t cell_size)
+{
+	return pool_create_alloc(cell_size, false, NULL);
+}
+
+/**
+ * pool_create_aligned() - Create an empty pool with size aligned cells.
+ * @cell_size: Size in bytes of every cell, a power of two.
+ *
+ * Every cell handed out by the pool starts at an address that is a
+ * multiple of cell_size, so the cell that an address inside it belongs
+ * to can be found by masking the address.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *pool_create_aligned(size_t cell_size)
+{
+	return pool_create_alloc(cell_size, true, NULL);
+}
+
+/**
+ * pool_create_alloc() - Create an empty pool that uses an allocator.
+ * @cell_size: Size in bytes of every cell handed out by the pool.
+ * @aligned: True to align the cells to their size like
+ *	     pool_create_aligned(), in which case cell_size must be a
+ *	     power of two.
+ * @a: Allocator for the pool and its slabs, or NULL for the default
+ *     allocator.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *pool_create_alloc(size_t cell_size, bool aligned, const allocator *a)
+{
+	pool *p=allocator_calloc(a, 1, sizeof(*p));
+	p->alloc=a;
+	p->aligned=aligned;
+
+	// Cells must be able to hold the free-list link and keep the
+	// alignment of pointers.
+	if (cell_size < sizeof(struct free_cell)) {
+		cell_size=sizeof(struct free_cell);
+	}
+	cell_size=(cell_size + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+	p->cell_size=cell_size;
+
+	return p;
+}
+
+/**
+ * pool_add_slab() - Allocate a new slab for the pool.
+ * @p: Pool to manipulate.
+ *
+ * Returns: Nothing.
+ */
+static void pool_add_slab(pool *p)
+{
+	// Double the slab size up to the limit.
+	if (p->slab_cells == 0) {
+		p->slab_cells=POOL_FIRST_SLAB_CELLS;
+	} else if (p->slab_cells < POOL_MAX_SLAB_CELLS) {
+		p->slab_cells*=2;
+	}
+
+	// The cells follow the slab header, an aligned pool needs room to
+	// move the first cell up to the next multiple of the cell size.
+	size_t extra=p->aligned ? p->cell_size : 0;
+	struct slab *s=allocator_alloc(p->alloc, SLAB_HEADER + extra + p->slab_cells * p->cell_size);
+	if (s == NULL) {
+		fprintf(stderr, "pool: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	s->next=p->slabs;
+	p->slabs=s;
+
+	p->unused=(char *)s + SLAB_HEADER;
+	if (p->aligned) {
+		uintptr_t first=(uintptr_t)p->unused;
+		first=(first + p->cell_size - 1) & ~(uintptr_t)(p->cell_size - 1);
+		p->unused=(char *)first;
+	}
+	p->unused_cells=p->slab_cells;
+}
+
+/**
+ * pool_alloc() - Get a cell from the pool.
+ * @p: Pool to allocate from.
+ *
+ * Returns: A pointer to a cell of the pool's cell size. The contents
+ *	    of the cell are undefined.
+ */
+void *pool_alloc(pool *p)
+{
+	// Reuse a returned cell if there is one.
+	if (p->free_cells != NULL) {
+		struct free_cell *c=p->free_cells;
+		p->free_cells=c->next;
+		return c;
+	}
+
+	// Otherwise take the next cell from the newest slab.
+	if (p->unused_cells == 0) {
+		pool_add_slab(p);
+	}
+	void *c=p->unused;
+	p->unused+=p->cell_size;
+	p->unused_cells--;
+
+	return c;
+}
+
+/**
+ * pool_free() - Return a cell to the pool.
+ * @p: Pool the cell was allocated from.
+ * @cell: Cell to return.
+ *
+ * The cell is reused by later calls to pool_alloc().
+ *
+ * Returns: Nothing.
+ */
+void pool_free(pool *p, void *cell)
+{
+	struct free_cell *c=cell;
+	c->next=p->free_cells;
+	p->free_cells=c;
+}
+
+/**
+ * pool_kill() - Destroy a pool.
+ * @p: Pool to destroy.
+ *
+ * Returns the memory of all cells handed out by the pool, whether they
+ * have been returned or not.
+ *
+ * Returns: Nothing.
+ */
+void pool_kill(pool *p)
+{
+	struct slab *s=p->slabs;
+	while (s != NULL) {
+		struct slab *next=s->next;
+		allocator_free(p->alloc, s);
+		s=next;
+	}
+	allocator_free(p->alloc, p);
+}
@@ -0,0 +1,99 @@
+#ifndef __POOL_H
+#define __POOL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "allocator.h"
+
+/*
+ * Declaration of a pool of fixed size memory cells. The pool hands out
+ * cells from large slabs instead of allocating every cell on its own,
+ * and recycles returned cells through a free-list. All memory is given
+ * back at once when the pool is killed, so cells handed out by a pool
+ * must not be used after pool_kill.
+ *
+ * The lists use pools for their cells, see dlist_empty_pooled() and
+ * list_empty_pooled(). A pool may be private to one list or shared
+ * between many lists with cells of the same size.
+ *
+ * The slabs come from the allocator given to pool_create_alloc(), or
+ * from malloc() for the other create functions.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: Added pool_create_aligned.
+ *   v1.2 2026-10-18: Added pool_create_alloc.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Pool type.
+typedef struct pool pool;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * pool_create() - Create an empty pool.
+ * @cell_size: Size in bytes of every cell handed out by the pool.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *pool_create(size_t cell_size);
+
+/**
+ * pool_create_aligned() - Create an empty pool with size aligned cells.
+ * @cell_size: Size in bytes of every cell, a power of two.
+ *
+ * Every cell handed out by the pool starts at an address that is a
+ * multiple of cell_size, so the cell that an address inside it belongs
+ * to can be found by masking the address.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *pool_create_aligned(size_t cell_size);
+
+/**
+ * pool_create_alloc() - Create an empty pool that uses an allocator.
+ * @cell_size: Size in bytes of every cell handed out by the pool.
+ * @aligned: True to align the cells to their size like
+ *	     pool_create_aligned(), in which case cell_size must be a
+ *	     power of two.
+ * @a: Allocator for the pool and its slabs, or NULL for the default
+ *     allocator.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *pool_create_alloc(size_t cell_size, bool aligned, const allocator *a);
+
+/**
+ * pool_alloc() - Get a cell from the pool.
+ * @p: Pool to allocate from.
+ *
+ * Returns: A pointer to a cell of the pool's cell size. The contents
+ *	    of the cell are undefined.
+ */
+void *pool_alloc(pool *p);
+
+/**
+ * pool_free() - Return a cell to the pool.
+ * @p: Pool the cell was allocated from.
+ * @cell: Cell to return.
+ *
+ * The cell is reused by later calls to pool_alloc().
+ *
+ * Returns: Nothing.
+ */
+void pool_free(pool *p, void *cell);
+
+/**
+ * pool_kill() - Destroy a pool.
+ * @p: Pool to destroy.
+ *
+ * Returns the memory of all cells handed out by the pool, whether they
+ * have been returned or not.
+ *
+ * Returns: Nothing.
+ */
+void pool_kill(pool *p);
+
+#endif
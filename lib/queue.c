@@ -2,7 +2,6 @@
 #include <stdlib.h>
 
 #include <queue.h>
-#include <list.h>
 
 /*
  * Implementation of a generic queue for the "Datastructures and
@@ -17,21 +16,73 @@
  * Version information:
  *   v1.0  2018-01-28: First public version.
  *   v1.01 2024-01-16: Fix include to be with brackets, not citation marks.
+ *   v1.1  2026-10-18: Circular array instead of a list, added
+ *                     queue_reserve, queue_clear and int_queue.
+ *   v1.2  2026-10-18: Queues may get their memory from an allocator.
+ *   v1.3  2026-10-18: Removed int_queue.
  */
 
 // ===========INTERNAL DATA TYPES============
 
 /*
- * The queue is implemented using the list abstract datatype. Almost
- * everything is done by the list.
+ * The queue is implemented as a circular array. The capacity is always
+ * a power of two so that positions can be wrapped with a mask. When the
+ * array is full its capacity is doubled, so enqueue and dequeue do not
+ * allocate any memory in the common case.
  */
 
+// Capacity of a newly created queue.
+#define QUEUE_INITIAL_CAPACITY 16
+
 struct queue {
-	list *elements;
+	void **values; // Circular array of values.
+	int capacity; // Number of slots in values, a power of two.
+	int front; // Index of the front element.
+	int size; // Number of elements in the queue.
+	free_function free_func;
+	const allocator *alloc; // Allocator for the queue and its array.
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
 
+/**
+ * queue_capacity_for() - Compute a capacity that can hold n elements.
+ * @current: Current capacity, a power of two.
+ * @n: Number of elements to hold.
+ *
+ * Returns: The smallest power of two multiple of current that is at
+ *	    least n.
+ */
+static int queue_capacity_for(int current, int n)
+{
+	int capacity=current;
+	while (capacity < n) {
+		capacity*=2;
+	}
+	return capacity;
+}
+
+/**
+ * queue_grow() - Move the values into a larger array.
+ * @q: Queue to manipulate.
+ * @capacity: New capacity, a power of two larger than the old one.
+ *
+ * The elements are stored from index 0 in the new array.
+ *
+ * Returns: Nothing.
+ */
+static void queue_grow(queue *q, int capacity)
+{
+	void **values=allocator_alloc(q->alloc, capacity * sizeof(void *));
+	for (int i=0; i<q->size; i++) {
+		values[i]=q->values[(q->front + i) & (q->capacity - 1)];
+	}
+	allocator_free(q->alloc, q->values);
+	q->values=values;
+	q->capacity=capacity;
+	q->front=0;
+}
+
 /**
  * queue_empty() - Create an empty queue.
  * @free_func: A pointer to a function (or NULL) to be called to
@@ -40,11 +91,29 @@ struct queue {
  * Returns: A pointer to the new queue.
  */
 queue *queue_empty(free_function free_func)
+{
+	return queue_empty_alloc(free_func, NULL);
+}
+
+/**
+ * queue_empty_alloc() - Create an empty queue that uses an allocator.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @a: Allocator for the queue and its array, or NULL for the default
+ *     allocator.
+ *
+ * Returns: A pointer to the new queue.
+ */
+queue *queue_empty_alloc(free_function free_func, const allocator *a)
 {
 	// Allocate the queue head.
-	queue *q=calloc(1, sizeof(*q));
-	// Create an empty list.
-	q->elements=list_empty(free_func);
+	queue *q=allocator_calloc(a, 1, sizeof(*q));
+	q->alloc=a;
+	// Allocate the initial array.
+	q->capacity=QUEUE_INITIAL_CAPACITY;
+	q->values=allocator_alloc(a, q->capacity * sizeof(void *));
+	// Store the free function.
+	q->free_func=free_func;
 
 	return q;
 }
@@ -57,7 +126,7 @@ queue *queue_empty(free_function free_func)
  */
 bool queue_is_empty(const queue *q)
 {
-	return list_is_empty(q->elements);
+	return q->size == 0;
 }
 
 /**
@@ -69,7 +138,12 @@ bool queue_is_empty(const queue *q)
  */
 queue *queue_enqueue(queue *q, void *v)
 {
-	list_insert(q->elements, v, list_end(q->elements));
+	// Double the capacity if the array is full.
+	if (q->size == q->capacity) {
+		queue_grow(q, q->capacity * 2);
+	}
+	q->values[(q->front + q->size) & (q->capacity - 1)]=v;
+	q->size++;
 	return q;
 }
 
@@ -83,7 +157,12 @@ queue *queue_enqueue(queue *q, void *v)
  */
 queue *queue_dequeue(queue *q)
 {
-	list_remove(q->elements, list_first(q->elements));
+	// Call free_func if registered.
+	if (q->free_func != NULL) {
+		q->free_func(q->values[q->front]);
+	}
+	q->front=(q->front + 1) & (q->capacity - 1);
+	q->size--;
 	return q;
 }
 
@@ -96,7 +175,7 @@ queue *queue_dequeue(queue *q)
  */
 void *queue_front(const queue *q)
 {
-	return list_inspect(q->elements, list_first(q->elements));
+	return q->values[q->front];
 }
 
 /**
@@ -111,8 +190,9 @@ void *queue_front(const queue *q)
  */
 void queue_kill(queue *q)
 {
-	list_kill(q->elements);
-	free(q);
+	queue_clear(q);
+	allocator_free(q->alloc, q->values);
+	allocator_free(q->alloc, q);
 }
 
 /**
@@ -128,13 +208,47 @@ void queue_kill(queue *q)
 void queue_print(const queue *q, inspect_callback print_func)
 {
 	printf("{ ");
-	list_pos pos = list_first(q->elements);
-	while (pos != list_end(q->elements)) {
-		print_func(list_inspect(q->elements, pos));
-		pos = list_next(q->elements, pos);
-		if (pos != list_end(q->elements)) {
+	for (int i=0; i<q->size; i++) {
+		print_func(q->values[(q->front + i) & (q->capacity - 1)]);
+		if (i < q->size - 1) {
 			printf(", ");
 		}
 	}
 	printf(" }\n");
 }
+
+/**
+ * queue_reserve() - Make room for a number of elements in the queue.
+ * @q: Queue to manipulate.
+ * @n: Number of elements the queue should be able to hold.
+ *
+ * Makes sure that the queue can hold at least n elements without
+ * allocating any more memory.
+ *
+ * Returns: The modified queue.
+ */
+queue *queue_reserve(queue *q, int n)
+{
+	if (n > q->capacity) {
+		queue_grow(q, queue_capacity_for(q->capacity, n));
+	}
+	return q;
+}
+
+/**
+ * queue_clear() - Remove all elements from a queue.
+ * @q: Queue to manipulate.
+ *
+ * Removes all elements but keeps the memory of the queue for reuse. If
+ * a free_func was registered at queue creation, calls it for each element.
+ *
+ * Returns: The modified queue.
+ */
+queue *queue_clear(queue *q)
+{
+	while (!queue_is_empty(q)) {
+		q=queue_dequeue(q);
+	}
+	q->front=0;
+	return q;
+}
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include "util.h"
+#include "allocator.h"
 
 /*
  * Declaration of a generic queue for the "Datastructures and
@@ -21,6 +22,11 @@
  *
  * Version information:
  *   v1.0 2018-01-28: First public version.
+ *   v1.1 2026-10-18: Added queue_reserve, queue_clear and the int_queue
+ *                    for integer ids.
+ *   v1.2 2026-10-18: Added queue_empty_alloc.
+ *   v1.3 2026-10-18: Removed the int_queue, queue_u32 in
+ *                    container_typed.h is the queue for integer ids.
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -39,6 +45,17 @@ typedef struct queue queue;
  */
 queue *queue_empty(free_function free_func);
 
+/**
+ * queue_empty_alloc() - Create an empty queue that uses an allocator.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ * @a: Allocator for the queue and its array, or NULL for the default
+ *     allocator.
+ *
+ * Returns: A pointer to the new queue.
+ */
+queue *queue_empty_alloc(free_function free_func, const allocator *a);
+
 /**
  * queue_is_empty() - Check if a queue is empty.
  * @q: Queue to check.
@@ -99,4 +116,27 @@ void queue_kill(queue *q);
  */
 void queue_print(const queue *q, inspect_callback print_func);
 
+/**
+ * queue_reserve() - Make room for a number of elements in the queue.
+ * @q: Queue to manipulate.
+ * @n: Number of elements the queue should be able to hold.
+ *
+ * Makes sure that the queue can hold at least n elements without
+ * allocating any more memory.
+ *
+ * Returns: The modified queue.
+ */
+queue *queue_reserve(queue *q, int n);
+
+/**
+ * queue_clear() - Remove all elements from a queue.
+ * @q: Queue to manipulate.
+ *
+ * Removes all elements but keeps the memory of the queue for reuse. If
+ * a free_func was registered at queue creation, calls it for each element.
+ *
+ * Returns: The modified queue.
+ */
+queue *queue_clear(queue *q);
+
 #endif
@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <radix_heap.h>
+
+/*
+ * Implementation of a monotone radix heap.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// One bucket for equal priorities and one for every bit.
+#define RADIX_BUCKETS 33
+
+struct radix_entry {
+	uint32_t priority;
+	int id;
+};
+
+struct radix_bucket {
+	struct radix_entry *entries;
+	int size;
+	int capacity;
+};
+
+struct radix_heap {
+	struct radix_bucket buckets[RADIX_BUCKETS];
+	uint32_t last; // Last removed priority.
+	int size; // Number of values in all buckets.
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * bucket_of() - Internal function to find the bucket of a priority.
+ * @last: Last removed priority.
+ * @priority: Priority, at least last.
+ *
+ * Returns: 0 if the priorities are equal, otherwise one plus the index
+ *	    of the highest bit where they differ.
+ */
+static int bucket_of(uint32_t last, uint32_t priority)
+{
+	uint32_t diff=last ^ priority;
+	return diff == 0 ? 0 : 32 - __builtin_clz(diff);
+}
+
+/**
+ * bucket_push() - Internal function to add an entry to a bucket.
+ * @b: Bucket to manipulate.
+ * @e: Entry to add.
+ *
+ * Returns: Nothing.
+ */
+static void bucket_push(struct radix_bucket *b, struct radix_entry e)
+{
+	if (b->size == b->capacity) {
+		int capacity=b->capacity == 0 ? 16 : 2*b->capacity;
+		struct radix_entry *entries=realloc(b->entries, capacity * sizeof(*entries));
+		if (entries == NULL) {
+			fprintf(stderr, "radix_heap: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		b->entries=entries;
+		b->capacity=capacity;
+	}
+	b->entries[b->size++]=e;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * radix_heap_empty() - Create an empty heap.
+ *
+ * Returns: A pointer to the new heap.
+ */
+radix_heap *radix_heap_empty(void)
+{
+	return calloc(1, sizeof(radix_heap));
+}
+
+/**
+ * radix_heap_is_empty() - Check if a heap is empty.
+ * @h: Heap to check.
+ *
+ * Returns: True if heap is empty, otherwise false.
+ */
+bool radix_heap_is_empty(const radix_heap *h)
+{
+	return h->size == 0;
+}
+
+/**
+ * radix_heap_size() - Return the number of values in the heap.
+ * @h: Heap to inspect.
+ *
+ * Returns: The number of values in the heap.
+ */
+int radix_heap_size(const radix_heap *h)
+{
+	return h->size;
+}
+
+/**
+ * radix_heap_insert() - Put an id with a priority in the heap.
+ * @h: Heap to manipulate.
+ * @id: Id to insert.
+ * @priority: Priority of the id, at least the last removed priority.
+ *
+ * Returns: Nothing.
+ */
+void radix_heap_insert(radix_heap *h, int id, uint32_t priority)
+{
+	struct radix_entry e={ priority, id };
+	bucket_push(&h->buckets[bucket_of(h->last, priority)], e);
+	h->size++;
+}
+
+/**
+ * radix_heap_remove_front() - Remove an id with the lowest priority.
+ * @h: Heap to manipulate.
+ * @priority: Where to store the priority of the id, or NULL.
+ *
+ * NOTE: Undefined for an empty heap.
+ *
+ * Returns: The removed id.
+ */
+int radix_heap_remove_front(radix_heap *h, uint32_t *priority)
+{
+	if (h->buckets[0].size == 0) {
+		// Find the first non-empty bucket and its lowest priority.
+		int b=1;
+		while (h->buckets[b].size == 0) {
+			b++;
+		}
+		struct radix_bucket *from=&h->buckets[b];
+		uint32_t min=from->entries[0].priority;
+		for (int k=1; k<from->size; k++) {
+			if (from->entries[k].priority < min) {
+				min=from->entries[k].priority;
+			}
+		}
+
+		// Everything in the bucket moves to a lower bucket relative
+		// to the new lowest priority.
+		h->last=min;
+		for (int k=0; k<from->size; k++) {
+			struct radix_entry e=from->entries[k];
+			bucket_push(&h->buckets[bucket_of(min, e.priority)], e);
+		}
+		from->size=0;
+	}
+
+	struct radix_bucket *b0=&h->buckets[0];
+	struct radix_entry e=b0->entries[--b0->size];
+	h->size--;
+	if (priority != NULL) {
+		*priority=e.priority;
+	}
+	return e.id;
+}
+
+/**
+ * radix_heap_clear() - Remove all values from the heap.
+ * @h: Heap to manipulate.
+ *
+ * The lowest allowed priority is reset to zero.
+ *
+ * Returns: Nothing.
+ */
+void radix_heap_clear(radix_heap *h)
+{
+	for (int b=0; b<RADIX_BUCKETS; b++) {
+		h->buckets[b].size=0;
+	}
+	h->last=0;
+	h->size=0;
+}
+
+/**
+ * radix_heap_kill() - Destroy a given heap.
+ * @h: Heap to destroy.
+ *
+ * Returns: Nothing.
+ */
+void radix_heap_kill(radix_heap *h)
+{
+	for (int b=0; b<RADIX_BUCKETS; b++) {
+		free(h->buckets[b].entries);
+	}
+	free(h);
+}
@@ -0,0 +1,97 @@
+#ifndef __RADIX_HEAP_H
+#define __RADIX_HEAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "util.h"
+
+/*
+ * Declaration of a monotone radix heap, a priority queue for
+ * non-negative integer priorities where no inserted priority is lower
+ * than the last removed one. Dijkstra's algorithm with integer weights
+ * uses the heap that way. Each inserted value is an integer id with a
+ * priority, and the same id may be inserted several times. Instead of
+ * lowering the priority of an id, insert it again and skip the stale
+ * copies when they are removed.
+ *
+ * The heap keeps 33 buckets. Bucket 0 holds the priorities equal to the
+ * last removed one, and bucket b holds the priorities whose highest bit
+ * that differs from the last removed one is bit b-1. Every value moves
+ * to a lower bucket at most 32 times, so insert and remove take
+ * amortized constant time. The buckets are growable arrays, so there is
+ * no allocation per element.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Heap type.
+typedef struct radix_heap radix_heap;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * radix_heap_empty() - Create an empty heap.
+ *
+ * Returns: A pointer to the new heap.
+ */
+radix_heap *radix_heap_empty(void);
+
+/**
+ * radix_heap_is_empty() - Check if a heap is empty.
+ * @h: Heap to check.
+ *
+ * Returns: True if heap is empty, otherwise false.
+ */
+bool radix_heap_is_empty(const radix_heap *h);
+
+/**
+ * radix_heap_size() - Return the number of values in the heap.
+ * @h: Heap to inspect.
+ *
+ * Returns: The number of values in the heap.
+ */
+int radix_heap_size(const radix_heap *h);
+
+/**
+ * radix_heap_insert() - Put an id with a priority in the heap.
+ * @h: Heap to manipulate.
+ * @id: Id to insert.
+ * @priority: Priority of the id, at least the last removed priority.
+ *
+ * Returns: Nothing.
+ */
+void radix_heap_insert(radix_heap *h, int id, uint32_t priority);
+
+/**
+ * radix_heap_remove_front() - Remove an id with the lowest priority.
+ * @h: Heap to manipulate.
+ * @priority: Where to store the priority of the id, or NULL.
+ *
+ * NOTE: Undefined for an empty heap.
+ *
+ * Returns: The removed id.
+ */
+int radix_heap_remove_front(radix_heap *h, uint32_t *priority);
+
+/**
+ * radix_heap_clear() - Remove all values from the heap.
+ * @h: Heap to manipulate.
+ *
+ * The lowest allowed priority is reset to zero.
+ *
+ * Returns: Nothing.
+ */
+void radix_heap_clear(radix_heap *h);
+
+/**
+ * radix_heap_kill() - Destroy a given heap.
+ * @h: Heap to destroy.
+ *
+ * Returns: Nothing.
+ */
+void radix_heap_kill(radix_heap *h);
+
+#endif
@@ -0,0 +1,487 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <table.h>
+
+/*
+ * Implementation of a generic table as a robin hood hash table.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: Added table_reserve.
+ *   v1.2 2026-10-18: Memory may come from an allocator.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Initial number of slots, a power of two.
+#define TABLE_INITIAL_CAPACITY 16
+
+/*
+ * A slot holds a key/value pair together with the upper half of the
+ * hash of the key and its probe distance: 1 if the entry is in its home
+ * slot (the lower bits of the hash), 2 if it is in the slot after, and
+ * so on. A distance of 0 marks an empty slot.
+ *
+ * Lookups stop at the first slot whose distance is shorter than the
+ * distance searched so far, since the key would have displaced that
+ * entry if it were in the table. Removal shifts the following entries
+ * back one slot instead of leaving tombstones.
+ */
+struct table_slot {
+	void *key;
+	void *value;
+	uint32_t hash; // Upper 32 bits of the hash of the key.
+	uint32_t dist; // Probe distance plus one, 0 if empty.
+};
+
+struct table {
+	struct table_slot *slots;
+	int capacity; // Number of slots, a power of two.
+	int size; // Number of key/value pairs.
+	hash_function *hash_func;
+	compare_function *key_cmp_func;
+	free_function key_free_func;
+	free_function value_free_func;
+	const allocator *alloc; // Allocator for the table and its slots.
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * table_find() - Internal function to find the slot of a key.
+ * @t: Table to inspect.
+ * @key: Key to look for.
+ * @h: Hash of the key.
+ *
+ * Returns: The index of the slot holding the key, or -1 if the key is
+ *	    not in the table.
+ */
+static int table_find(const table *t, const void *key, unsigned long long h)
+{
+	uint32_t mask=t->capacity-1;
+	uint32_t hash=h >> 32;
+	uint32_t i=h & mask;
+
+	for (uint32_t d=1; t->slots[i].dist >= d; d++) {
+		if (t->slots[i].hash == hash && t->key_cmp_func(t->slots[i].key, key) == 0) {
+			return i;
+		}
+		i=(i+1) & mask;
+	}
+	return -1;
+}
+
+/**
+ * table_place() - Internal function to place a new entry.
+ * @t: Table to manipulate.
+ * @key: Key of the entry, not in the table.
+ * @value: Value of the entry.
+ * @h: Hash of the key.
+ *
+ * NOTE: The table must have a free slot.
+ *
+ * Returns: Nothing.
+ */
+static void table_place(table *t, void *key, void *value, unsigned long long h)
+{
+	uint32_t mask=t->capacity-1;
+	uint32_t i=h & mask;
+	struct table_slot e={ key, value, h >> 32, 1 };
+
+	for (;;) {
+		struct table_slot *s=&t->slots[i];
+		if (s->dist == 0) {
+			*s=e;
+			return;
+		}
+		// Take the slot from an entry that is closer to its home.
+		if (s->dist < e.dist) {
+			struct table_slot tmp=*s;
+			*s=e;
+			e=tmp;
+		}
+		e.dist++;
+		i=(i+1) & mask;
+	}
+}
+
+/**
+ * table_alloc_slots() - Internal function to allocate empty slots.
+ * @t: Table the slots are for.
+ * @capacity: Number of slots.
+ *
+ * Exits the program if not enough memory was available.
+ *
+ * Returns: A pointer to the slots.
+ */
+static struct table_slot *table_alloc_slots(const table *t, int capacity)
+{
+	struct table_slot *slots=allocator_calloc(t->alloc, capacity, sizeof(struct table_slot));
+	if (slots == NULL) {
+		fprintf(stderr, "table: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	return slots;
+}
+
+/**
+ * table_grow() - Internal function to increase the number of slots.
+ * @t: Table to manipulate.
+ * @capacity: New number of slots, a larger power of two.
+ *
+ * Returns: Nothing.
+ */
+static void table_grow(table *t, int capacity)
+{
+	struct table_slot *old=t->slots;
+	int old_capacity=t->capacity;
+
+	t->capacity=capacity;
+	t->slots=table_alloc_slots(t, t->capacity);
+	for (int i=0; i<old_capacity; i++) {
+		if (old[i].dist != 0) {
+			table_place(t, old[i].key, old[i].value, t->hash_func(old[i].key));
+		}
+	}
+	allocator_free(t->alloc, old);
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * table_empty() - Create an empty table.
+ * @hash_func: A pointer to a function to hash keys.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty(hash_function *hash_func, compare_function *key_cmp_func,
+		   free_function key_free_func, free_function value_free_func)
+{
+	return table_empty_alloc(hash_func, key_cmp_func, key_free_func, value_free_func, NULL);
+}
+
+/**
+ * table_empty_alloc() - Create an empty table that uses an allocator.
+ * @hash_func: A pointer to a function to hash keys.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ * @a: Allocator for the table and its slots, or NULL for the default
+ *     allocator.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_alloc(hash_function *hash_func, compare_function *key_cmp_func,
+			 free_function key_free_func, free_function value_free_func,
+			 const allocator *a)
+{
+	table *t=allocator_calloc(a, 1, sizeof(*t));
+	t->alloc=a;
+	t->capacity=TABLE_INITIAL_CAPACITY;
+	t->slots=table_alloc_slots(t, t->capacity);
+	t->hash_func=hash_func;
+	t->key_cmp_func=key_cmp_func;
+	t->key_free_func=key_free_func;
+	t->value_free_func=value_free_func;
+
+	return t;
+}
+
+/**
+ * table_empty_string() - Create an empty table with string keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_string(free_function key_free_func, free_function value_free_func)
+{
+	return table_empty(table_hash_string, table_compare_string,
+			   key_free_func, value_free_func);
+}
+
+/**
+ * table_empty_int() - Create an empty table with integer keys.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * The keys are integers converted with TABLE_INT_KEY().
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_int(free_function value_free_func)
+{
+	return table_empty(table_hash_int, table_compare_int, NULL, value_free_func);
+}
+
+/**
+ * table_is_empty() - Check if a table is empty.
+ * @t: Table to check.
+ *
+ * Returns: True if table contains no key/value pairs, false otherwise.
+ */
+bool table_is_empty(const table *t)
+{
+	return t->size == 0;
+}
+
+/**
+ * table_size() - Return the number of key/value pairs in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of key/value pairs.
+ */
+int table_size(const table *t)
+{
+	return t->size;
+}
+
+/**
+ * table_reserve() - Make room for a number of key/value pairs.
+ * @t: Table to manipulate.
+ * @n: Number of pairs the table should be able to hold.
+ *
+ * Returns: The modified table.
+ */
+table *table_reserve(table *t, int n)
+{
+	// Same bound as in table_insert().
+	int capacity=t->capacity;
+	while (8 * (long long)n > 7 * (long long)capacity) {
+		capacity*=2;
+	}
+	if (capacity > t->capacity) {
+		table_grow(t, capacity);
+	}
+	return t;
+}
+
+/**
+ * table_insert() - Add a key/value pair to a table.
+ * @t: Table to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * Insert the key/value pair into the table. If the key already exists,
+ * the key/value pair is replaced, and the free functions are called for
+ * the old key and value.
+ *
+ * Returns: The modified table.
+ */
+table *table_insert(table *t, void *key, void *value)
+{
+	unsigned long long h=t->hash_func(key);
+	int i=table_find(t, key, h);
+
+	if (i >= 0) {
+		// Replace the pair, freeing the old key and value.
+		struct table_slot *s=&t->slots[i];
+		if (t->key_free_func != NULL && s->key != key) {
+			t->key_free_func(s->key);
+		}
+		if (t->value_free_func != NULL && s->value != value) {
+			t->value_free_func(s->value);
+		}
+		s->key=key;
+		s->value=value;
+		return t;
+	}
+
+	// Keep the table at most 7/8 full.
+	if (8 * (t->size+1) > 7 * t->capacity) {
+		table_grow(t, 2*t->capacity);
+	}
+	table_place(t, key, value, h);
+	t->size++;
+
+	return t;
+}
+
+/**
+ * table_lookup() - Look up a given key in a table.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to a given key, or NULL if the key
+ * is not found in the table.
+ */
+void *table_lookup(const table *t, const void *key)
+{
+	int i=table_find(t, key, t->hash_func(key));
+	return i >= 0 ? t->slots[i].value : NULL;
+}
+
+/**
+ * table_has_key() - Check if a key is in a table.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: True if the key is in the table, also when its value is
+ * NULL, otherwise false.
+ */
+bool table_has_key(const table *t, const void *key)
+{
+	return table_find(t, key, t->hash_func(key)) >= 0;
+}
+
+/**
+ * table_remove() - Remove a key/value pair in the table.
+ * @t: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Will call any free functions set for keys/values. Does nothing if
+ * key is not found in the table.
+ *
+ * Returns: The modified table.
+ */
+table *table_remove(table *t, const void *key)
+{
+	int i=table_find(t, key, t->hash_func(key));
+	if (i < 0) {
+		return t;
+	}
+
+	if (t->key_free_func != NULL) {
+		t->key_free_func(t->slots[i].key);
+	}
+	if (t->value_free_func != NULL) {
+		t->value_free_func(t->slots[i].value);
+	}
+
+	// Shift the following entries that are not in their home slot back.
+	uint32_t mask=t->capacity-1;
+	uint32_t next=(i+1) & mask;
+	while (t->slots[next].dist > 1) {
+		t->slots[i]=t->slots[next];
+		t->slots[i].dist--;
+		i=next;
+		next=(next+1) & mask;
+	}
+	t->slots[i].dist=0;
+	t->size--;
+
+	return t;
+}
+
+/**
+ * table_kill() - Destroy a table.
+ * @t: Table to destroy.
+ *
+ * Return all dynamic memory used by the table and its elements. If a
+ * free_func was registered for keys and/or values at table creation,
+ * it is called each element to free any user-allocated memory
+ * occupied by the element values.
+ *
+ * Returns: Nothing.
+ */
+void table_kill(table *t)
+{
+	for (int i=0; i<t->capacity; i++) {
+		if (t->slots[i].dist == 0) {
+			continue;
+		}
+		if (t->key_free_func != NULL) {
+			t->key_free_func(t->slots[i].key);
+		}
+		if (t->value_free_func != NULL) {
+			t->value_free_func(t->slots[i].value);
+		}
+	}
+	allocator_free(t->alloc, t->slots);
+	allocator_free(t->alloc, t);
+}
+
+/**
+ * table_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Iterates over the key/value pairs in the table and prints them, in
+ * no particular order.
+ *
+ * Returns: Nothing.
+ */
+void table_print(const table *t, inspect_callback_pair print_func)
+{
+	for (int i=0; i<t->capacity; i++) {
+		if (t->slots[i].dist != 0) {
+			print_func(t->slots[i].key, t->slots[i].value);
+		}
+	}
+}
+
+/**
+ * table_hash_string() - Hash a string key.
+ * @key: A pointer to a NUL-terminated string.
+ *
+ * The hash is 64-bit FNV-1a followed by a final mix, so that both the
+ * lower bits (the home slot) and the upper bits (the stored hash)
+ * depend on every character.
+ *
+ * Returns: The hash of the string.
+ */
+unsigned long long table_hash_string(const void *key)
+{
+	unsigned long long h=14695981039346656037ull;
+	for (const unsigned char *s=key; *s != '\0'; s++) {
+		h=(h ^ *s) * 1099511628211ull;
+	}
+	h^=h >> 33;
+	h*=0xff51afd7ed558ccdull;
+	h^=h >> 33;
+	return h;
+}
+
+/**
+ * table_compare_string() - Compare two string keys.
+ * @k1: A pointer to a NUL-terminated string.
+ * @k2: A pointer to a NUL-terminated string.
+ *
+ * Returns: The result of strcmp().
+ */
+int table_compare_string(const void *k1, const void *k2)
+{
+	return strcmp(k1, k2);
+}
+
+/**
+ * table_hash_int() - Hash an integer key.
+ * @key: An integer converted with TABLE_INT_KEY().
+ *
+ * The hash is the finalizer of the splitmix64 generator.
+ *
+ * Returns: The hash of the integer.
+ */
+unsigned long long table_hash_int(const void *key)
+{
+	unsigned long long h=(unsigned long long)TABLE_KEY_INT(key);
+	h=(h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+	h=(h ^ (h >> 27)) * 0x94d049bb133111ebull;
+	return h ^ (h >> 31);
+}
+
+/**
+ * table_compare_int() - Compare two integer keys.
+ * @k1: An integer converted with TABLE_INT_KEY().
+ * @k2: An integer converted with TABLE_INT_KEY().
+ *
+ * Returns: A negative value, zero or a positive value if k1 is less
+ * than, equal to or greater than k2.
+ */
+int table_compare_int(const void *k1, const void *k2)
+{
+	intptr_t a=TABLE_KEY_INT(k1);
+	intptr_t b=TABLE_KEY_INT(k2);
+	return (a > b) - (a < b);
+}
@@ -0,0 +1,235 @@
+#ifndef __TABLE_H
+#define __TABLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "util.h"
+#include "allocator.h"
+
+/*
+ * Declaration of a generic table for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University. The table stores void pointers to keys and values, so
+ * it can be used to store all types of values. After use, the
+ * function table_kill must be called to de-allocate the dynamic memory
+ * used by the table itself. The de-allocation of any dynamic memory
+ * allocated for the keys and values is the responsibility of the user
+ * of the table, unless free_functions are registered in table_empty.
+ *
+ * The table is a hash table with open addressing and robin hood
+ * probing: an entry that is further from its home slot takes the slot
+ * of an entry that is closer to its own, which keeps all probe
+ * sequences short even when the table is 7/8 full. Every slot also
+ * stores the hash of its key, so keys are only compared when the
+ * hashes are equal.
+ *
+ * Tables with string keys and with integer keys are created with
+ * table_empty_string() and table_empty_int(). Integer keys are stored
+ * in the key pointer itself, see TABLE_INT_KEY() and
+ * TABLE_KEY_INT().
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ *   v1.1 2026-10-18: Added table_reserve.
+ *   v1.2 2026-10-18: Added table_empty_alloc.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Table type.
+typedef struct table table;
+
+// Convert an integer key to the key pointer and back.
+#define TABLE_INT_KEY(i) ((void *)(intptr_t)(i))
+#define TABLE_KEY_INT(k) ((intptr_t)(k))
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * table_empty() - Create an empty table.
+ * @hash_func: A pointer to a function to hash keys.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty(hash_function *hash_func, compare_function *key_cmp_func,
+		   free_function key_free_func, free_function value_free_func);
+
+/**
+ * table_empty_alloc() - Create an empty table that uses an allocator.
+ * @hash_func: A pointer to a function to hash keys.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ * @a: Allocator for the table and its slots, or NULL for the default
+ *     allocator.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_alloc(hash_function *hash_func, compare_function *key_cmp_func,
+			 free_function key_free_func, free_function value_free_func,
+			 const allocator *a);
+
+/**
+ * table_empty_string() - Create an empty table with string keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_string(free_function key_free_func, free_function value_free_func);
+
+/**
+ * table_empty_int() - Create an empty table with integer keys.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * The keys are integers converted with TABLE_INT_KEY().
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_int(free_function value_free_func);
+
+/**
+ * table_is_empty() - Check if a table is empty.
+ * @t: Table to check.
+ *
+ * Returns: True if table contains no key/value pairs, false otherwise.
+ */
+bool table_is_empty(const table *t);
+
+/**
+ * table_size() - Return the number of key/value pairs in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of key/value pairs.
+ */
+int table_size(const table *t);
+
+/**
+ * table_reserve() - Make room for a number of key/value pairs.
+ * @t: Table to manipulate.
+ * @n: Number of pairs the table should be able to hold.
+ *
+ * Sizes the slots once so that n pairs can be inserted without the
+ * table growing and rehashing its entries.
+ *
+ * Returns: The modified table.
+ */
+table *table_reserve(table *t, int n);
+
+/**
+ * table_insert() - Add a key/value pair to a table.
+ * @t: Table to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * Insert the key/value pair into the table. If the key already exists,
+ * the key/value pair is replaced, and the free functions are called for
+ * the old key and value.
+ *
+ * Returns: The modified table.
+ */
+table *table_insert(table *t, void *key, void *value);
+
+/**
+ * table_lookup() - Look up a given key in a table.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to a given key, or NULL if the key
+ * is not found in the table.
+ */
+void *table_lookup(const table *t, const void *key);
+
+/**
+ * table_has_key() - Check if a key is in a table.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: True if the key is in the table, also when its value is
+ * NULL, otherwise false.
+ */
+bool table_has_key(const table *t, const void *key);
+
+/**
+ * table_remove() - Remove a key/value pair in the table.
+ * @t: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Will call any free functions set for keys/values. Does nothing if
+ * key is not found in the table.
+ *
+ * Returns: The modified table.
+ */
+table *table_remove(table *t, const void *key);
+
+/**
+ * table_kill() - Destroy a table.
+ * @t: Table to destroy.
+ *
+ * Return all dynamic memory used by the table and its elements. If a
+ * free_func was registered for keys and/or values at table creation,
+ * it is called each element to free any user-allocated memory
+ * occupied by the element values.
+ *
+ * Returns: Nothing.
+ */
+void table_kill(table *t);
+
+/**
+ * table_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Iterates over the key/value pairs in the table and prints them, in
+ * no particular order.
+ *
+ * Returns: Nothing.
+ */
+void table_print(const table *t, inspect_callback_pair print_func);
+
+/**
+ * table_hash_string() - Hash a string key.
+ * @key: A pointer to a NUL-terminated string.
+ *
+ * Returns: The hash of the string.
+ */
+unsigned long long table_hash_string(const void *key);
+
+/**
+ * table_compare_string() - Compare two string keys.
+ * @k1: A pointer to a NUL-terminated string.
+ * @k2: A pointer to a NUL-terminated string.
+ *
+ * Returns: The result of strcmp().
+ */
+int table_compare_string(const void *k1, const void *k2);
+
+/**
+ * table_hash_int() - Hash an integer key.
+ * @key: An integer converted with TABLE_INT_KEY().
+ *
+ * Returns: The hash of the integer.
+ */
+unsigned long long table_hash_int(const void *key);
+
+/**
+ * table_compare_int() - Compare two integer keys.
+ * @k1: An integer converted with TABLE_INT_KEY().
+ * @k2: An integer converted with TABLE_INT_KEY().
+ *
+ * Returns: A negative value, zero or a positive value if k1 is less
+ * than, equal to or greater than k2.
+ */
+int table_compare_int(const void *k1, const void *k2);
+
+#endif
@@ -14,6 +14,7 @@
  *   v1.0 2018-01-28: First public version.
  *   v1.1 2018-02-06: Updated explanation for the compare_function.
  *   v1.2 2023-01-14: Added version DEFINE constants and strings.
+ *   v1.3 2026-10-18: Added the hash_function type.
  */
 
 // Macros to create a version string out of version constants
@@ -66,4 +67,11 @@ typedef void (*inspect_callback_pair)(const void *, const void *);
 // value should be returned.
 typedef int compare_function(const void *,const void *);
 
+// Type definition for hash function, used by e.g. table.
+//
+// Hash functions should return the same value for all arguments that
+// the matching comparison function considers equal, and should spread
+// different arguments evenly over all 64 bits.
+typedef unsigned long long hash_function(const void *);
+
 #endif
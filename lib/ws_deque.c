@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#include <ws_deque.h>
+
+/*
+ * Implementation of a lock-free work-stealing deque.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+/*
+ * The deque is the Chase-Lev deque with the C11 memory orderings of Le,
+ * Pop, Cohen and Zappa Nardelli, "Correct and efficient work-stealing
+ * for weak memory models" (PPoPP 2013). The values live in a circular
+ * buffer indexed by two ever increasing counters: the owner works at
+ * bottom, thieves take from top. The only contended case is the last
+ * value, which the owner and the thieves race for with a
+ * compare-and-swap on top.
+ *
+ * When the buffer is full the owner copies it into one twice as large.
+ * A thief may still be reading from the old buffer, so old buffers are
+ * not freed until the deque is killed.
+ */
+
+#define CACHE_LINE 64
+
+struct ws_buffer {
+	size_t size; // Number of slots, a power of two.
+	struct ws_buffer *older; // Buffer this one replaced.
+	_Atomic(void *) values[];
+};
+
+struct ws_deque {
+	atomic_llong top; // Next value for thieves.
+	char pad0[CACHE_LINE - sizeof(atomic_llong)];
+	atomic_llong bottom; // Next free slot for the owner.
+	_Atomic(struct ws_buffer *) buffer;
+	char pad1[CACHE_LINE];
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * ws_buffer_create() - Allocate a buffer.
+ * @size: Number of slots, a power of two.
+ *
+ * Returns: The new buffer.
+ */
+static struct ws_buffer *ws_buffer_create(size_t size)
+{
+	struct ws_buffer *b=malloc(sizeof(*b) + size * sizeof(b->values[0]));
+	b->size=size;
+	b->older=NULL;
+	return b;
+}
+
+/**
+ * ws_deque_empty() - Create an empty deque.
+ * @capacity: Initial capacity, rounded up to a power of two.
+ *
+ * Returns: A pointer to the new deque.
+ */
+ws_deque *ws_deque_empty(int capacity)
+{
+	size_t size=2;
+	while (size < (size_t)capacity) {
+		size*=2;
+	}
+
+	ws_deque *d=calloc(1, sizeof(*d));
+	atomic_init(&d->top, 0);
+	atomic_init(&d->bottom, 0);
+	atomic_init(&d->buffer, ws_buffer_create(size));
+
+	return d;
+}
+
+/**
+ * ws_deque_grow() - Replace the buffer with one twice as large.
+ * @d: Deque to manipulate.
+ * @b: Current buffer.
+ * @top: Current top counter.
+ * @bottom: Current bottom counter.
+ *
+ * Returns: The new buffer.
+ */
+static struct ws_buffer *ws_deque_grow(ws_deque *d, struct ws_buffer *b,
+				       long long top, long long bottom)
+{
+	struct ws_buffer *larger=ws_buffer_create(b->size * 2);
+	for (long long i=top; i<bottom; i++) {
+		void *v=atomic_load_explicit(&b->values[i & (b->size - 1)], memory_order_relaxed);
+		atomic_store_explicit(&larger->values[i & (larger->size - 1)], v, memory_order_relaxed);
+	}
+	// Keep the old buffer for thieves that still read from it.
+	larger->older=b;
+	atomic_store_explicit(&d->buffer, larger, memory_order_release);
+	return larger;
+}
+
+/**
+ * ws_deque_push() - Put a value at the bottom of the deque.
+ * @d: Deque to manipulate.
+ * @v: Value (pointer) to be put in the deque.
+ *
+ * NOTE: Must only be called by the owner of the deque.
+ *
+ * Returns: Nothing.
+ */
+void ws_deque_push(ws_deque *d, void *v)
+{
+	long long b=atomic_load_explicit(&d->bottom, memory_order_relaxed);
+	long long t=atomic_load_explicit(&d->top, memory_order_acquire);
+	struct ws_buffer *buf=atomic_load_explicit(&d->buffer, memory_order_relaxed);
+
+	if (b - t > (long long)buf->size - 1) {
+		buf=ws_deque_grow(d, buf, t, b);
+	}
+	atomic_store_explicit(&buf->values[b & (buf->size - 1)], v, memory_order_relaxed);
+	// Publish the value before the new bottom.
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+}
+
+/**
+ * ws_deque_pop() - Take the value at the bottom of the deque.
+ * @d: Deque to manipulate.
+ * @v: Where to store the value.
+ *
+ * NOTE: Must only be called by the owner of the deque.
+ *
+ * Returns: True if a value was taken, false if the deque was empty.
+ */
+bool ws_deque_pop(ws_deque *d, void **v)
+{
+	// Reserve the bottom value before looking at top.
+	long long b=atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+	struct ws_buffer *buf=atomic_load_explicit(&d->buffer, memory_order_relaxed);
+	atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	long long t=atomic_load_explicit(&d->top, memory_order_relaxed);
+
+	if (t > b) {
+		// The deque was empty, restore bottom.
+		atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+		return false;
+	}
+
+	*v=atomic_load_explicit(&buf->values[b & (buf->size - 1)], memory_order_relaxed);
+	if (t < b) {
+		// More than one value left, no thief can reach this one.
+		return true;
+	}
+
+	// Last value, race the thieves for it.
+	bool won=atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+							 memory_order_seq_cst,
+							 memory_order_relaxed);
+	atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+	return won;
+}
+
+/**
+ * ws_deque_steal() - Take the value at the top of the deque.
+ * @d: Deque to manipulate.
+ * @v: Where to store the value.
+ *
+ * Returns: True if a value was taken. False if the deque was empty or
+ *	    another thread took the value first, in which case the caller
+ *	    may try again.
+ */
+bool ws_deque_steal(ws_deque *d, void **v)
+{
+	long long t=atomic_load_explicit(&d->top, memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	long long b=atomic_load_explicit(&d->bottom, memory_order_acquire);
+
+	if (t >= b) {
+		return false;
+	}
+
+	struct ws_buffer *buf=atomic_load_explicit(&d->buffer, memory_order_acquire);
+	void *value=atomic_load_explicit(&buf->values[t & (buf->size - 1)], memory_order_relaxed);
+	if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+						     memory_order_seq_cst,
+						     memory_order_relaxed)) {
+		// Lost the race against the owner or another thief.
+		return false;
+	}
+	*v=value;
+	return true;
+}
+
+/**
+ * ws_deque_kill() - Destroy a given deque.
+ * @d: Deque to destroy.
+ *
+ * No other thread may use the deque during or after the call. The
+ * values left in the deque are not freed.
+ *
+ * Returns: Nothing.
+ */
+void ws_deque_kill(ws_deque *d)
+{
+	struct ws_buffer *buf=atomic_load_explicit(&d->buffer, memory_order_relaxed);
+	while (buf != NULL) {
+		struct ws_buffer *older=buf->older;
+		free(buf);
+		buf=older;
+	}
+	free(d);
+}
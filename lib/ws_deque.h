@@ -0,0 +1,82 @@
+#ifndef __WS_DEQUE_H
+#define __WS_DEQUE_H
+
+#include <stdbool.h>
+#include "util.h"
+
+/*
+ * Declaration of a lock-free work-stealing deque. The deque belongs to
+ * one owner thread that pushes and pops values at the bottom, like a
+ * stack. Any other thread may steal values from the top. This is the
+ * usual building block for parallel traversals, where every worker
+ * keeps its own deque and idle workers steal from the others.
+ *
+ * ws_deque_push() and ws_deque_pop() may only be called by the owner.
+ * ws_deque_steal() may be called by any number of threads at the same
+ * time. The deque grows when it is full. The deque must be compiled
+ * with C11 atomics (<stdatomic.h>).
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Deque type.
+typedef struct ws_deque ws_deque;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * ws_deque_empty() - Create an empty deque.
+ * @capacity: Initial capacity, rounded up to a power of two.
+ *
+ * Returns: A pointer to the new deque.
+ */
+ws_deque *ws_deque_empty(int capacity);
+
+/**
+ * ws_deque_push() - Put a value at the bottom of the deque.
+ * @d: Deque to manipulate.
+ * @v: Value (pointer) to be put in the deque.
+ *
+ * NOTE: Must only be called by the owner of the deque.
+ *
+ * Returns: Nothing.
+ */
+void ws_deque_push(ws_deque *d, void *v);
+
+/**
+ * ws_deque_pop() - Take the value at the bottom of the deque.
+ * @d: Deque to manipulate.
+ * @v: Where to store the value.
+ *
+ * NOTE: Must only be called by the owner of the deque.
+ *
+ * Returns: True if a value was taken, false if the deque was empty.
+ */
+bool ws_deque_pop(ws_deque *d, void **v);
+
+/**
+ * ws_deque_steal() - Take the value at the top of the deque.
+ * @d: Deque to manipulate.
+ * @v: Where to store the value.
+ *
+ * Returns: True if a value was taken. False if the deque was empty or
+ *	    another thread took the value first, in which case the caller
+ *	    may try again.
+ */
+bool ws_deque_steal(ws_deque *d, void **v);
+
+/**
+ * ws_deque_kill() - Destroy a given deque.
+ * @d: Deque to destroy.
+ *
+ * No other thread may use the deque during or after the call. The
+ * values left in the deque are not freed.
+ *
+ * Returns: Nothing.
+ */
+void ws_deque_kill(ws_deque *d);
+
+#endif
@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include <mapfile.h>
+#include <mapscan.h>
+#include <mapimage.h>
+
+/**
+ * @brief Compiles a map file in the is_connected format into a binary
+ * map image, see mapimage.h. is_connected loads an image with
+ * "./is_connected --image <image file>" by mapping it into memory, so
+ * its startup time does not depend on the size of the map.
+ *
+ * The image reflects the map file when it was compiled and has to be
+ * compiled again when the map changes.
+ *
+ * Usage: ./map_compile <map file> <image file>
+ */
+
+int main(int argc, char const *argv[])
+{
+	if (argc != 3)
+	{
+		fprintf(stderr, "Usage: %s <map file> <image file>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	mapfile *file = mapfile_open(argv[1]);
+	if (file == NULL)
+	{
+		fprintf(stderr, "Invalid file name!\n");
+		return EXIT_FAILURE;
+	}
+
+	// Reads the labels and edges with the same checks as is_connected.
+	map_scan scan;
+	map_scan_status status = map_scan_buffer(mapfile_data(file), mapfile_size(file), 0, &scan);
+	mapfile_close(file);
+	if (status == MAP_SCAN_NO_COUNT)
+	{
+		fprintf(stderr, "Wrong format on map file!\n");
+		return EXIT_FAILURE;
+	}
+	if (status == MAP_SCAN_BAD_LINE)
+	{
+		fprintf(stderr, "Parsing line error, make sure map file is correct!\n");
+		return EXIT_FAILURE;
+	}
+
+	// Duplicate edges are written once, so the image may have fewer edges than the file.
+	int n_edges = map_image_write(argv[2], &scan);
+	if (n_edges < 0)
+	{
+		fprintf(stderr, "Could not write %s: %s\n", argv[2], strerror(errno));
+		map_scan_free(&scan);
+		return EXIT_FAILURE;
+	}
+
+	printf("Compiled %d nodes and %d edges into %s.\n", intern_size(scan.labels), n_edges,
+	       argv[2]);
+	map_scan_free(&scan);
+
+	return EXIT_SUCCESS;
+}
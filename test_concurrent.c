@@ -0,0 +1,352 @@
+// For clock_gettime() and sysconf().
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <mpmc_queue.h>
+#include <ws_deque.h>
+
+/**
+ * @brief Stress test and throughput benchmark for the lock-free
+ * queue (mpmc_queue) and the work-stealing deque (ws_deque).
+ *
+ * The stress tests check that every value put in by any thread is
+ * taken out exactly once, and that the queue keeps the order of the
+ * values from each producer. The benchmark then reports the throughput
+ * for 1 up to max_threads threads.
+ *
+ * Usage: ./test_concurrent [max_threads]
+ */
+
+#define STRESS_ITEMS 200000
+#define BENCH_ITEMS 2000000
+#define MAX_THREADS 64
+
+void error(const char *FAIL, const char *GOT)
+{
+    fprintf(stderr, "%s\n", FAIL);
+    fprintf(stderr, "%s\n", GOT);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * seconds_now() - Returns a monotonic time stamp in seconds.
+ */
+double seconds_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * backoff() - Sleeps for a short while after a failed operation, so that
+ * the other threads get to run when there are more threads than cores.
+ */
+void backoff(void)
+{
+    struct timespec ts = { 0, 1000 };
+    nanosleep(&ts, NULL);
+}
+
+// ====== MPMC QUEUE STRESS TEST
+
+// Values are 1 + producer * STRESS_ITEMS + sequence number, so that no value is NULL.
+typedef struct mpmc_stress {
+    mpmc_queue *q;
+    int producers;
+    atomic_int consumed;
+    atomic_uchar *taken;
+} mpmc_stress;
+
+typedef struct thread_arg {
+    mpmc_stress *shared;
+    int id;
+} thread_arg;
+
+void *mpmc_producer(void *in)
+{
+    thread_arg *arg = in;
+    mpmc_stress *s = arg->shared;
+
+    for (int i = 0; i < STRESS_ITEMS; i++)
+    {
+        uintptr_t v = 1 + (uintptr_t)arg->id * STRESS_ITEMS + i;
+        while (!mpmc_queue_enqueue(s->q, (void *)v))
+            backoff();
+    }
+    return NULL;
+}
+
+void *mpmc_consumer(void *in)
+{
+    thread_arg *arg = in;
+    mpmc_stress *s = arg->shared;
+    int total = s->producers * STRESS_ITEMS;
+
+    // Last sequence number seen from every producer, to check the order.
+    int last[MAX_THREADS];
+    for (int i = 0; i < MAX_THREADS; i++)
+        last[i] = -1;
+
+    while (atomic_load(&s->consumed) < total)
+    {
+        void *v;
+        if (!mpmc_queue_dequeue(s->q, &v))
+        {
+            backoff();
+            continue;
+        }
+
+        uintptr_t x = (uintptr_t)v - 1;
+        int producer = x / STRESS_ITEMS;
+        int seq = x % STRESS_ITEMS;
+
+        if (seq <= last[producer])
+            error("FAIL: Values from one producer came out of order",
+                  "Expected: FIFO order per producer");
+        last[producer] = seq;
+
+        if (atomic_fetch_add(&s->taken[x], 1) != 0)
+            error("FAIL: Value dequeued twice",
+                  "Expected: Every value to be dequeued once");
+        atomic_fetch_add(&s->consumed, 1);
+    }
+    return NULL;
+}
+
+/**
+ * stress_mpmc_queue() - Runs producers and consumers against a small queue.
+ */
+void stress_mpmc_queue(int producers, int consumers)
+{
+    mpmc_stress s;
+    s.q = mpmc_queue_empty(64);
+    s.producers = producers;
+    atomic_init(&s.consumed, 0);
+    s.taken = calloc((size_t)producers * STRESS_ITEMS, sizeof(atomic_uchar));
+
+    pthread_t threads[2 * MAX_THREADS];
+    thread_arg args[2 * MAX_THREADS];
+    for (int i = 0; i < producers + consumers; i++)
+    {
+        args[i].shared = &s;
+        args[i].id = i < producers ? i : i - producers;
+        pthread_create(&threads[i], NULL, i < producers ? mpmc_producer : mpmc_consumer, &args[i]);
+    }
+    for (int i = 0; i < producers + consumers; i++)
+        pthread_join(threads[i], NULL);
+
+    void *v;
+    if (mpmc_queue_dequeue(s.q, &v))
+        error("FAIL: Queue not empty after all values were consumed",
+              "Expected: Empty queue");
+
+    free(s.taken);
+    mpmc_queue_kill(s.q);
+    fprintf(stderr, "stress_mpmc_queue(%d, %d) - OK\n", producers, consumers);
+}
+
+// ====== WORK-STEALING DEQUE STRESS TEST
+
+typedef struct deque_stress {
+    ws_deque *d;
+    atomic_bool done;
+    atomic_int taken_count;
+    atomic_uchar *taken;
+} deque_stress;
+
+void take_value(deque_stress *s, void *v)
+{
+    uintptr_t x = (uintptr_t)v - 1;
+    if (atomic_fetch_add(&s->taken[x], 1) != 0)
+        error("FAIL: Value taken twice from deque",
+              "Expected: Every value to be taken once");
+    atomic_fetch_add(&s->taken_count, 1);
+}
+
+void *deque_thief(void *in)
+{
+    deque_stress *s = in;
+    void *v;
+
+    // Steal until the owner is done and the deque is drained.
+    while (!atomic_load(&s->done) || atomic_load(&s->taken_count) < STRESS_ITEMS)
+    {
+        if (ws_deque_steal(s->d, &v))
+            take_value(s, v);
+        else
+            backoff();
+    }
+    return NULL;
+}
+
+/**
+ * stress_ws_deque() - Lets thieves steal while the owner pushes and pops.
+ */
+void stress_ws_deque(int thieves)
+{
+    deque_stress s;
+    s.d = ws_deque_empty(2);
+    atomic_init(&s.done, false);
+    atomic_init(&s.taken_count, 0);
+    s.taken = calloc(STRESS_ITEMS, sizeof(atomic_uchar));
+
+    pthread_t threads[MAX_THREADS];
+    for (int i = 0; i < thieves; i++)
+        pthread_create(&threads[i], NULL, deque_thief, &s);
+
+    // The owner pops every third push itself, so both ends are busy.
+    void *v;
+    for (int i = 0; i < STRESS_ITEMS; i++)
+    {
+        ws_deque_push(s.d, (void *)(uintptr_t)(i + 1));
+        if (i % 3 == 0 && ws_deque_pop(s.d, &v))
+            take_value(&s, v);
+    }
+    while (ws_deque_pop(s.d, &v))
+        take_value(&s, v);
+    atomic_store(&s.done, true);
+
+    for (int i = 0; i < thieves; i++)
+        pthread_join(threads[i], NULL);
+
+    if (atomic_load(&s.taken_count) != STRESS_ITEMS)
+        error("FAIL: Values lost in deque",
+              "Expected: Every value to be taken once");
+
+    free(s.taken);
+    ws_deque_kill(s.d);
+    fprintf(stderr, "stress_ws_deque(%d) - OK\n", thieves);
+}
+
+// ====== BENCHMARK
+
+typedef struct bench_arg {
+    mpmc_queue *q;
+    ws_deque *d;
+    int items;
+    atomic_int *left;
+} bench_arg;
+
+void *bench_mpmc_worker(void *in)
+{
+    bench_arg *arg = in;
+    void *v;
+
+    // Every thread both produces and consumes.
+    for (int i = 0; i < arg->items; i++)
+    {
+        while (!mpmc_queue_enqueue(arg->q, (void *)(uintptr_t)(i + 1)))
+            backoff();
+        while (!mpmc_queue_dequeue(arg->q, &v))
+            backoff();
+    }
+    return NULL;
+}
+
+void *bench_deque_thief(void *in)
+{
+    bench_arg *arg = in;
+    void *v;
+
+    while (atomic_load(arg->left) > 0)
+    {
+        if (ws_deque_steal(arg->d, &v))
+            atomic_fetch_sub(arg->left, 1);
+        else
+            backoff();
+    }
+    return NULL;
+}
+
+/**
+ * bench_mpmc_queue() - Returns the number of queue operations per second for a number of threads.
+ */
+double bench_mpmc_queue(int threads)
+{
+    mpmc_queue *q = mpmc_queue_empty(1024);
+    pthread_t tid[MAX_THREADS];
+    bench_arg arg = { q, NULL, BENCH_ITEMS / threads, NULL };
+
+    double start = seconds_now();
+    for (int i = 0; i < threads; i++)
+        pthread_create(&tid[i], NULL, bench_mpmc_worker, &arg);
+    for (int i = 0; i < threads; i++)
+        pthread_join(tid[i], NULL);
+    double elapsed = seconds_now() - start;
+
+    mpmc_queue_kill(q);
+    return 2.0 * arg.items * threads / elapsed;
+}
+
+/**
+ * bench_ws_deque() - Returns the number of values per second pushed by the owner and taken by
+ * the owner and threads - 1 thieves.
+ */
+double bench_ws_deque(int threads)
+{
+    ws_deque *d = ws_deque_empty(1024);
+    atomic_int left;
+    atomic_init(&left, BENCH_ITEMS);
+    pthread_t tid[MAX_THREADS];
+    bench_arg arg = { NULL, d, BENCH_ITEMS, &left };
+
+    double start = seconds_now();
+    for (int i = 0; i < threads - 1; i++)
+        pthread_create(&tid[i], NULL, bench_deque_thief, &arg);
+
+    void *v;
+    for (int i = 0; i < BENCH_ITEMS; i++)
+    {
+        ws_deque_push(d, (void *)(uintptr_t)(i + 1));
+        if (i % 2 == 0 && ws_deque_pop(d, &v))
+            atomic_fetch_sub(&left, 1);
+    }
+    while (atomic_load(&left) > 0)
+    {
+        if (ws_deque_pop(d, &v))
+            atomic_fetch_sub(&left, 1);
+        else
+            backoff();
+    }
+
+    for (int i = 0; i < threads - 1; i++)
+        pthread_join(tid[i], NULL);
+    double elapsed = seconds_now() - start;
+
+    ws_deque_kill(d);
+    return BENCH_ITEMS / elapsed;
+}
+
+int main(int argc, char const *argv[])
+{
+    int max_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (argc > 1)
+        max_threads = atoi(argv[1]);
+    if (max_threads < 1)
+        max_threads = 1;
+    if (max_threads > MAX_THREADS)
+        max_threads = MAX_THREADS;
+
+    // Use at least two threads of each kind so that the stress tests race even on one core.
+    int stress_threads = max_threads < 2 ? 2 : max_threads;
+    stress_mpmc_queue(1, 1);
+    stress_mpmc_queue(stress_threads, stress_threads);
+    stress_ws_deque(1);
+    stress_ws_deque(stress_threads);
+    printf("All test successfully completed\n");
+
+    printf("threads  mpmc_queue ops/s  ws_deque values/s\n");
+    for (int t = 1; t <= max_threads; t++)
+        printf("%7d  %16.0f  %17.0f\n", t, bench_mpmc_queue(t), bench_ws_deque(t));
+
+    return 0;
+}
@@ -1,8 +1,16 @@
+// For mkstemp(), close() and nanosleep().
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <graph.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
 #include <dlist.h>
+#include <mapstream.h>
+#include <graphexport.h>
 /**
  * @brief This is a fast test to test if a graph impletion 
  * manages simple implementations
@@ -190,6 +198,34 @@ void check_neighbors()
     fprintf(stderr, "check_neighbors - OK\n");
 }
 
+/**
+ * The function `delete_an_edge` inserts an edge between two nodes, deletes it again and checks that
+ * the first node has no neighbors left. Deleting the edge a second time must do nothing.
+ */
+void delete_an_edge()
+{
+    graph *g = new_graph_with_x_amount_of_nodes(2);
+
+    node *n1 = graph_find_node(g,"nod1");
+    node *n2 = graph_find_node(g,"nod2");
+
+    graph_insert_edge(g,n1,n2);
+    graph_delete_edge(g,n1,n2);
+    graph_delete_edge(g,n1,n2);
+
+    dlist *neighbors = graph_neighbours(g,n1);
+
+    if(!dlist_is_end(neighbors,dlist_first(neighbors)))
+    {
+        error(  "FAIL: found a neighbor after the edge was deleted",
+                "GOT: The deleted edge in the neighbor list");
+    }
+
+    dlist_kill(neighbors);
+    graph_kill(g);
+    fprintf(stderr, "delete_an_edge - OK\n");
+}
+
 /**
  * The function `new_node_is_seen` creates a new graph with one node, checks if the node is marked as
  * seen, and reports an error if it is.
@@ -297,6 +333,344 @@ void check_if_reset_seen_works()
     fprintf(stderr,"check_if_reset_seen_works - OK\n");
 }
 
+/**
+ * The function `graph_returns_all_memory` builds a graph through a counting allocator, grows it from
+ * a few nodes to several thousand, inserts and deletes edges and marks nodes as seen, and checks that
+ * killing the graph gives back every byte it took from the allocator.
+ */
+void graph_returns_all_memory()
+{
+    alloc_counter *c = alloc_counter_create(NULL);
+    graph *g = graph_empty_alloc(4, alloc_counter_allocator(c));
+
+    char str[100];
+    node *prev = NULL;
+    for (int j = 1; j <= 5000; ++j)
+    {
+        sprintf(str,"nod%d",j);
+        g = graph_insert_node(g,str);
+        node *n = graph_find_node(g,str);
+        if (prev != NULL)
+        {
+            g = graph_insert_edge(g,prev,n);
+        }
+        if (j % 3 == 0)
+        {
+            g = graph_delete_edge(g,prev,n);
+            g = graph_node_set_seen(g,n,true);
+        }
+        prev = n;
+    }
+    g = graph_reset_seen(g);
+
+    if (alloc_counter_bytes(c) == 0)
+    {
+        error(  "FAIL: the graph took no memory from its allocator",
+                "GOT: No bytes in use");
+    }
+    graph_kill(g);
+    if (alloc_counter_bytes(c) != 0)
+    {
+        fprintf(stderr,"%zu bytes\n",alloc_counter_bytes(c));
+        error(  "FAIL: killing the graph did not give back all memory to its allocator",
+                "GOT: Bytes still in use");
+    }
+
+    alloc_counter_kill(c);
+    fprintf(stderr,"graph_returns_all_memory - OK\n");
+}
+
+/**
+ * The function `make_temp_file` creates an empty file from the template `path`, which must end in
+ * "XXXXXX", and writes its name to `path`.
+ */
+void make_temp_file(char *path)
+{
+    int fd = mkstemp(path);
+    if (fd < 0)
+    {
+        error(  "FAIL: could not create a temporary file",
+                "GOT: mkstemp failed");
+    }
+    close(fd);
+}
+
+/**
+ * The function `wait_for_stream` waits until a map stream has stopped loading and returns what a
+ * query sees then.
+ */
+map_stream_view wait_for_stream(map_stream *s)
+{
+    struct timespec ts = { 0, 10000000L };
+    map_stream_view view;
+
+    for (;;)
+    {
+        map_stream_acquire(s, &view);
+        map_stream_release(s);
+        if (!view.loading)
+        {
+            return view;
+        }
+        nanosleep(&ts, NULL);
+    }
+}
+
+/**
+ * The function `stream_without_count_is_wrong_format` streams an empty map file and a map file with
+ * only comments, and checks that both end with the format error of a missing count line rather than
+ * as an empty map.
+ */
+void stream_without_count_is_wrong_format()
+{
+    const char *contents[] = { "", "# Only a comment\n\n" };
+
+    for (int i = 0; i < 2; ++i)
+    {
+        char path[] = "/tmp/test_imp_XXXXXX";
+        make_temp_file(path);
+        FILE *f = fopen(path, "w");
+        fputs(contents[i], f);
+        fclose(f);
+
+        map_stream *s = map_stream_start(path);
+        if (s == NULL)
+        {
+            error(  "FAIL: could not start streaming the map file",
+                    "GOT: map_stream_start returned NULL");
+        }
+        map_stream_view view = wait_for_stream(s);
+        if (view.status != MAP_SCAN_NO_COUNT || view.g != NULL)
+        {
+            error(  "FAIL: a map file without a count line was loaded as a map",
+                    "GOT: Status is not MAP_SCAN_NO_COUNT");
+        }
+
+        map_stream_stop(s);
+        remove(path);
+    }
+    fprintf(stderr,"stream_without_count_is_wrong_format - OK\n");
+}
+
+#define EXPORT_NODES 7
+
+/**
+ * The function `new_export_graph` creates a graph with the nodes "nod1" to "nod6" and a node whose
+ * label has a quote and a backslash, at the indices 0 to 6, and a few edges between them. The edge
+ * from index i to index j is in the graph if `edge[i][j]` is set.
+ */
+graph *new_export_graph(bool edge[EXPORT_NODES][EXPORT_NODES])
+{
+    const int pairs[][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 }, { 2, 0 }, { 3, 4 }, { 4, 6 }, { 6, 0 }, { 6, 5 } };
+    graph *g = new_graph_with_x_amount_of_nodes(EXPORT_NODES - 1);
+    g = graph_insert_node(g, "a\"b\\c");
+
+    memset(edge, 0, EXPORT_NODES * sizeof(edge[0]));
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); ++i)
+    {
+        g = graph_insert_edge(g, graph_node_at(g, pairs[i][0]), graph_node_at(g, pairs[i][1]));
+        edge[pairs[i][0]][pairs[i][1]] = true;
+    }
+    return g;
+}
+
+/**
+ * The function `edges_from_range` counts the edges in `edge` from the indices `first` to `last`-1.
+ */
+int edges_from_range(bool edge[EXPORT_NODES][EXPORT_NODES], int first, int last)
+{
+    int n = 0;
+    for (int i = first; i < last; ++i)
+    {
+        for (int j = 0; j < EXPORT_NODES; ++j)
+        {
+            n += edge[i][j];
+        }
+    }
+    return n;
+}
+
+/**
+ * The function `map_export_matches` reads the map file at `path` back and checks that it has the
+ * edges of `g` from the indices `first` to `last`-1, each once, and a count line that matches.
+ */
+void map_export_matches(const graph *g, bool edge[EXPORT_NODES][EXPORT_NODES], int first, int last,
+                        const char *path)
+{
+    bool read[EXPORT_NODES][EXPORT_NODES] = { { false } };
+    char src[41];
+    char dest[41];
+    int count = -1;
+    int n = 0;
+
+    FILE *f = fopen(path, "r");
+    if (f == NULL || fscanf(f, "%d", &count) != 1 || count != edges_from_range(edge, first, last))
+    {
+        error(  "FAIL: the count line of an exported map is not the number of edges in the range",
+                "GOT: Another count, or no count");
+    }
+    while (fscanf(f, "%40s %40s", src, dest) == 2)
+    {
+        node *s = graph_find_node(g, src);
+        node *d = graph_find_node(g, dest);
+        int i = (s == NULL) ? -1 : graph_node_index(g, s);
+        int j = (d == NULL) ? -1 : graph_node_index(g, d);
+        if (i < first || i >= last || j < 0 || !edge[i][j] || read[i][j])
+        {
+            fprintf(stderr,"%s %s\n",src,dest);
+            error(  "FAIL: an exported map has a line that is not an edge from the range",
+                    "GOT: Another edge, or an edge twice");
+        }
+        read[i][j] = true;
+        n += 1;
+    }
+    fclose(f);
+
+    if (n != count)
+    {
+        error(  "FAIL: an exported map does not have as many edge lines as its count line states",
+                "GOT: Another number of lines");
+    }
+}
+
+/**
+ * The function `graph_export_map_round_trip` exports a range of the nodes of a graph, and a range
+ * that reaches outside the graph, as map files, and reads them back. The second range must be
+ * clipped to all nodes.
+ */
+void graph_export_map_round_trip()
+{
+    bool edge[EXPORT_NODES][EXPORT_NODES];
+    graph *g = new_export_graph(edge);
+    char path[] = "/tmp/test_imp_XXXXXX";
+    make_temp_file(path);
+
+    if (graph_export_file(g, GRAPH_EXPORT_MAP, 1, 5, path) != 0)
+    {
+        error(  "FAIL: could not export a range of a graph as a map",
+                "GOT: graph_export_file failed");
+    }
+    map_export_matches(g, edge, 1, 5, path);
+
+    if (graph_export_file(g, GRAPH_EXPORT_MAP, -3, 100, path) != 0)
+    {
+        error(  "FAIL: could not export a range that reaches outside the graph",
+                "GOT: graph_export_file failed");
+    }
+    map_export_matches(g, edge, 0, EXPORT_NODES, path);
+
+    remove(path);
+    graph_kill(g);
+    fprintf(stderr,"graph_export_map_round_trip - OK\n");
+}
+
+/**
+ * The function `graph_export_dot_ids` exports a graph as a Graphviz digraph and checks that the
+ * nodes and edges are written as quoted ids, with the quote and the backslash of a label escaped.
+ */
+void graph_export_dot_ids()
+{
+    bool edge[EXPORT_NODES][EXPORT_NODES];
+    graph *g = new_export_graph(edge);
+    char path[] = "/tmp/test_imp_XXXXXX";
+    make_temp_file(path);
+    char text[1000];
+
+    FILE *f = NULL;
+    size_t len = 0;
+    if (graph_export_file(g, GRAPH_EXPORT_DOT, 0, EXPORT_NODES, path) == 0 &&
+        (f = fopen(path, "r")) != NULL)
+    {
+        len = fread(text, 1, sizeof(text) - 1, f);
+        fclose(f);
+    }
+    text[len] = '\0';
+
+    if (strncmp(text, "digraph map {\n", 14) != 0 || len < 2 || strcmp(text + len - 2, "}\n") != 0 ||
+        strstr(text, "\t\"nod6\";\n") == NULL ||
+        strstr(text, "\t\"nod1\" -> \"nod2\";\n") == NULL ||
+        strstr(text, "\t\"a\\\"b\\\\c\" -> \"nod1\";\n") == NULL)
+    {
+        fprintf(stderr,"%s",text);
+        error(  "FAIL: an exported digraph does not have the nodes and edges as quoted ids",
+                "GOT: Another text");
+    }
+
+    remove(path);
+    graph_kill(g);
+    fprintf(stderr,"graph_export_dot_ids - OK\n");
+}
+
+/**
+ * The function `graph_export_binary_edges` exports a range of the nodes of a graph as a binary edge
+ * list and checks the header, that the labels of all nodes follow it in index order, and that the
+ * index pairs are the edges from the range.
+ */
+void graph_export_binary_edges()
+{
+    bool edge[EXPORT_NODES][EXPORT_NODES];
+    bool read[EXPORT_NODES][EXPORT_NODES] = { { false } };
+    graph *g = new_export_graph(edge);
+    char path[] = "/tmp/test_imp_XXXXXX";
+    make_temp_file(path);
+    int first = 2;
+    int last = EXPORT_NODES;
+
+    char magic[8];
+    uint32_t header[4];
+    FILE *f = NULL;
+    if (graph_export_file(g, GRAPH_EXPORT_EDGES, first, last, path) != 0 ||
+        (f = fopen(path, "rb")) == NULL ||
+        fread(magic, 1, 8, f) != 8 || fread(header, sizeof(uint32_t), 4, f) != 4 ||
+        memcmp(magic, GRAPH_EXPORT_MAGIC, 8) != 0 || header[0] != GRAPH_EXPORT_BYTE_ORDER ||
+        header[1] != GRAPH_EXPORT_VERSION || header[2] != EXPORT_NODES ||
+        header[3] != (uint32_t)edges_from_range(edge, first, last))
+    {
+        error(  "FAIL: the header of a binary edge list is wrong",
+                "GOT: Another magic, byte order, version or count");
+    }
+
+    for (int i = 0; i < EXPORT_NODES; ++i)
+    {
+        char label[41];
+        int len = 0;
+        int c;
+        while ((c = fgetc(f)) > 0 && len < 40)
+        {
+            label[len++] = c;
+        }
+        label[len] = '\0';
+        if (c != '\0' || strcmp(label, graph_node_label(g, graph_node_at(g, i), NULL)) != 0)
+        {
+            error(  "FAIL: the labels of a binary edge list are not those of the nodes in index order",
+                    "GOT: Another label");
+        }
+    }
+
+    uint32_t pair[2];
+    for (uint32_t k = 0; k < header[3]; ++k)
+    {
+        if (fread(pair, sizeof(uint32_t), 2, f) != 2 || pair[0] < (uint32_t)first ||
+            pair[0] >= (uint32_t)last || pair[1] >= EXPORT_NODES || !edge[pair[0]][pair[1]] ||
+            read[pair[0]][pair[1]])
+        {
+            error(  "FAIL: a binary edge list has a pair that is not an edge from the range",
+                    "GOT: Another pair, or a pair twice");
+        }
+        read[pair[0]][pair[1]] = true;
+    }
+    if (fgetc(f) != EOF)
+    {
+        error(  "FAIL: a binary edge list has more bytes after its edges",
+                "GOT: More bytes");
+    }
+    fclose(f);
+
+    remove(path);
+    graph_kill(g);
+    fprintf(stderr,"graph_export_binary_edges - OK\n");
+}
+
 
 
 int main(void)
@@ -308,10 +682,16 @@ int main(void)
     get_node_from_graph();
     get_second_node_from_graph();
     check_neighbors();
+    delete_an_edge();
     new_node_is_seen();
     node_set_to_seen();
     node_set_to_seen_then_not_to_seen();
     check_if_reset_seen_works();
+    graph_returns_all_memory();
+    stream_without_count_is_wrong_format();
+    graph_export_map_round_trip();
+    graph_export_dot_ids();
+    graph_export_binary_edges();
     printf("All test successfully completed\n");
     return 0; 
 }
\ No newline at end of file
@@ -0,0 +1,1224 @@
+// For mkstemp() and close().
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <dlist.h>
+#include <bitset.h>
+#include <intern.h>
+#include <table.h>
+#include <mapline.h>
+#include <mapscan.h>
+#include <array_typed.h>
+#include <array_1d.h>
+#include <container_typed.h>
+#include <mapimage.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+/**
+ * @brief Tests of the data structures in lib that the graph
+ * implementations are built on. Each test compares a data structure
+ * with a simple model of it and stops at the first difference.
+ *
+ * Usage: ./test_lib
+ */
+#define MAX_SIZE 100
+#define BITSET_BITS 1000
+#define LABEL_LENGTH 12
+#define LABELS_PER_LENGTH 100
+#define TABLE_KEYS 500
+#define MAP_LINES 400
+#define MAP_LABELS 300
+#define MAP_EDGES 3000
+
+// State of the pseudo-random numbers of the tests, reset by each test.
+static unsigned long long random_state;
+
+void error(const char* FAIL,const char* GOT)
+{
+    fprintf(stderr,"%s\n",FAIL);
+    fprintf(stderr,"%s\n",GOT);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * The function `dlist_matches` walks the list `l` and checks that it holds the `n` values in
+ * `model`, in order.
+ */
+void dlist_matches(const dlist *l, const intptr_t *model, int n, const char *test)
+{
+    dlist_pos p = dlist_first(l);
+
+    for (int i = 0; i < n; i++)
+    {
+        if (dlist_is_end(l,p) || (intptr_t)dlist_inspect(l,p) != model[i])
+        {
+            fprintf(stderr,"%s: value %d\n",test,i);
+            error(  "FAIL: the list does not hold the expected values",
+                    "GOT: A missing or different value");
+        }
+        p = dlist_next(l,p);
+    }
+    if (!dlist_is_end(l,p) || dlist_is_empty(l) != (n == 0))
+    {
+        fprintf(stderr,"%s: %d values\n",test,n);
+        error(  "FAIL: the list does not end after the expected values",
+                "GOT: More values, or the wrong empty status");
+    }
+}
+
+/**
+ * The function `dlist_pos_at` returns the position of value `i` in the list `l`.
+ */
+dlist_pos dlist_pos_at(const dlist *l, int i)
+{
+    dlist_pos p = dlist_first(l);
+
+    while (i-- > 0)
+    {
+        p = dlist_next(l,p);
+    }
+    return p;
+}
+
+/**
+ * The function `unrolled_dlist_splits_and_merges` fills an unrolled list past the six values of a
+ * chunk, at the end and in the middle of full chunks so the chunks are split, then removes values
+ * so the chunks are merged again, and checks the values after every step.
+ */
+void unrolled_dlist_splits_and_merges()
+{
+    dlist *l = dlist_empty_unrolled(NULL,NULL);
+    intptr_t model[MAX_SIZE];
+    int n = 0;
+
+    // Appending fills the first chunk, the seventh value splits it.
+    for (intptr_t v = 1; v <= 7; v++)
+    {
+        dlist_insert(l,(void *)v,dlist_pos_at(l,n));
+        model[n++] = v;
+        dlist_matches(l,model,n,"append");
+    }
+
+    // Inserting into every index of a full chunk, before and after the split point.
+    for (int i = 0; i <= 6; i++)
+    {
+        dlist *m = dlist_empty_unrolled(NULL,NULL);
+        intptr_t full[7];
+        for (intptr_t v = 0; v < 6; v++)
+        {
+            dlist_insert(m,(void *)v,dlist_pos_at(m,v));
+        }
+        for (int j = 0, v = 0; j < 7; j++)
+        {
+            full[j] = (j == i) ? 100 : v++;
+        }
+        dlist_pos p = dlist_insert(m,(void *)100,dlist_pos_at(m,i));
+        if ((intptr_t)dlist_inspect(m,p) != 100)
+        {
+            error(  "FAIL: dlist_insert did not return the position of the new value",
+                    "GOT: The position of another value");
+        }
+        dlist_matches(m,full,7,"split");
+        dlist_kill(m);
+    }
+
+    // Grow the list to many chunks, inserting in the middle.
+    for (intptr_t v = 8; n < 60; v++)
+    {
+        int i = (int)(v * 7 % (n + 1));
+        dlist_insert(l,(void *)v,dlist_pos_at(l,i));
+        for (int j = n; j > i; j--)
+        {
+            model[j] = model[j - 1];
+        }
+        model[i] = v;
+        n++;
+        dlist_matches(l,model,n,"grow");
+    }
+
+    // Remove from the middle so neighbouring chunks are merged.
+    while (n > 10)
+    {
+        int i = (n % 2 == 0) ? n / 2 : n / 3;
+        dlist_pos p = dlist_remove(l,dlist_pos_at(l,i));
+        for (int j = i; j < n - 1; j++)
+        {
+            model[j] = model[j + 1];
+        }
+        n--;
+        if ((intptr_t)dlist_inspect(l,p) != model[i])
+        {
+            error(  "FAIL: dlist_remove did not return the position after the removed value",
+                    "GOT: The position of another value");
+        }
+        dlist_matches(l,model,n,"merge");
+    }
+    dlist_kill(l);
+    fprintf(stderr, "unrolled_dlist_splits_and_merges - OK\n");
+}
+
+/**
+ * The function `unrolled_dlist_empties_the_tail` removes the last value of a list until the tail
+ * chunk is empty, checks that the end of the list is still found and that values appended after
+ * that end up in order, and finally empties the whole list from the front.
+ */
+void unrolled_dlist_empties_the_tail()
+{
+    dlist *l = dlist_empty_unrolled(NULL,NULL);
+    intptr_t model[MAX_SIZE];
+    int n = 0;
+
+    // Appending splits the chunks into 3, 3, 3 and 4 values.
+    for (intptr_t v = 0; v < 13; v++)
+    {
+        dlist_insert(l,(void *)v,dlist_pos_at(l,n));
+        model[n++] = v;
+    }
+
+    // Removing the last value empties the tail chunk on the fourth round.
+    for (int k = 0; k < 8; k++)
+    {
+        dlist_pos p = dlist_remove(l,dlist_pos_at(l,n - 1));
+        n--;
+        if (!dlist_is_end(l,p))
+        {
+            error(  "FAIL: removing the last value did not return the end",
+                    "GOT: A position before the end");
+        }
+        dlist_matches(l,model,n,"empty tail");
+
+        // Appending at the returned end reuses the empty chunk.
+        dlist_insert(l,(void *)(intptr_t)(50 + k),p);
+        model[n++] = 50 + k;
+        dlist_matches(l,model,n,"append to empty tail");
+        dlist_remove(l,dlist_pos_at(l,n - 1));
+        n--;
+    }
+
+    // Empty the list from the front, the first chunk takes in the next ones.
+    while (n > 0)
+    {
+        dlist_remove(l,dlist_first(l));
+        for (int j = 0; j < n - 1; j++)
+        {
+            model[j] = model[j + 1];
+        }
+        n--;
+        dlist_matches(l,model,n,"remove first");
+    }
+    dlist_insert(l,(void *)1,dlist_first(l));
+    model[n++] = 1;
+    dlist_matches(l,model,n,"reuse");
+
+    dlist_kill(l);
+    fprintf(stderr, "unrolled_dlist_empties_the_tail - OK\n");
+}
+
+/**
+ * The function `next_random` returns a pseudo-random number below `n`.
+ */
+int next_random(int n)
+{
+    random_state = random_state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (int)((random_state >> 33) % (unsigned long long)n);
+}
+
+/**
+ * The function `bitset_matches` checks that the bitset `b` holds the bits in `model`, through
+ * bitset_test, bitset_next and bitset_count.
+ */
+void bitset_matches(const bitset *b, const bool *model, const char *test)
+{
+    int count = 0;
+    int next = bitset_next(b,-1);
+
+    for (int i = 0; i < BITSET_BITS; i++)
+    {
+        if (bitset_test(b,i) != model[i] || (model[i] && next != i))
+        {
+            fprintf(stderr,"%s with %s: bit %d\n",test,bitset_implementation(),i);
+            error(  "FAIL: the bitset does not hold the expected bits",
+                    "GOT: A different bit");
+        }
+        if (model[i])
+        {
+            count++;
+            next = bitset_next(b,i);
+        }
+    }
+    if (next != BITSET_BITS || bitset_count(b) != count)
+    {
+        fprintf(stderr,"%s with %s: %d bits\n",test,bitset_implementation(),count);
+        error(  "FAIL: bitset_count or bitset_next do not match the bits",
+                "GOT: A different count, or a bit past the end");
+    }
+}
+
+/**
+ * The function `random_bitset` sets about every third bit of `b` and of `model`.
+ */
+void random_bitset(bitset *b, bool *model)
+{
+    for (int i = 0; i < BITSET_BITS; i++)
+    {
+        model[i] = next_random(3) == 0;
+        if (model[i])
+        {
+            bitset_set(b,i);
+        }
+        else
+        {
+            bitset_clear(b,i);
+        }
+    }
+}
+
+/**
+ * The function `bitset_bulk_operations` runs bitset_or, bitset_and, bitset_andnot and bitset_count
+ * with the given implementation. The bitsets have the same size but a different number of words,
+ * since one was created larger and shrunk and one was created smaller and grown.
+ */
+void bitset_bulk_operations(const char *implementation)
+{
+    if (!bitset_use_implementation(implementation))
+    {
+        fprintf(stderr, "bitset_bulk_operations with %s - not supported, skipped\n",
+                implementation);
+        return;
+    }
+    random_state = 1;
+
+    bitset *b[3];
+    b[0] = bitset_empty(BITSET_BITS);
+    b[1] = bitset_empty(4 * BITSET_BITS);
+    bitset_set(b[1],4 * BITSET_BITS - 1);
+    bitset_resize(b[1],BITSET_BITS);
+    b[2] = bitset_empty(BITSET_BITS / 10);
+    bitset_resize(b[2],BITSET_BITS);
+
+    bool model[3][BITSET_BITS];
+    for (int round = 0; round < 20; round++)
+    {
+        int d = next_random(3);
+        int s = (d + 1 + next_random(2)) % 3;
+        random_bitset(b[d],model[d]);
+        random_bitset(b[s],model[s]);
+        for (int i = 0; i < BITSET_BITS; i++)
+        {
+            switch (round % 3)
+            {
+            case 0:
+                model[d][i] = model[d][i] || model[s][i];
+                break;
+            case 1:
+                model[d][i] = model[d][i] && model[s][i];
+                break;
+            default:
+                model[d][i] = model[d][i] && !model[s][i];
+                break;
+            }
+        }
+        switch (round % 3)
+        {
+        case 0:
+            bitset_or(b[d],b[s]);
+            break;
+        case 1:
+            bitset_and(b[d],b[s]);
+            break;
+        default:
+            bitset_andnot(b[d],b[s]);
+            break;
+        }
+        bitset_matches(b[d],model[d],"bulk");
+        bitset_matches(b[s],model[s],"bulk source");
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        bitset_kill(b[i]);
+    }
+    fprintf(stderr, "bitset_bulk_operations with %s - OK\n", implementation);
+}
+
+/**
+ * The function `make_label` writes label number `k` of length `len` to `label`: the number in base 26
+ * with the letters A to Z, padded with A in front.
+ */
+void make_label(char *label, int k, int len)
+{
+    for (int i = len - 1; i >= 0; i--)
+    {
+        label[i] = 'A' + k % 26;
+        k /= 26;
+    }
+    label[len] = '\0';
+}
+
+/**
+ * The function `intern_label_count` returns the number of labels of length `len` the intern tests
+ * use.
+ */
+int intern_label_count(int len)
+{
+    return (len == 1) ? 26 : LABELS_PER_LENGTH;
+}
+
+/**
+ * The function `intern_packed_and_long_labels` interns labels of 1 to 12 characters, both packed
+ * labels of up to 7 characters and long labels of 8 or more, so that the ids, the characters and
+ * the index grow many times, or once up front when `reserve` is large. It checks the ids, the
+ * interned copies and the lookups after all insertions, also of labels that differ only in the
+ * eighth character.
+ */
+void intern_packed_and_long_labels(int reserve)
+{
+    intern *in = intern_empty(NULL);
+    char label[LABEL_LENGTH + 2];
+    int id = 0;
+
+    intern_reserve(in,reserve);
+    for (int len = 1; len <= LABEL_LENGTH; len++)
+    {
+        for (int k = 0; k < intern_label_count(len); k++)
+        {
+            make_label(label,k,len);
+            if (intern_insert(in,label) != id++)
+            {
+                fprintf(stderr,"label %s\n",label);
+                error(  "FAIL: a new label did not get the next id",
+                        "GOT: Another id");
+            }
+        }
+    }
+
+    // Every label is found again, through all functions.
+    id = 0;
+    for (int len = 1; len <= LABEL_LENGTH; len++)
+    {
+        for (int k = 0; k < intern_label_count(len); k++, id++)
+        {
+            make_label(label,k,len);
+            if (intern_insert(in,label) != id || intern_lookup(in,label) != id ||
+                intern_lookup_n(in,label,len) != id || intern_length(in,id) != len ||
+                strcmp(intern_string(in,id),label) != 0)
+            {
+                fprintf(stderr,"label %s\n",label);
+                error(  "FAIL: an interned label was not found again",
+                        "GOT: A different id, length or copy");
+            }
+        }
+    }
+
+    // A label of 7 characters, and the same one with an eighth character.
+    make_label(label,LABELS_PER_LENGTH,7);
+    int packed = intern_insert(in,label);
+    strcat(label,"B");
+    int long_id = intern_insert(in,label);
+    label[7] = 'C';
+    if (packed != id || long_id != id + 1 || intern_lookup(in,label) != -1 ||
+        intern_lookup_n(in,label,7) != packed || intern_length(in,long_id) != 8)
+    {
+        error(  "FAIL: labels of 7 and 8 characters with the same start were mixed up",
+                "GOT: The same id, or a wrong lookup");
+    }
+    if (intern_size(in) != id + 2)
+    {
+        error(  "FAIL: intern_size does not count the labels",
+                "GOT: Another size");
+    }
+
+    intern_kill(in);
+    fprintf(stderr, "intern_packed_and_long_labels reserving %d - OK\n", reserve);
+}
+
+/**
+ * The function `intern_label_with_nul` interns labels given by length that have a NUL among their
+ * characters, and checks that they are not mixed up with the labels that end at the NUL.
+ */
+void intern_label_with_nul()
+{
+    intern *in = intern_empty(NULL);
+
+    int a = intern_insert(in,"A");
+    int a_nul = intern_insert_n(in,"A\0",2);
+    int a_nul_b = intern_insert_n(in,"A\0B",3);
+    int nul = intern_insert_n(in,"\0",1);
+    int empty = intern_insert(in,"");
+    if (a == a_nul || a_nul == a_nul_b || nul == empty || intern_size(in) != 5)
+    {
+        error(  "FAIL: a label with a NUL got the id of the label that ends at the NUL",
+                "GOT: The same id");
+    }
+    if (intern_lookup_n(in,"A\0",2) != a_nul || intern_lookup(in,"A") != a ||
+        intern_lookup_n(in,"A\0C",3) != -1 || intern_length(in,a_nul_b) != 3 ||
+        memcmp(intern_string(in,a_nul_b),"A\0B",4) != 0 || intern_length(in,empty) != 0)
+    {
+        error(  "FAIL: a label with a NUL was not found again",
+                "GOT: A different id, length or copy");
+    }
+
+    intern_kill(in);
+    fprintf(stderr, "intern_label_with_nul - OK\n");
+}
+
+/**
+ * The function `clustered_hash` hashes the integer key `k` so that the keys 100*h to 100*h+99 all
+ * have home slot h, as long as the table has more than h slots. The upper half still tells the
+ * keys apart.
+ */
+unsigned long long clustered_hash(const void *key)
+{
+    unsigned long long k = (unsigned long long)TABLE_KEY_INT(key);
+
+    return (k << 32) | (k / 100);
+}
+
+/**
+ * The function `grouped_hash` hashes the integer key `k` so that the keys that differ only in the
+ * three lowest bits have the same home slot, and the groups have neighbouring home slots.
+ */
+unsigned long long grouped_hash(const void *key)
+{
+    unsigned long long k = (unsigned long long)TABLE_KEY_INT(key);
+
+    return (k << 32) | (k / 8);
+}
+
+// Number of calls to count_free.
+static int free_count;
+
+/**
+ * The function `count_free` is a free function that only counts its calls.
+ */
+void count_free(void *p)
+{
+    (void)p;
+    free_count++;
+}
+
+/**
+ * The function `table_matches` checks that the table `t` holds the keys 0 to `n`-1 for which
+ * `present` is true, each with the value `values[key]`.
+ */
+void table_matches(const table *t, const bool *present, const intptr_t *values, int n,
+                   const char *test)
+{
+    int size = 0;
+
+    for (int k = 0; k < n; k++)
+    {
+        void *key = TABLE_INT_KEY(k);
+        if (table_has_key(t,key) != present[k] ||
+            (present[k] && (intptr_t)table_lookup(t,key) != values[k]))
+        {
+            fprintf(stderr,"%s: key %d\n",test,k);
+            error(  "FAIL: the table does not hold the expected pairs",
+                    "GOT: A missing, extra or different pair");
+        }
+        size += present[k];
+    }
+    if (table_size(t) != size || table_is_empty(t) != (size == 0))
+    {
+        fprintf(stderr,"%s: %d pairs\n",test,size);
+        error(  "FAIL: table_size does not count the pairs",
+                "GOT: Another size");
+    }
+}
+
+/**
+ * The function `table_displacement_and_wraparound` fills the last slots of a table with keys that
+ * share home slots, so that the entries are displaced past the end of the slots and wrap around to
+ * the first ones. It then removes keys from the middle of the cluster, which shifts the entries
+ * after them back across the end of the slots.
+ */
+void table_displacement_and_wraparound()
+{
+    table *t = table_empty(clustered_hash,table_compare_int,NULL,count_free);
+    bool present[1600] = { false };
+    intptr_t values[1600];
+
+    // Five keys at home in slot 13, four in slot 15 and three in slot 0, in the 16 slots.
+    int keys[] = { 1300, 1500, 1301, 0, 1501, 1302, 1, 1303, 1502, 2, 1304, 1503 };
+    int n_keys = sizeof(keys) / sizeof(keys[0]);
+    for (int i = 0; i < n_keys; i++)
+    {
+        table_insert(t,TABLE_INT_KEY(keys[i]),(void *)(intptr_t)(i + 1));
+        present[keys[i]] = true;
+        values[keys[i]] = i + 1;
+        table_matches(t,present,values,1600,"displace");
+    }
+
+    // Replacing a value frees the old one.
+    free_count = 0;
+    table_insert(t,TABLE_INT_KEY(1502),(void *)(intptr_t)100);
+    values[1502] = 100;
+    table_matches(t,present,values,1600,"replace");
+    if (free_count != 1)
+    {
+        error(  "FAIL: replacing a value did not free the old value once",
+                "GOT: Another number of calls to the free function");
+    }
+
+    // Remove from the middle and the start of the cluster, and keys that are not there.
+    int removed[] = { 1302, 1500, 1601, 0, 1300, 1304, 1503, 3 };
+    int n_removed = sizeof(removed) / sizeof(removed[0]);
+    free_count = 0;
+    for (int i = 0; i < n_removed; i++)
+    {
+        table_remove(t,TABLE_INT_KEY(removed[i]));
+        if (removed[i] < 1600)
+        {
+            present[removed[i]] = false;
+        }
+        table_matches(t,present,values,1600,"shift back");
+    }
+    if (free_count != 6)
+    {
+        error(  "FAIL: removing did not free the values of the removed keys once",
+                "GOT: Another number of calls to the free function");
+    }
+
+    table_kill(t);
+    fprintf(stderr, "table_displacement_and_wraparound - OK\n");
+}
+
+/**
+ * The function `table_random_operations` inserts and removes keys in a pseudo-random order in a
+ * table whose keys collide in groups of eight, so that it grows past several sizes while the
+ * entries are displaced and shifted back. With `reserve` the table is sized up front.
+ */
+void table_random_operations(int reserve)
+{
+    table *t = table_empty(grouped_hash,table_compare_int,NULL,NULL);
+    bool present[TABLE_KEYS] = { false };
+    intptr_t values[TABLE_KEYS];
+
+    random_state = 2;
+    table_reserve(t,reserve);
+    for (int round = 0; round < 20 * TABLE_KEYS; round++)
+    {
+        // Keys that differ only in the three lowest bits collide.
+        int k = next_random(TABLE_KEYS / 8) * 8 + next_random(8);
+        if (next_random(3) == 0)
+        {
+            table_remove(t,TABLE_INT_KEY(k));
+            present[k] = false;
+        }
+        else
+        {
+            table_insert(t,TABLE_INT_KEY(k),(void *)(intptr_t)round);
+            present[k] = true;
+            values[k] = round;
+        }
+        if (round % 100 == 0)
+        {
+            table_matches(t,present,values,TABLE_KEYS,"random");
+        }
+    }
+    table_matches(t,present,values,TABLE_KEYS,"random");
+
+    table_kill(t);
+    fprintf(stderr, "table_random_operations reserving %d - OK\n", reserve);
+}
+
+/**
+ * The function `append` appends the string `str` to the buffer `buf` of `len` bytes and returns
+ * the new length. The buffer must have room.
+ */
+size_t append(char *buf, size_t len, const char *str)
+{
+    size_t n = strlen(str);
+
+    memcpy(buf + len, str, n);
+    return len + n;
+}
+
+/**
+ * The function `random_map_line` writes a pseudo-random line of a map file to `line`, without
+ * the newline: blank lines, comments, counts, invalid lines and edges with fields, comments, odd
+ * whitespace and labels long enough to cross the 64-byte blocks of the lexer.
+ */
+void random_map_line(char *line)
+{
+    static const char *const spaces[] = { " ", "\t", "  ", " \r", "\v", "\f " };
+    static const char *const lines[] = {
+        "", "   ", "# comment", "  \t# comment with # inside", "42", "-7", "+12",
+        "notanumber", "A B", "A#1 B#2", "A B 3 # fields and a comment", "A B#", "x y #",
+        "1 2 3 4 5 6 7 8 9 10 11", "#A B", "A\tB\r",
+    };
+    char label[80];
+    size_t len = 0;
+
+    line[0] = '\0';
+    if (next_random(4) != 0)
+    {
+        strcpy(line,lines[next_random(sizeof(lines) / sizeof(lines[0]))]);
+        return;
+    }
+    // An edge with labels of up to 70 characters.
+    for (int i = 0; i < 2 + next_random(3); i++)
+    {
+        len = append(line,len,spaces[next_random(sizeof(spaces) / sizeof(spaces[0]))]);
+        make_label(label,next_random(1000),1 + next_random(70));
+        len = append(line,len,label);
+    }
+    if (next_random(2) == 0)
+    {
+        len = append(line,len," # trailing");
+    }
+    line[len] = '\0';
+}
+
+/**
+ * The function `reference_line` splits the line `line` of `len` bytes into tokens byte by byte, as
+ * the lexer is documented to, and sets the kind of the line.
+ */
+void reference_line(const char *line, size_t len, map_line *l)
+{
+    bool comment = false;
+    size_t i = 0;
+
+    l->n_tokens = 0;
+    while (i < len && !comment)
+    {
+        if (strchr(" \t\v\f\r",line[i]) != NULL)
+        {
+            i++;
+            continue;
+        }
+        if (line[i] == '#')
+        {
+            comment = true;
+            break;
+        }
+        size_t start = i;
+        while (i < len && strchr(" \t\v\f\r",line[i]) == NULL)
+        {
+            i++;
+        }
+        if (l->n_tokens < MAP_LINE_MAX_TOKENS)
+        {
+            l->tokens[l->n_tokens].s = line + start;
+            l->tokens[l->n_tokens].len = i - start;
+            l->n_tokens++;
+        }
+    }
+    if (l->n_tokens == 0)
+    {
+        l->kind = comment ? MAP_LINE_COMMENT : MAP_LINE_BLANK;
+    }
+    else if (l->n_tokens >= 2)
+    {
+        l->kind = MAP_LINE_EDGE;
+    }
+    else
+    {
+        l->kind = map_token_to_long(l->tokens[0],&l->count) ? MAP_LINE_COUNT : MAP_LINE_INVALID;
+    }
+}
+
+/**
+ * The function `lexer_matches` lexes the `size` bytes at `data` and compares every line with the
+ * reference tokenizer, by offset into the buffer.
+ */
+void lexer_matches(const char *data, size_t size, const char *test)
+{
+    map_lexer lx;
+    map_line l, r;
+    size_t start = 0;
+    int n_lines = 0;
+
+    map_lexer_init(&lx,data,size);
+    while (map_lexer_next(&lx,&l))
+    {
+        const char *end = memchr(data + start,'\n',size - start);
+        size_t len = (end != NULL) ? (size_t)(end - data) - start : size - start;
+        reference_line(data + start,len,&r);
+        bool same = l.kind == r.kind && l.n_tokens == r.n_tokens &&
+                    (l.kind != MAP_LINE_COUNT || l.count == r.count);
+        for (int i = 0; same && i < r.n_tokens; i++)
+        {
+            same = l.tokens[i].s == r.tokens[i].s && l.tokens[i].len == r.tokens[i].len;
+        }
+        if (!same)
+        {
+            fprintf(stderr,"%s with %s: line %d \"%.*s\"\n",test,map_lexer_implementation(),
+                    n_lines,(int)len,data + start);
+            error(  "FAIL: the lexer split a line differently from the reference",
+                    "GOT: Another kind or other tokens");
+        }
+        start += len + 1;
+        n_lines++;
+    }
+    if (start < size)
+    {
+        fprintf(stderr,"%s with %s: stopped at byte %zu of %zu\n",test,
+                map_lexer_implementation(),start,size);
+        error(  "FAIL: the lexer stopped before the end of the buffer",
+                "GOT: Fewer lines");
+    }
+}
+
+/**
+ * The function `map_lexer_blocks` lexes a pseudo-random map file that does not end with a newline,
+ * at every alignment to the 64-byte blocks and with every block classifier, and compares the lines
+ * with a byte by byte reference. The buffer ends where its allocation ends, so a read past the end
+ * is caught by the address sanitizer.
+ */
+void map_lexer_blocks()
+{
+    char *text = malloc(MAP_LINES * 400);
+    char line[400];
+    size_t size = 0;
+    const char *implementations[] = { "scalar", "sse2", "avx2" };
+    const char *original = map_lexer_implementation();
+
+    random_state = 3;
+    for (int i = 0; i < MAP_LINES; i++)
+    {
+        random_map_line(line);
+        size = append(text,size,line);
+        if (i < MAP_LINES - 1)
+        {
+            size = append(text,size,"\n");
+        }
+    }
+
+    for (int k = 0; k < 3; k++)
+    {
+        if (!map_lexer_use_implementation(implementations[k]))
+        {
+            fprintf(stderr, "map_lexer_blocks with %s - not supported, skipped\n",
+                    implementations[k]);
+            continue;
+        }
+        for (size_t offset = 0; offset < MAP_LEXER_BLOCK; offset++)
+        {
+            char *buf = malloc(offset + size);
+            memcpy(buf + offset,text,size);
+            lexer_matches(buf + offset,size,"blocks");
+            // The buffer cut in the middle of a line, and empty.
+            lexer_matches(buf + offset,size / 3,"cut");
+            lexer_matches(buf + offset,0,"empty");
+            free(buf);
+        }
+        fprintf(stderr, "map_lexer_blocks with %s - OK\n", implementations[k]);
+    }
+    map_lexer_use_implementation(original);
+    free(text);
+}
+
+/**
+ * The function `random_map_file` writes a map file with `MAP_EDGES` edges between pseudo-random
+ * labels to `text`, with comments and blank lines in between and without a final newline. If
+ * `bad_line` is not negative, that edge line is replaced by an invalid line. Returns the size.
+ */
+size_t random_map_file(char *text, int bad_line)
+{
+    char label[LABEL_LENGTH + 2];
+    size_t size = 0;
+
+    size = append(text,size,"# A map for the tests\n\n   \n");
+    sprintf(label,"%d",MAP_EDGES);
+    size = append(text,size,label);
+    size = append(text,size," # the count\n");
+    for (int i = 0; i < MAP_EDGES; i++)
+    {
+        switch (next_random(8))
+        {
+        case 0:
+            size = append(text,size,"\n");
+            break;
+        case 1:
+            size = append(text,size,"  # between the edges\n");
+            break;
+        }
+        if (i == bad_line)
+        {
+            size = append(text,size,"not_an_edge\n");
+            continue;
+        }
+        for (int j = 0; j < 2; j++)
+        {
+            int k = next_random(MAP_LABELS);
+            make_label(label,k,1 + k % LABEL_LENGTH);
+            size = append(text,size,label);
+            size = append(text,size,(j == 0) ? " " : "");
+        }
+        size = append(text,size,next_random(4) == 0 ? "\t# a comment" : "");
+        size = append(text,size,(i < MAP_EDGES - 1) ? "\n" : "");
+    }
+    return size;
+}
+
+/**
+ * The function `map_scan_same_result` checks that the scans `a` and `b` of the same file hold the
+ * same labels with the same ids, the same edges and the same degrees.
+ */
+void map_scan_same_result(const map_scan *a, const map_scan *b, int n_threads)
+{
+    int n_labels = intern_size(a->labels);
+    bool same = n_labels == intern_size(b->labels) && a->n_edges == b->n_edges &&
+                a->count == b->count;
+
+    for (int id = 0; same && id < n_labels; id++)
+    {
+        same = strcmp(intern_string(a->labels,id),intern_string(b->labels,id)) == 0 &&
+               a->out_degree[id] == b->out_degree[id];
+    }
+    for (int i = 0; same && i < a->n_edges; i++)
+    {
+        same = a->edges[i].src == b->edges[i].src && a->edges[i].dest == b->edges[i].dest;
+    }
+    if (!same)
+    {
+        fprintf(stderr,"%d threads\n",n_threads);
+        error(  "FAIL: scanning on several threads gave another result than on one",
+                "GOT: Other labels, ids, edges or degrees");
+    }
+}
+
+/**
+ * The function `map_scan_threads_agree` scans a map file with comments, blank lines and no final
+ * newline on one thread and on several, and checks that the results are the same. A file with an
+ * invalid line must give the same error on any number of threads.
+ */
+void map_scan_threads_agree()
+{
+    char *text = malloc(MAP_EDGES * 80 + 100);
+    map_scan one, many;
+
+    random_state = 4;
+    size_t size = random_map_file(text,-1);
+    if (map_scan_buffer(text,size,1,&one) != MAP_SCAN_OK || one.n_edges != MAP_EDGES ||
+        one.count != MAP_EDGES)
+    {
+        error(  "FAIL: a map file was not scanned on one thread",
+                "GOT: An error or another number of edges");
+    }
+    for (int n_threads = 2; n_threads <= 4; n_threads++)
+    {
+        if (map_scan_buffer(text,size,n_threads,&many) != MAP_SCAN_OK)
+        {
+            error(  "FAIL: a map file was not scanned on several threads",
+                    "GOT: An error");
+        }
+        map_scan_same_result(&one,&many,n_threads);
+        map_scan_free(&many);
+    }
+    map_scan_free(&one);
+
+    // An invalid line near the end, in the chunk of the last thread.
+    size = random_map_file(text,MAP_EDGES - 10);
+    for (int n_threads = 1; n_threads <= 4; n_threads++)
+    {
+        if (map_scan_buffer(text,size,n_threads,&many) != MAP_SCAN_BAD_LINE)
+        {
+            fprintf(stderr,"%d threads\n",n_threads);
+            error(  "FAIL: an invalid line was not found",
+                    "GOT: Another status");
+        }
+    }
+    if (map_scan_buffer("# no count\nA B\n",16,4,&many) != MAP_SCAN_NO_COUNT)
+    {
+        error(  "FAIL: a map file without a count was scanned",
+                "GOT: Another status");
+    }
+
+    free(text);
+    fprintf(stderr, "map_scan_threads_agree - OK\n");
+}
+
+/**
+ * The function `typed_array_limits` checks that the index limits of a typed 2D array are numbered
+ * by dimension 1 and 2, like those of array_2d.
+ */
+void typed_array_limits()
+{
+    array_2d_int *a = array_2d_int_create(2,5,-1,3);
+
+    if (array_2d_int_low(a,1) != 2 || array_2d_int_high(a,1) != 5 ||
+        array_2d_int_low(a,2) != -1 || array_2d_int_high(a,2) != 3)
+    {
+        error(  "FAIL: the limits of a typed 2D array are not numbered by dimension 1 and 2",
+                "GOT: The limits of another dimension");
+    }
+    array_2d_int_set(a,7,5,3);
+    array_2d_int_resize(a,6,4);
+    if (array_2d_int_high(a,1) != 6 || array_2d_int_high(a,2) != 4 || array_2d_int_get(a,5,3) != 7)
+    {
+        error(  "FAIL: resizing a typed 2D array did not keep the value or set the limits",
+                "GOT: Another value or limit");
+    }
+
+    array_2d_int_kill(a);
+    fprintf(stderr, "typed_array_limits - OK\n");
+}
+
+/**
+ * The function `inline_array_values` pushes pairs of numbers into an array that stores its values
+ * inline, through a counting allocator, clears some of them and checks the copies after the array
+ * has grown. Killing the array must give back every byte it took from the allocator.
+ */
+void inline_array_values()
+{
+    typedef struct { int a; double b; } pair;
+    alloc_counter *c = alloc_counter_create(NULL);
+    array_1d *arr = array_1d_create_inline_alloc(1,0,sizeof(pair),alloc_counter_allocator(c));
+
+    for (int i = 1; i <= MAX_SIZE; ++i)
+    {
+        pair p = { i, i / 2.0 };
+        array_1d_push(arr,&p);
+    }
+    for (int i = 3; i <= MAX_SIZE; i += 3)
+    {
+        array_1d_set_value(arr,NULL,i);
+    }
+    for (int i = 1; i <= MAX_SIZE; ++i)
+    {
+        const pair *p = array_1d_inspect_value(arr,i);
+        if (array_1d_has_value(arr,i) != (i % 3 != 0) ||
+            (i % 3 != 0 && (p->a != i || p->b != i / 2.0)))
+        {
+            error(  "FAIL: an inline array does not hold the values that were pushed",
+                    "GOT: Another value");
+        }
+    }
+    if (alloc_counter_bytes(c) == 0)
+    {
+        error(  "FAIL: the inline array took no memory from its allocator",
+                "GOT: No bytes in use");
+    }
+
+    array_1d_kill(arr);
+    if (alloc_counter_bytes(c) != 0)
+    {
+        error(  "FAIL: killing the inline array did not give back all memory to its allocator",
+                "GOT: Bytes still in use");
+    }
+    alloc_counter_kill(c);
+    fprintf(stderr, "inline_array_values - OK\n");
+}
+
+DLIST_TYPED(dlist_int, int)
+
+/**
+ * The function `typed_containers_use_allocator` fills a typed queue past its first capacity and a
+ * typed list through a counting allocator, removes values from both and checks the order of the
+ * rest. Killing them must give back every byte they took from the allocator.
+ */
+void typed_containers_use_allocator()
+{
+    alloc_counter *c = alloc_counter_create(NULL);
+    const allocator *a = alloc_counter_allocator(c);
+    queue_u32 *q = queue_u32_empty_alloc(a);
+    dlist_int *l = dlist_int_empty_alloc(a);
+
+    // The queue wraps around before it grows, so the move of the wrapped part is used too.
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        queue_u32_enqueue(q, i);
+    }
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        queue_u32_dequeue(q);
+    }
+    for (uint32_t i = 10; i < MAX_SIZE; ++i)
+    {
+        queue_u32_enqueue(q, i);
+    }
+    for (int i = 0; i < MAX_SIZE; ++i)
+    {
+        dlist_int_insert(l, i, dlist_int_first(l));
+    }
+    for (dlist_int_pos p = dlist_int_first(l); !dlist_int_is_end(l, p); p = dlist_int_next(l, p))
+    {
+        dlist_int_remove(l, p);
+    }
+    if (alloc_counter_bytes(c) == 0)
+    {
+        error(  "FAIL: the typed containers took no memory from their allocator",
+                "GOT: No bytes in use");
+    }
+
+    for (uint32_t i = 5; i < MAX_SIZE; ++i)
+    {
+        if (queue_u32_dequeue(q) != i)
+        {
+            error(  "FAIL: a typed queue did not return its values in the order they were enqueued",
+                    "GOT: Another value");
+        }
+    }
+    // Every other value is left, from the one inserted before the last.
+    int expected = MAX_SIZE - 2;
+    for (dlist_int_pos p = dlist_int_first(l); !dlist_int_is_end(l, p); p = dlist_int_next(l, p))
+    {
+        if (dlist_int_inspect(l, p) != expected)
+        {
+            error(  "FAIL: a typed list does not hold the values that were not removed",
+                    "GOT: Another value");
+        }
+        expected -= 2;
+    }
+    if (expected != -2)
+    {
+        error(  "FAIL: a typed list lost values that were not removed",
+                "GOT: Fewer values");
+    }
+
+    queue_u32_kill(q);
+    dlist_int_kill(l);
+    if (alloc_counter_bytes(c) != 0)
+    {
+        error(  "FAIL: killing the typed containers did not give back all memory to their allocator",
+                "GOT: Bytes still in use");
+    }
+    alloc_counter_kill(c);
+    fprintf(stderr, "typed_containers_use_allocator - OK\n");
+}
+
+/**
+ * The function `write_test_image` scans the map file `text` and compiles it into an image at
+ * `path`, and checks that the image has `n_edges` edges.
+ */
+void write_test_image(const char *path, const char *text, int n_edges)
+{
+    map_scan scan;
+    if (map_scan_buffer(text, strlen(text), 1, &scan) != MAP_SCAN_OK)
+    {
+        error(  "FAIL: the map of the image test could not be scanned",
+                "GOT: A format error");
+    }
+    int written = map_image_write(path, &scan);
+    map_scan_free(&scan);
+    if (written != n_edges)
+    {
+        fprintf(stderr, "%d edges\n", written);
+        error(  "FAIL: map_image_write did not report the edges without duplicates",
+                "GOT: Another number of edges");
+    }
+}
+
+/**
+ * The function `corrupt_image` overwrites `size` bytes of the image at `path` from `offset` with
+ * `bytes`.
+ */
+void corrupt_image(const char *path, long offset, const void *bytes, size_t size)
+{
+    FILE *f = fopen(path, "r+b");
+    if (f == NULL || fseek(f, offset, SEEK_SET) != 0 || fwrite(bytes, 1, size, f) != size)
+    {
+        error(  "FAIL: could not change the image file",
+                "GOT: A write error");
+    }
+    fclose(f);
+}
+
+/**
+ * The function `map_image_round_trip` compiles a small map with duplicate edges into an image,
+ * reopens it and checks the labels, the hash index and the edges of every node. It then changes
+ * the magic, the version, the size of the hash index and the offset of a section of the header, one
+ * at a time, and checks that map_image_open refuses each of them.
+ */
+void map_image_round_trip()
+{
+    // A to B and A to C appear twice, so the image has 5 of the 7 edges.
+    const char *text = "7\n# Two duplicates\nA B\nA C\nA B\nB C\nC A\nD A\nA C\n";
+    const char *labels[] = { "A", "B", "C", "D" };
+    const uint32_t edges[][2] = { { 1, 2 }, { 2 }, { 0 }, { 0 } };
+    const int degree[] = { 2, 1, 1, 1 };
+
+    char path[] = "/tmp/test_lib_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+    {
+        error(  "FAIL: could not create a temporary image file",
+                "GOT: mkstemp failed");
+    }
+    close(fd);
+    write_test_image(path, text, 5);
+
+    map_image *img = map_image_open(path);
+    if (img == NULL || map_image_n_nodes(img) != 4)
+    {
+        error(  "FAIL: the image of a map with 4 labels could not be opened",
+                "GOT: No image or another number of nodes");
+    }
+    for (int id = 0; id < 4; ++id)
+    {
+        if (map_image_find(img, labels[id]) != id || strcmp(map_image_label(img, id), labels[id]) != 0)
+        {
+            error(  "FAIL: a label of the image was not found at its id",
+                    "GOT: Another id or label");
+        }
+        int n;
+        const uint32_t *dest = map_image_neighbours(img, id, &n);
+        if (n != degree[id] || memcmp(dest, edges[id], n * sizeof(*dest)) != 0)
+        {
+            error(  "FAIL: the edges of a node are not those of the map in file order without duplicates",
+                    "GOT: Other edges");
+        }
+    }
+    if (map_image_find(img, "E") != -1 || map_image_find(img, "") != -1 ||
+        map_image_find(img, "AB") != -1)
+    {
+        error(  "FAIL: a label that is not in the map was found in the image",
+                "GOT: An id");
+    }
+    map_image_close(img);
+
+    // Offsets of fields of the header, see mapimage.c.
+    const uint32_t version = 99;
+    const uint32_t n_slots = 3;
+    const uint64_t past_end = 1 << 20;
+    struct { long offset; const void *bytes; size_t size; } damage[] = {
+        { 0, "X", 1 },                      // Magic.
+        { 12, &version, sizeof(version) },   // Version.
+        { 20, &n_slots, sizeof(n_slots) },   // Slots, not a power of two.
+        { 72, &past_end, sizeof(past_end) }, // Edge targets, past the end of the file.
+    };
+    for (int i = 0; i < 4; ++i)
+    {
+        write_test_image(path, text, 5);
+        corrupt_image(path, damage[i].offset, damage[i].bytes, damage[i].size);
+        errno = 0;
+        img = map_image_open(path);
+        if (img != NULL || errno != EINVAL)
+        {
+            error(  "FAIL: an image with a damaged header was opened",
+                    "GOT: An image, or another error than EINVAL");
+        }
+    }
+
+    remove(path);
+    fprintf(stderr, "map_image_round_trip - OK\n");
+}
+
+int main(void)
+{
+    unrolled_dlist_splits_and_merges();
+    unrolled_dlist_empties_the_tail();
+    bitset_bulk_operations("scalar");
+    bitset_bulk_operations("sse2");
+    bitset_bulk_operations("avx2");
+    intern_packed_and_long_labels(0);
+    intern_packed_and_long_labels(2000);
+    intern_label_with_nul();
+    table_displacement_and_wraparound();
+    table_random_operations(0);
+    table_random_operations(TABLE_KEYS);
+    map_lexer_blocks();
+    map_scan_threads_agree();
+    typed_array_limits();
+    inline_array_values();
+    map_image_round_trip();
+    typed_containers_use_allocator();
+    printf("All test successfully completed\n");
+    return 0;
+}